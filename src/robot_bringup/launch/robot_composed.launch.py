@@ -0,0 +1,110 @@
+from launch import LaunchDescription
+from launch.substitutions import Command, FindExecutable, PathJoinSubstitution
+from launch_ros.actions import Node
+from launch_ros.substitutions import FindPackageShare
+
+
+# Same as robot_controllers.launch.py, but the controller manager runs in
+# robot_control_node together with the C++ motion node, so trajectories reach the
+# joint trajectory controller without leaving the process.
+def generate_launch_description():
+    # Get URDF via xacro
+    robot_description_content = Command([
+        PathJoinSubstitution([FindExecutable(name="xacro")]),
+        " ",
+        PathJoinSubstitution([
+            FindPackageShare("robot_description"),
+            "urdf",
+            "robot.urdf",
+        ]),
+    ])
+    robot_description = {"robot_description": robot_description_content}
+
+    controller_manager_config = PathJoinSubstitution([
+        FindPackageShare("robot_bringup"), "config", "robot_controllers.yaml"
+    ])
+
+    control_node = Node(
+        package="robot_motion_cpp",
+        executable="robot_control_node",
+        parameters=[controller_manager_config],
+        output="both",
+    )
+
+    robot_state_pub_node = Node(
+        package="robot_state_publisher",
+        executable="robot_state_publisher",
+        output="both",
+        parameters=[robot_description],
+    )
+
+    joint_state_broadcaster_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["joint_state_broadcaster"],
+    )
+
+    # one spawner so guard_controller is active before the trajectory controller chains into it
+    joint_trajectory_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["guard_controller", "joint_trajectory_controller"],
+    )
+
+    payload_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["payload_controller"],
+    )
+
+    compensation_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["compensation_controller"],
+    )
+
+    friction_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["friction_controller"],
+    )
+
+    state_recorder_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["state_recorder"],
+    )
+
+    fts_broadcaster_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["fts_broadcaster"],
+    )
+
+    # loaded inactive, it claims the same position commands as guard_controller
+    admittance_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["admittance_controller", "--inactive"],
+    )
+
+    # loaded inactive, it claims the same position commands as guard_controller
+    mpc_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["mpc_controller", "--inactive"],
+    )
+
+    return LaunchDescription([
+        control_node,
+        robot_state_pub_node,
+        joint_state_broadcaster_spawner,
+        joint_trajectory_controller_spawner,
+        payload_controller_spawner,
+        compensation_controller_spawner,
+        friction_controller_spawner,
+        state_recorder_spawner,
+        fts_broadcaster_spawner,
+        admittance_controller_spawner,
+        mpc_controller_spawner,
+    ])
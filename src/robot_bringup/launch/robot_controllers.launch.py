@@ -41,10 +41,55 @@ def generate_launch_description():
         arguments=["joint_state_broadcaster"],
     )
 
+    # one spawner so guard_controller is active before the trajectory controller chains into it
     joint_trajectory_controller_spawner = Node(
         package="controller_manager",
         executable="spawner",
-        arguments=["joint_trajectory_controller"],
+        arguments=["guard_controller", "joint_trajectory_controller"],
+    )
+
+    payload_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["payload_controller"],
+    )
+
+    compensation_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["compensation_controller"],
+    )
+
+    friction_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["friction_controller"],
+    )
+
+    state_recorder_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["state_recorder"],
+    )
+
+    fts_broadcaster_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["fts_broadcaster"],
+    )
+
+    # loaded inactive, it claims the same position commands as guard_controller
+    admittance_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["admittance_controller", "--inactive"],
+    )
+
+    # loaded inactive, it claims the same position commands as guard_controller
+    mpc_controller_spawner = Node(
+        package="controller_manager",
+        executable="spawner",
+        arguments=["mpc_controller", "--inactive"],
     )
 
     return LaunchDescription([
@@ -52,4 +97,11 @@ def generate_launch_description():
         robot_state_pub_node,
         joint_state_broadcaster_spawner,
         joint_trajectory_controller_spawner,
+        payload_controller_spawner,
+        compensation_controller_spawner,
+        friction_controller_spawner,
+        state_recorder_spawner,
+        fts_broadcaster_spawner,
+        admittance_controller_spawner,
+        mpc_controller_spawner,
     ])
@@ -0,0 +1,73 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_CALIBRATION__COMPENSATION_CALIBRATION_HPP_
+#define ROBOT_CALIBRATION__COMPENSATION_CALIBRATION_HPP_
+
+#include <cstddef>
+#include <string>
+
+#include <Eigen/Core>
+
+namespace robot_calibration
+{
+  struct CompensationEstimate
+  {
+    bool success = false;
+    std::string message;
+    double backlash = 0.0;  // rad
+    double stiffness = 0.0; // Nm/rad, 0 if not identified
+    double offset = 0.0;    // rad
+    double residual = 0.0;  // rad rms
+    std::size_t samples = 0;
+  };
+
+  // Linear least squares fit of one joint's backlash and transmission stiffness to
+  // positions reached with the hardware compensation off. Each sample is a joint at
+  // rest after approaching its command from one side:
+  //   command - measured = direction * backlash / 2 + torque / stiffness + offset
+  // with the torque the one holding the joint there. Only the normal equations are kept.
+  class CompensationCalibration
+  {
+  public:
+    // direction +1 when the command was approached from below, -1 from above
+    void add(double direction, double command, double measured, double torque);
+
+    // the stiffness is only fitted when the torque varied by min_torque_range, Nm
+    CompensationEstimate solve(double min_torque_range) const;
+
+    std::size_t samples() const { return samples_; }
+    void clear();
+
+  private:
+    // parameters half backlash, compliance, offset
+    Eigen::Matrix3d normal_ = Eigen::Matrix3d::Zero();
+    Eigen::Vector3d rhs_ = Eigen::Vector3d::Zero();
+    double squares_ = 0.0;
+    std::size_t samples_ = 0;
+    std::size_t up_samples_ = 0;
+    std::size_t down_samples_ = 0;
+    double min_torque_ = 0.0;
+    double max_torque_ = 0.0;
+  };
+
+} // namespace robot_calibration
+
+#endif // ROBOT_CALIBRATION__COMPENSATION_CALIBRATION_HPP_
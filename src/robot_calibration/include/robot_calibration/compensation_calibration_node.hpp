@@ -0,0 +1,119 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_CALIBRATION__COMPENSATION_CALIBRATION_NODE_HPP_
+#define ROBOT_CALIBRATION__COMPENSATION_CALIBRATION_NODE_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "control_msgs/msg/dynamic_interface_group_values.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_action/rclcpp_action.hpp"
+#include "robot_dynamics/dynamics_model.hpp"
+#include "robot_motion_interfaces/action/calibrate_compensation.hpp"
+#include "robot_planning/kinematics.hpp"
+#include "sensor_msgs/msg/joint_state.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+
+#include "robot_calibration/compensation_calibration.hpp"
+
+namespace robot_calibration
+{
+  // Identifies backlash and transmission stiffness of the joints one at a time:
+  // turns the compensation GPIO off for them, steps each joint through targets
+  // around the start pose, approaching every target from below and from above,
+  // and records where the joint comes to rest together with its effort, the
+  // hardware's gravity torque. CompensationCalibration fits the result, which is
+  // sent to the compensation GPIO if asked. Otherwise the values from the joint
+  // params in the robot description are restored.
+  class CompensationCalibrationNode : public rclcpp::Node
+  {
+  public:
+    explicit CompensationCalibrationNode(const rclcpp::NodeOptions &options);
+
+  private:
+    using CalibrateCompensation = robot_motion_interfaces::action::CalibrateCompensation;
+    using GoalHandle = rclcpp_action::ServerGoalHandle<CalibrateCompensation>;
+    using JointVector = robot_dynamics::JointVector;
+
+    struct JointSample
+    {
+      double time;
+      JointVector q;
+      JointVector effort;
+    };
+
+    // where one joint rests after an approach, averaged over the end of the dwell
+    struct Window
+    {
+      std::size_t joint;
+      double direction;
+      double target;
+      double start; // s from the trajectory start
+      double end;
+    };
+
+    struct Compensation
+    {
+      double backlash = 0.0;
+      double stiffness = 0.0;
+    };
+
+    void robot_description_callback(const std_msgs::msg::String &msg);
+    void joint_states_callback(const sensor_msgs::msg::JointState &msg);
+
+    rclcpp_action::GoalResponse handle_goal(const CalibrateCompensation::Goal &goal);
+    void handle_accepted(const std::shared_ptr<GoalHandle> goal_handle);
+    void update();
+
+    std::unique_ptr<trajectory_msgs::msg::JointTrajectory> excitation(const JointVector &start, double range);
+    void publish_compensation(const std::vector<Compensation> &compensation);
+    void finish();
+
+    std::vector<std::string> joint_names_;
+    std::vector<Compensation> configured_; // from the robot description's joint params
+    robot_planning::JointLimits limits_;   // from its <limit> tags
+    JointVector current_joint_positions_;
+    bool has_joint_state_ = false;
+
+    // one calibration at a time, everything runs on the node's executor thread
+    std::shared_ptr<GoalHandle> active_goal_;
+    std::vector<std::size_t> joints_;
+    JointVector start_position_;
+    rclcpp::Time start_time_;
+    double duration_ = 0.0;
+    bool recording_ = false;
+    std::vector<Window> windows_;
+    std::vector<JointSample> joint_samples_;
+
+    rclcpp::Subscription<std_msgs::msg::String>::SharedPtr robot_description_sub_;
+    rclcpp::Subscription<sensor_msgs::msg::JointState>::SharedPtr joint_states_sub_;
+    rclcpp::Publisher<trajectory_msgs::msg::JointTrajectory>::SharedPtr traj_pub_;
+    rclcpp::Publisher<control_msgs::msg::DynamicInterfaceGroupValues>::SharedPtr compensation_pub_;
+    rclcpp_action::Server<CalibrateCompensation>::SharedPtr action_server_;
+    rclcpp::TimerBase::SharedPtr timer_;
+  };
+
+} // namespace robot_calibration
+
+#endif // ROBOT_CALIBRATION__COMPENSATION_CALIBRATION_NODE_HPP_
@@ -0,0 +1,65 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_CALIBRATION__FRICTION_IDENTIFICATION_HPP_
+#define ROBOT_CALIBRATION__FRICTION_IDENTIFICATION_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "robot_dynamics/friction_model.hpp"
+
+namespace robot_calibration
+{
+  // recorded cycles of one joint
+  struct FrictionSamples
+  {
+    std::vector<double> velocity;     // rad/s
+    std::vector<double> measured;     // A with a current interface, Nm from the effort otherwise
+    std::vector<double> rigid_torque; // Nm, inverse dynamics of the recorded motion
+  };
+
+  struct FrictionEstimate
+  {
+    bool success = false;
+    std::string message;
+    robot_dynamics::FrictionParameters friction;
+    double torque_constant = 0.0; // Nm/A, 0 when the measurement already was a torque
+    double residual = 0.0;        // Nm rms
+    std::size_t samples = 0;
+    std::size_t iterations = 0;
+  };
+
+  // Nonlinear least squares fit of a joint's friction, and with a current measurement
+  // of its torque constant, to
+  //   torque_constant * measured = rigid_torque + friction.torque(velocity)
+  // The model is linear in everything but the Stribeck velocity, so linear fits over
+  // a grid of Stribeck velocities seed Levenberg-Marquardt over all parameters.
+  FrictionEstimate fit_friction(const FrictionSamples &samples, bool fit_torque_constant,
+                                double smoothing_velocity);
+
+  // fit_friction for every joint, each on its own thread
+  std::vector<FrictionEstimate> fit_joint_friction(const std::vector<FrictionSamples> &joints,
+                                                   bool fit_torque_constant, double smoothing_velocity);
+
+} // namespace robot_calibration
+
+#endif // ROBOT_CALIBRATION__FRICTION_IDENTIFICATION_HPP_
@@ -0,0 +1,115 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_CALIBRATION__FRICTION_IDENTIFICATION_NODE_HPP_
+#define ROBOT_CALIBRATION__FRICTION_IDENTIFICATION_NODE_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "control_msgs/msg/dynamic_interface_group_values.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_action/rclcpp_action.hpp"
+#include "robot_dynamics/dynamics_model.hpp"
+#include "robot_motion_interfaces/action/identify_friction.hpp"
+#include "robot_motion_interfaces/msg/joint_samples.hpp"
+#include "robot_planning/kinematics.hpp"
+#include "sensor_msgs/msg/joint_state.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+
+#include "robot_calibration/friction_identification.hpp"
+
+namespace robot_calibration
+{
+  // Identifies joint friction, and the motor torque constants when a current
+  // interface is recorded: runs a windowed sine on each joint through the joint
+  // trajectory controller, takes every control cycle from state_recorder, removes
+  // the rigid body torque of the recorded motion and fits the rest per joint on
+  // parallel threads. If asked, the friction goes to the friction GPIO the
+  // hardware feeds forward from. On the mock hardware the effort state is that
+  // feedforward, configured friction included, so a fit there only gives back the
+  // friction it was configured with.
+  class FrictionIdentificationNode : public rclcpp::Node
+  {
+  public:
+    explicit FrictionIdentificationNode(const rclcpp::NodeOptions &options);
+
+  private:
+    using IdentifyFriction = robot_motion_interfaces::action::IdentifyFriction;
+    using GoalHandle = rclcpp_action::ServerGoalHandle<IdentifyFriction>;
+    using JointSamples = robot_motion_interfaces::msg::JointSamples;
+    using JointVector = robot_dynamics::JointVector;
+
+    struct Sample
+    {
+      JointVector q;
+      JointVector qd;
+      JointVector qdd;
+      JointVector measured; // current or effort
+    };
+
+    void robot_description_callback(const std_msgs::msg::String &msg);
+    void joint_states_callback(const sensor_msgs::msg::JointState &msg);
+    void samples_callback(const JointSamples &msg);
+
+    rclcpp_action::GoalResponse handle_goal(const IdentifyFriction::Goal &goal);
+    void handle_accepted(const std::shared_ptr<GoalHandle> goal_handle);
+    void update();
+
+    std::unique_ptr<trajectory_msgs::msg::JointTrajectory> excitation(const JointVector &start, double duration,
+                                                                      double amplitude) const;
+    void identify();
+    void apply(const std::vector<FrictionEstimate> &estimates);
+
+    std::vector<std::string> joint_names_;
+    robot_dynamics::DynamicsModel model_;
+    robot_planning::JointLimits limits_; // from the <limit> tags of the robot description
+    bool has_model_ = false;
+    JointVector current_joint_positions_;
+    bool has_joint_state_ = false;
+
+    // one identification at a time, everything runs on the node's executor thread
+    std::shared_ptr<GoalHandle> active_goal_;
+    std::vector<std::size_t> joints_;
+    JointVector start_position_;
+    rclcpp::Time start_time_;
+    double duration_ = 0.0;
+    bool recording_ = false;
+    std::vector<Sample> samples_;
+    std::string recording_error_;
+    std::uint64_t first_dropped_ = 0;
+    std::uint64_t last_dropped_ = 0;
+    bool has_dropped_ = false;
+
+    rclcpp::Subscription<std_msgs::msg::String>::SharedPtr robot_description_sub_;
+    rclcpp::Subscription<sensor_msgs::msg::JointState>::SharedPtr joint_states_sub_;
+    rclcpp::Subscription<JointSamples>::SharedPtr samples_sub_;
+    rclcpp::Publisher<trajectory_msgs::msg::JointTrajectory>::SharedPtr traj_pub_;
+    rclcpp::Publisher<control_msgs::msg::DynamicInterfaceGroupValues>::SharedPtr friction_pub_;
+    rclcpp_action::Server<IdentifyFriction>::SharedPtr action_server_;
+    rclcpp::TimerBase::SharedPtr timer_;
+  };
+
+} // namespace robot_calibration
+
+#endif // ROBOT_CALIBRATION__FRICTION_IDENTIFICATION_NODE_HPP_
@@ -0,0 +1,88 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_CALIBRATION__PAYLOAD_IDENTIFICATION_HPP_
+#define ROBOT_CALIBRATION__PAYLOAD_IDENTIFICATION_HPP_
+
+#include <cstddef>
+#include <string>
+
+#include <Eigen/Core>
+
+#include "robot_dynamics/dynamics_model.hpp"
+
+namespace robot_calibration
+{
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+
+  struct PayloadEstimate
+  {
+    bool success = false;
+    std::string message;
+    double mass = 0.0;                                   // kg
+    Eigen::Vector3d com = Eigen::Vector3d::Zero();       // m, sensor frame
+    Eigen::Matrix3d inertia = Eigen::Matrix3d::Zero();   // kg m^2 about the com
+    bool inertia_identified = false;                     // the excitation had enough rotation
+    Vector6d offset = Vector6d::Zero();                  // sensor bias, force then torque
+    double force_residual = 0.0;                         // N rms
+    double torque_residual = 0.0;                        // Nm rms
+    std::size_t samples = 0;
+  };
+
+  // Linear least squares fit of payload mass, first moment, inertia and sensor bias
+  // to wrench samples. The wrench is the one the payload exerts on a sensor at the
+  // tip link frame, so a payload at rest reads m * g in that frame. Only the normal
+  // equations are kept, samples can be added one at a time while recording.
+  class PayloadIdentification
+  {
+  public:
+    static constexpr std::size_t NUM_PARAMETERS = 16; // m, m c, inertia about the frame origin, bias
+
+    using Regressor = Eigen::Matrix<double, 6, NUM_PARAMETERS>;
+    using Parameters = Eigen::Matrix<double, NUM_PARAMETERS, 1>;
+
+    // gravity in the root frame, as the dynamics model uses it
+    void add(const robot_dynamics::TipMotion &motion, const Eigen::Vector3d &gravity, const Vector6d &wrench);
+
+    PayloadEstimate solve(double min_mass = 1e-3) const;
+
+    std::size_t samples() const { return samples_; }
+    void clear();
+
+    static void regressor(const robot_dynamics::TipMotion &motion, const Eigen::Vector3d &gravity, Regressor &Y);
+
+  private:
+    bool solve_parameters(bool with_inertia, Parameters &phi) const;
+    // inertia about the com, false if it is not positive semi-definite
+    static bool physical_inertia(const Parameters &phi, Eigen::Matrix3d &inertia);
+
+    // force and torque rows apart so both residuals come out of the sums
+    Eigen::Matrix<double, NUM_PARAMETERS, NUM_PARAMETERS> force_normal_ = decltype(force_normal_)::Zero();
+    Eigen::Matrix<double, NUM_PARAMETERS, NUM_PARAMETERS> torque_normal_ = decltype(torque_normal_)::Zero();
+    Parameters force_rhs_ = Parameters::Zero();
+    Parameters torque_rhs_ = Parameters::Zero();
+    double force_squares_ = 0.0;
+    double torque_squares_ = 0.0;
+    std::size_t samples_ = 0;
+  };
+
+} // namespace robot_calibration
+
+#endif // ROBOT_CALIBRATION__PAYLOAD_IDENTIFICATION_HPP_
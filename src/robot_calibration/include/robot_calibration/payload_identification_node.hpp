@@ -0,0 +1,110 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_CALIBRATION__PAYLOAD_IDENTIFICATION_NODE_HPP_
+#define ROBOT_CALIBRATION__PAYLOAD_IDENTIFICATION_NODE_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "control_msgs/msg/dynamic_interface_group_values.hpp"
+#include "geometry_msgs/msg/wrench_stamped.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_action/rclcpp_action.hpp"
+#include "robot_motion_interfaces/action/identify_payload.hpp"
+#include "robot_planning/kinematics.hpp"
+#include "sensor_msgs/msg/joint_state.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+
+#include "robot_calibration/payload_identification.hpp"
+
+namespace robot_calibration
+{
+  // Identifies the payload after a tool change: swings the wrist through a windowed
+  // multi-sine around the current pose, records the tcp_fts_sensor wrench and the
+  // joint states, fits them with PayloadIdentification and, if asked, writes the
+  // result to the payload GPIO so the hardware's gravity compensation picks it up.
+  class PayloadIdentificationNode : public rclcpp::Node
+  {
+  public:
+    explicit PayloadIdentificationNode(const rclcpp::NodeOptions &options);
+
+  private:
+    using IdentifyPayload = robot_motion_interfaces::action::IdentifyPayload;
+    using GoalHandle = rclcpp_action::ServerGoalHandle<IdentifyPayload>;
+    using JointVector = robot_dynamics::JointVector;
+
+    struct JointSample
+    {
+      double time;
+      JointVector q;
+    };
+
+    struct WrenchSample
+    {
+      double time;
+      Vector6d wrench;
+    };
+
+    void robot_description_callback(const std_msgs::msg::String &msg);
+    void joint_states_callback(const sensor_msgs::msg::JointState &msg);
+    void wrench_callback(const geometry_msgs::msg::WrenchStamped &msg);
+
+    rclcpp_action::GoalResponse handle_goal(const IdentifyPayload::Goal &goal);
+    void handle_accepted(const std::shared_ptr<GoalHandle> goal_handle);
+    void update();
+
+    std::unique_ptr<trajectory_msgs::msg::JointTrajectory> excitation(const JointVector &start, double duration,
+                                                                      double amplitude) const;
+    bool interpolate(double time, JointVector &q) const;
+    PayloadEstimate identify() const;
+    void apply(const PayloadEstimate &estimate);
+    void finish(const PayloadEstimate &estimate);
+
+    std::vector<std::string> joint_names_;
+    robot_dynamics::DynamicsModel model_;
+    robot_planning::JointLimits limits_; // from the <limit> tags of the robot description
+    bool has_model_ = false;
+    JointVector current_joint_positions_;
+    bool has_joint_state_ = false;
+
+    // one identification at a time, everything runs on the node's executor thread
+    std::shared_ptr<GoalHandle> active_goal_;
+    JointVector start_position_;
+    rclcpp::Time start_time_;
+    double duration_ = 0.0;
+    bool recording_ = false;
+    std::vector<JointSample> joint_samples_;
+    std::vector<WrenchSample> wrench_samples_;
+
+    rclcpp::Subscription<std_msgs::msg::String>::SharedPtr robot_description_sub_;
+    rclcpp::Subscription<sensor_msgs::msg::JointState>::SharedPtr joint_states_sub_;
+    rclcpp::Subscription<geometry_msgs::msg::WrenchStamped>::SharedPtr wrench_sub_;
+    rclcpp::Publisher<trajectory_msgs::msg::JointTrajectory>::SharedPtr traj_pub_;
+    rclcpp::Publisher<control_msgs::msg::DynamicInterfaceGroupValues>::SharedPtr payload_pub_;
+    rclcpp_action::Server<IdentifyPayload>::SharedPtr action_server_;
+    rclcpp::TimerBase::SharedPtr timer_;
+  };
+
+} // namespace robot_calibration
+
+#endif // ROBOT_CALIBRATION__PAYLOAD_IDENTIFICATION_NODE_HPP_
@@ -0,0 +1,19 @@
+from launch import LaunchDescription
+from launch.substitutions import PathJoinSubstitution
+from launch_ros.actions import Node
+from launch_ros.substitutions import FindPackageShare
+
+
+def generate_launch_description():
+    calibration_config = PathJoinSubstitution([
+        FindPackageShare("robot_calibration"), "config", "compensation_calibration.yaml"
+    ])
+
+    compensation_calibration_node = Node(
+        package="robot_calibration",
+        executable="compensation_calibration_node",
+        parameters=[calibration_config],
+        output="both",
+    )
+
+    return LaunchDescription([compensation_calibration_node])
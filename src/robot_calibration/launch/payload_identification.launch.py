@@ -0,0 +1,19 @@
+from launch import LaunchDescription
+from launch.substitutions import PathJoinSubstitution
+from launch_ros.actions import Node
+from launch_ros.substitutions import FindPackageShare
+
+
+def generate_launch_description():
+    calibration_config = PathJoinSubstitution([
+        FindPackageShare("robot_calibration"), "config", "payload_identification.yaml"
+    ])
+
+    payload_identification_node = Node(
+        package="robot_calibration",
+        executable="payload_identification_node",
+        parameters=[calibration_config],
+        output="both",
+    )
+
+    return LaunchDescription([payload_identification_node])
@@ -0,0 +1,99 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_calibration/compensation_calibration.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Eigen/Cholesky>
+
+namespace robot_calibration
+{
+  namespace
+  {
+    constexpr int HALF_BACKLASH = 0;
+    constexpr int COMPLIANCE = 1;
+    constexpr int OFFSET = 2;
+  } // namespace
+
+  void CompensationCalibration::add(double direction, double command, double measured, double torque)
+  {
+    const Eigen::Vector3d y(direction, torque, 1.0);
+    const double error = command - measured;
+    normal_.noalias() += y * y.transpose();
+    rhs_ += y * error;
+    squares_ += error * error;
+    if (samples_ == 0)
+    {
+      min_torque_ = max_torque_ = torque;
+    }
+    min_torque_ = std::min(min_torque_, torque);
+    max_torque_ = std::max(max_torque_, torque);
+    (direction > 0.0 ? up_samples_ : down_samples_)++;
+    samples_++;
+  }
+
+  CompensationEstimate CompensationCalibration::solve(double min_torque_range) const
+  {
+    CompensationEstimate estimate;
+    estimate.samples = samples_;
+    if (up_samples_ == 0 || down_samples_ == 0)
+    {
+      estimate.message = "Needs positions approached from both sides.";
+      return estimate;
+    }
+
+    Eigen::Vector3d phi = Eigen::Vector3d::Zero();
+    bool with_stiffness = max_torque_ - min_torque_ >= min_torque_range;
+    if (with_stiffness)
+    {
+      const Eigen::LDLT<Eigen::Matrix3d> ldlt(normal_);
+      phi = ldlt.solve(rhs_);
+      // a transmission that gives the wrong way under load is noise, not compliance
+      with_stiffness = ldlt.info() == Eigen::Success && phi[COMPLIANCE] > 0.0;
+    }
+    if (!with_stiffness)
+    {
+      Eigen::Matrix2d normal;
+      normal << normal_(HALF_BACKLASH, HALF_BACKLASH), normal_(HALF_BACKLASH, OFFSET),
+          normal_(OFFSET, HALF_BACKLASH), normal_(OFFSET, OFFSET);
+      const Eigen::Vector2d solution = normal.ldlt().solve(Eigen::Vector2d(rhs_[HALF_BACKLASH], rhs_[OFFSET]));
+      phi << solution[0], 0.0, solution[1];
+    }
+
+    // sum of squared residuals from the normal equations
+    const double residual_squares = squares_ - 2.0 * phi.dot(rhs_) + phi.dot(normal_ * phi);
+    estimate.residual = std::sqrt(std::max(residual_squares, 0.0) / static_cast<double>(samples_));
+    estimate.backlash = std::max(2.0 * phi[HALF_BACKLASH], 0.0);
+    estimate.stiffness = with_stiffness ? 1.0 / phi[COMPLIANCE] : 0.0;
+    estimate.offset = phi[OFFSET];
+    estimate.success = true;
+    estimate.message = with_stiffness ? "Identified backlash and stiffness."
+                                      : "Identified backlash, the load did not vary enough for the stiffness.";
+    return estimate;
+  }
+
+  void CompensationCalibration::clear()
+  {
+    *this = CompensationCalibration();
+  }
+
+} // namespace robot_calibration
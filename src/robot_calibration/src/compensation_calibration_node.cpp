@@ -0,0 +1,426 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_calibration/compensation_calibration_node.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+#include "hardware_interface/component_parser.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
+#include "robot_planning/kinematics.hpp"
+
+namespace robot_calibration
+{
+  namespace
+  {
+    using robot_dynamics::NUM_JOINTS;
+
+    constexpr double LIMIT_MARGIN = 0.05; // rad kept from the joint limits
+
+    std::vector<std::string> default_joint_names()
+    {
+      std::vector<std::string> names;
+      for (std::size_t i = 0; i < NUM_JOINTS; i++)
+      {
+        names.push_back("joint_" + std::to_string(i + 1));
+      }
+      return names;
+    }
+  } // namespace
+
+  CompensationCalibrationNode::CompensationCalibrationNode(const rclcpp::NodeOptions &options)
+      : Node("compensation_calibration_node", options),
+        joint_names_(default_joint_names())
+  {
+    declare_parameter("range", 0.3);            // rad either side of the start pose
+    declare_parameter("targets", 3);            // positions per joint, each approached from both sides
+    declare_parameter("approach", 0.05);        // rad travelled into every target, more than the backlash
+    declare_parameter("move_time", 1.5);        // s per move
+    declare_parameter("dwell_time", 1.0);       // s at rest on a target, the second half is averaged
+    declare_parameter("min_torque_range", 0.2); // Nm of gravity torque variation to fit the stiffness
+
+    robot_description_sub_ = create_subscription<std_msgs::msg::String>(
+        "/robot_description", rclcpp::QoS(1).transient_local(), [this](const std_msgs::msg::String &msg)
+        { robot_description_callback(msg); });
+    joint_states_sub_ = create_subscription<sensor_msgs::msg::JointState>(
+        "/joint_states", 10, [this](const sensor_msgs::msg::JointState &msg)
+        { joint_states_callback(msg); });
+
+    traj_pub_ = create_publisher<trajectory_msgs::msg::JointTrajectory>("/joint_trajectory_controller/joint_trajectory", 10);
+    compensation_pub_ =
+        create_publisher<control_msgs::msg::DynamicInterfaceGroupValues>("/compensation_controller/commands", 10);
+
+    action_server_ = rclcpp_action::create_server<CalibrateCompensation>(
+        this, "/robot_calibration/calibrate_compensation",
+        [this](const rclcpp_action::GoalUUID &, std::shared_ptr<const CalibrateCompensation::Goal> goal)
+        { return handle_goal(*goal); },
+        [](const std::shared_ptr<GoalHandle>)
+        { return rclcpp_action::CancelResponse::ACCEPT; },
+        [this](const std::shared_ptr<GoalHandle> goal_handle)
+        { handle_accepted(goal_handle); });
+
+    timer_ = create_wall_timer(std::chrono::milliseconds(100), [this]()
+                               { update(); });
+
+    RCLCPP_INFO(get_logger(), "Compensation calibration node ready.");
+  }
+
+  void CompensationCalibrationNode::robot_description_callback(const std_msgs::msg::String &msg)
+  {
+    std::vector<hardware_interface::HardwareInfo> hardware;
+    robot_planning::JointLimits limits;
+    try
+    {
+      hardware = hardware_interface::parse_control_resources_from_urdf(msg.data);
+      limits = robot_planning::JointLimits::from_urdf(msg.data, joint_names_);
+    }
+    catch (const std::exception &e)
+    {
+      RCLCPP_ERROR(get_logger(), "Cannot read the robot description: %s", e.what());
+      return;
+    }
+
+    std::vector<Compensation> configured(NUM_JOINTS);
+    std::size_t found = 0;
+    for (const auto &info : hardware)
+    {
+      for (const auto &joint : info.joints)
+      {
+        const auto it = std::find(joint_names_.begin(), joint_names_.end(), joint.name);
+        if (it == joint_names_.end())
+        {
+          continue;
+        }
+        auto parameter = [&joint](const std::string &name)
+        {
+          const auto value = joint.parameters.find(name);
+          return value != joint.parameters.end() ? std::stod(value->second) : 0.0;
+        };
+        try
+        {
+          Compensation &compensation = configured[static_cast<std::size_t>(it - joint_names_.begin())];
+          compensation.backlash = parameter("backlash");
+          compensation.stiffness = parameter("stiffness");
+          found++;
+        }
+        catch (const std::exception &)
+        {
+          RCLCPP_ERROR(get_logger(), "Joint '%s' has an invalid backlash or stiffness.", joint.name.c_str());
+          return;
+        }
+      }
+    }
+    if (found != NUM_JOINTS)
+    {
+      RCLCPP_ERROR(get_logger(), "The robot description does not have all %zu joints.", NUM_JOINTS);
+      return;
+    }
+    configured_ = std::move(configured);
+    limits_ = limits;
+  }
+
+  void CompensationCalibrationNode::joint_states_callback(const sensor_msgs::msg::JointState &msg)
+  {
+    JointVector q;
+    JointVector effort = JointVector::Zero();
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      const auto it = std::find(msg.name.begin(), msg.name.end(), joint_names_[i]);
+      const std::size_t index = static_cast<std::size_t>(it - msg.name.begin());
+      if (it == msg.name.end() || index >= msg.position.size())
+      {
+        return;
+      }
+      q[i] = msg.position[index];
+      if (index < msg.effort.size())
+      {
+        effort[i] = msg.effort[index];
+      }
+    }
+    current_joint_positions_ = q;
+    has_joint_state_ = true;
+    if (recording_)
+    {
+      joint_samples_.push_back({rclcpp::Time(msg.header.stamp).seconds(), q, effort});
+    }
+  }
+
+  rclcpp_action::GoalResponse CompensationCalibrationNode::handle_goal(const CalibrateCompensation::Goal &goal)
+  {
+    if (active_goal_)
+    {
+      RCLCPP_WARN(get_logger(), "Compensation calibration already running.");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    if (configured_.empty() || !has_joint_state_)
+    {
+      RCLCPP_WARN(get_logger(), "No %s yet.", configured_.empty() ? "robot description" : "joint states");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    if (goal.range < 0.0)
+    {
+      RCLCPP_WARN(get_logger(), "Negative range.");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    for (const auto &name : goal.joint_names)
+    {
+      if (std::find(joint_names_.begin(), joint_names_.end(), name) == joint_names_.end())
+      {
+        RCLCPP_WARN(get_logger(), "Unknown joint '%s'.", name.c_str());
+        return rclcpp_action::GoalResponse::REJECT;
+      }
+    }
+    return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+  }
+
+  void CompensationCalibrationNode::handle_accepted(const std::shared_ptr<GoalHandle> goal_handle)
+  {
+    const auto goal = goal_handle->get_goal();
+    const double range = goal->range > 0.0 ? goal->range : get_parameter("range").as_double();
+
+    joints_.clear();
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      if (goal->joint_names.empty() ||
+          std::find(goal->joint_names.begin(), goal->joint_names.end(), joint_names_[i]) != goal->joint_names.end())
+      {
+        joints_.push_back(i);
+      }
+    }
+
+    // the calibrated joints move without compensation so the fit sees all of it
+    std::vector<Compensation> compensation = configured_;
+    for (std::size_t joint : joints_)
+    {
+      compensation[joint] = Compensation();
+    }
+    publish_compensation(compensation);
+
+    active_goal_ = goal_handle;
+    start_position_ = current_joint_positions_;
+    auto trajectory = excitation(start_position_, range);
+    joint_samples_.clear();
+    joint_samples_.reserve(static_cast<std::size_t>(duration_ * 1000.0));
+    start_time_ = rclcpp::Time(trajectory->header.stamp);
+    recording_ = true;
+    traj_pub_->publish(std::move(trajectory));
+    RCLCPP_INFO(get_logger(), "Compensation calibration of %zu joints started (%.0f s).", joints_.size(), duration_);
+  }
+
+  std::unique_ptr<trajectory_msgs::msg::JointTrajectory> CompensationCalibrationNode::excitation(
+      const JointVector &start, double range)
+  {
+    const robot_planning::JointLimits &limits = limits_;
+    const int targets = std::max<int>(static_cast<int>(get_parameter("targets").as_int()), 1);
+    const double approach = get_parameter("approach").as_double();
+    const double move_time = get_parameter("move_time").as_double();
+    const double dwell_time = get_parameter("dwell_time").as_double();
+
+    auto trajectory = std::make_unique<trajectory_msgs::msg::JointTrajectory>();
+    trajectory->header.stamp = now();
+    trajectory->joint_names = joint_names_;
+
+    // every point is a stop, the trajectory controller's splines start and end at rest
+    JointVector q = start;
+    double t = 0.0;
+    auto add_point = [&](double dt)
+    {
+      t += dt;
+      trajectory_msgs::msg::JointTrajectoryPoint point;
+      point.positions.assign(q.data(), q.data() + NUM_JOINTS);
+      point.velocities.assign(NUM_JOINTS, 0.0);
+      point.time_from_start = rclcpp::Duration::from_seconds(t);
+      trajectory->points.push_back(std::move(point));
+    };
+
+    windows_.clear();
+    for (std::size_t joint : joints_)
+    {
+      const double lowest = limits.lower[joint] + LIMIT_MARGIN + approach;
+      const double highest = limits.upper[joint] - LIMIT_MARGIN - approach;
+      const double lower = std::clamp(start[joint] - range, lowest, highest);
+      const double upper = std::clamp(start[joint] + range, lowest, highest);
+      for (int k = 0; k < targets; k++)
+      {
+        const double target = targets > 1 ? lower + (upper - lower) * k / (targets - 1) : 0.5 * (lower + upper);
+        for (const double direction : {1.0, -1.0})
+        {
+          q[joint] = target - direction * approach;
+          add_point(move_time);
+          q[joint] = target;
+          add_point(move_time);
+          add_point(dwell_time);
+          windows_.push_back({joint, direction, target, t - 0.5 * dwell_time, t});
+        }
+      }
+      q[joint] = start[joint];
+      add_point(move_time);
+    }
+    duration_ = t;
+    return trajectory;
+  }
+
+  void CompensationCalibrationNode::update()
+  {
+    if (!active_goal_)
+    {
+      return;
+    }
+
+    const double elapsed = (now() - start_time_).seconds();
+
+    if (active_goal_->is_canceling())
+    {
+      recording_ = false;
+      // back to where the calibration started
+      auto hold = std::make_unique<trajectory_msgs::msg::JointTrajectory>();
+      hold->header.stamp = now();
+      hold->joint_names = joint_names_;
+      hold->points.resize(1);
+      hold->points[0].positions.assign(start_position_.data(), start_position_.data() + NUM_JOINTS);
+      hold->points[0].time_from_start = rclcpp::Duration::from_seconds(get_parameter("move_time").as_double());
+      traj_pub_->publish(std::move(hold));
+      publish_compensation(configured_);
+
+      auto result = std::make_shared<CalibrateCompensation::Result>();
+      result->message = "Canceled.";
+      active_goal_->canceled(result);
+      active_goal_.reset();
+      return;
+    }
+
+    if (elapsed < duration_)
+    {
+      auto feedback = std::make_shared<CalibrateCompensation::Feedback>();
+      feedback->progress = std::clamp(elapsed / duration_, 0.0, 1.0);
+      const auto window = std::find_if(windows_.begin(), windows_.end(), [elapsed](const Window &w)
+                                       { return elapsed < w.end; });
+      if (window != windows_.end())
+      {
+        feedback->joint_name = joint_names_[window->joint];
+      }
+      active_goal_->publish_feedback(feedback);
+      return;
+    }
+
+    recording_ = false;
+    finish();
+  }
+
+  void CompensationCalibrationNode::publish_compensation(const std::vector<Compensation> &compensation)
+  {
+    control_msgs::msg::InterfaceValue values;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      values.interface_names.push_back(joint_names_[i] + ".backlash");
+      values.values.push_back(compensation[i].backlash);
+      values.interface_names.push_back(joint_names_[i] + ".stiffness");
+      values.values.push_back(compensation[i].stiffness);
+    }
+
+    control_msgs::msg::DynamicInterfaceGroupValues msg;
+    msg.header.stamp = now();
+    msg.interface_groups = {"compensation"};
+    msg.interface_values = {values};
+    compensation_pub_->publish(msg);
+  }
+
+  void CompensationCalibrationNode::finish()
+  {
+    const double min_torque_range = get_parameter("min_torque_range").as_double();
+    const bool apply = active_goal_->get_goal()->apply;
+
+    auto result = std::make_shared<CalibrateCompensation::Result>();
+    result->success = true;
+    std::vector<Compensation> compensation = configured_;
+    for (std::size_t joint : joints_)
+    {
+      CompensationCalibration calibration;
+      for (const Window &window : windows_)
+      {
+        if (window.joint != joint)
+        {
+          continue;
+        }
+        double position = 0.0;
+        double torque = 0.0;
+        std::size_t count = 0;
+        const double begin = start_time_.seconds() + window.start;
+        const double end = start_time_.seconds() + window.end;
+        for (const JointSample &sample : joint_samples_)
+        {
+          if (sample.time >= begin && sample.time <= end)
+          {
+            position += sample.q[joint];
+            torque += sample.effort[joint];
+            count++;
+          }
+        }
+        if (count > 0)
+        {
+          calibration.add(window.direction, window.target, position / count, torque / count);
+        }
+      }
+
+      const CompensationEstimate estimate = calibration.solve(min_torque_range);
+      result->joint_names.push_back(joint_names_[joint]);
+      result->backlash.push_back(estimate.backlash);
+      result->stiffness.push_back(estimate.stiffness);
+      result->offset.push_back(estimate.offset);
+      result->residual.push_back(estimate.residual);
+      result->samples += static_cast<uint32_t>(estimate.samples);
+      if (estimate.success)
+      {
+        RCLCPP_INFO(get_logger(), "%s: backlash %.4f rad, stiffness %.1f Nm/rad, residual %.5f rad. %s",
+                    joint_names_[joint].c_str(), estimate.backlash, estimate.stiffness, estimate.residual,
+                    estimate.message.c_str());
+        if (apply)
+        {
+          compensation[joint] = {estimate.backlash, estimate.stiffness};
+        }
+      }
+      else
+      {
+        RCLCPP_WARN(get_logger(), "%s: %s", joint_names_[joint].c_str(), estimate.message.c_str());
+        result->success = false;
+        result->message += joint_names_[joint] + ": " + estimate.message + " ";
+      }
+    }
+    publish_compensation(compensation);
+
+    if (result->success)
+    {
+      result->message = apply ? "Calibrated and applied." : "Calibrated, configured values restored.";
+      active_goal_->succeed(result);
+    }
+    else
+    {
+      result->message.pop_back();
+      active_goal_->abort(result);
+    }
+    active_goal_.reset();
+  }
+
+} // namespace robot_calibration
+
+RCLCPP_COMPONENTS_REGISTER_NODE(robot_calibration::CompensationCalibrationNode)
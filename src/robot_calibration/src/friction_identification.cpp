@@ -0,0 +1,232 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_calibration/friction_identification.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <limits>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Core>
+
+namespace robot_calibration
+{
+  namespace
+  {
+    constexpr int NUM_PARAMETERS = 5;
+    constexpr int TORQUE_CONSTANT = 0;
+    constexpr int COULOMB = 1;
+    constexpr int STRIBECK = 2;
+    constexpr int VISCOUS = 3;
+    constexpr int STRIBECK_VELOCITY = 4;
+
+    using Parameters = Eigen::Matrix<double, NUM_PARAMETERS, 1>;
+    using Normal = Eigen::Matrix<double, NUM_PARAMETERS, NUM_PARAMETERS>;
+    using Mask = std::array<bool, NUM_PARAMETERS>;
+
+    constexpr std::array<double, 6> STRIBECK_VELOCITY_GRID = {0.01, 0.02, 0.05, 0.1, 0.2, 0.5}; // rad/s
+    constexpr double MIN_STRIBECK_VELOCITY = 1e-3;
+    constexpr std::size_t MIN_SAMPLES = 100;
+    constexpr std::size_t MAX_ITERATIONS = 100;
+
+    // sum of squared residuals, and with normal the Gauss-Newton normal equations
+    // of the parameters in mask
+    double evaluate(const FrictionSamples &samples, const Parameters &p, double smoothing_velocity,
+                    const Mask *mask = nullptr, Normal *normal = nullptr, Parameters *gradient = nullptr)
+    {
+      if (normal)
+      {
+        normal->setZero();
+        gradient->setZero();
+      }
+      double cost = 0.0;
+      for (std::size_t n = 0; n < samples.velocity.size(); n++)
+      {
+        const double v = samples.velocity[n];
+        const double s = std::tanh(v / smoothing_velocity);
+        const double ratio = v / p[STRIBECK_VELOCITY];
+        const double e = std::exp(-ratio * ratio);
+        const double friction = (p[COULOMB] + (p[STRIBECK] - p[COULOMB]) * e) * s + p[VISCOUS] * v;
+        const double residual = p[TORQUE_CONSTANT] * samples.measured[n] - samples.rigid_torque[n] - friction;
+        cost += residual * residual;
+        if (normal)
+        {
+          Parameters J;
+          J << samples.measured[n], -s * (1.0 - e), -s * e, -v,
+              -(p[STRIBECK] - p[COULOMB]) * s * e * 2.0 * ratio * ratio / p[STRIBECK_VELOCITY];
+          for (int k = 0; k < NUM_PARAMETERS; k++)
+          {
+            if (!(*mask)[k])
+            {
+              J[k] = 0.0;
+            }
+          }
+          normal->noalias() += J * J.transpose();
+          *gradient += J * residual;
+        }
+      }
+      if (normal)
+      {
+        // parameters left out do not move
+        for (int k = 0; k < NUM_PARAMETERS; k++)
+        {
+          if (!(*mask)[k])
+          {
+            (*normal)(k, k) = 1.0;
+          }
+        }
+      }
+      return cost;
+    }
+
+    // Levenberg-Marquardt with Marquardt's diagonal scaling, returns the iterations
+    std::size_t levenberg_marquardt(const FrictionSamples &samples, double smoothing_velocity, const Mask &mask,
+                                    Parameters &p, double &cost)
+    {
+      Normal normal;
+      Parameters gradient;
+      double lambda = 1e-3;
+      std::size_t iteration = 0;
+      cost = evaluate(samples, p, smoothing_velocity, &mask, &normal, &gradient);
+      while (iteration < MAX_ITERATIONS)
+      {
+        iteration++;
+        bool improved = false;
+        double trial_cost = cost;
+        Parameters trial = p;
+        while (lambda < 1e10)
+        {
+          Normal damped = normal;
+          for (int k = 0; k < NUM_PARAMETERS; k++)
+          {
+            damped(k, k) += lambda * normal(k, k) + 1e-12;
+          }
+          trial = p - damped.ldlt().solve(gradient);
+          trial[STRIBECK_VELOCITY] = std::max(trial[STRIBECK_VELOCITY], MIN_STRIBECK_VELOCITY);
+          trial_cost = evaluate(samples, trial, smoothing_velocity);
+          if (trial_cost < cost)
+          {
+            improved = true;
+            lambda = std::max(lambda / 10.0, 1e-12);
+            break;
+          }
+          lambda *= 10.0;
+        }
+        if (!improved)
+        {
+          break;
+        }
+        const double decrease = cost - trial_cost;
+        p = trial;
+        cost = evaluate(samples, p, smoothing_velocity, &mask, &normal, &gradient);
+        if (decrease <= 1e-10 * cost)
+        {
+          break;
+        }
+      }
+      return iteration;
+    }
+  } // namespace
+
+  FrictionEstimate fit_friction(const FrictionSamples &samples, bool fit_torque_constant, double smoothing_velocity)
+  {
+    FrictionEstimate estimate;
+    estimate.samples = samples.velocity.size();
+    estimate.friction.smoothing_velocity = smoothing_velocity;
+    if (samples.measured.size() != estimate.samples || samples.rigid_torque.size() != estimate.samples)
+    {
+      estimate.message = "Sample arrays of different length.";
+      return estimate;
+    }
+    if (estimate.samples < MIN_SAMPLES)
+    {
+      estimate.message = "Too few samples.";
+      return estimate;
+    }
+    const auto [slowest, fastest] = std::minmax_element(samples.velocity.begin(), samples.velocity.end());
+    if (*slowest > -5.0 * smoothing_velocity || *fastest < 5.0 * smoothing_velocity)
+    {
+      estimate.message = "The joint did not move both ways.";
+      return estimate;
+    }
+
+    // Stribeck velocity fixed, one Gauss-Newton step from zero solves the rest exactly
+    Mask mask = {fit_torque_constant, true, true, true, false};
+    Parameters best;
+    double best_cost = std::numeric_limits<double>::infinity();
+    for (const double stribeck_velocity : STRIBECK_VELOCITY_GRID)
+    {
+      Parameters p;
+      p << (fit_torque_constant ? 0.0 : 1.0), 0.0, 0.0, 0.0, stribeck_velocity;
+      Normal normal;
+      Parameters gradient;
+      evaluate(samples, p, smoothing_velocity, &mask, &normal, &gradient);
+      p -= normal.ldlt().solve(gradient);
+      const double cost = evaluate(samples, p, smoothing_velocity);
+      if (cost < best_cost)
+      {
+        best_cost = cost;
+        best = p;
+      }
+    }
+
+    mask[STRIBECK_VELOCITY] = true;
+    double cost = best_cost;
+    estimate.iterations = levenberg_marquardt(samples, smoothing_velocity, mask, best, cost);
+
+    if (fit_torque_constant && !(best[TORQUE_CONSTANT] > 0.0))
+    {
+      estimate.message = "No positive torque constant fits, check the current sign.";
+      return estimate;
+    }
+    estimate.torque_constant = fit_torque_constant ? best[TORQUE_CONSTANT] : 0.0;
+    estimate.friction.coulomb = std::max(best[COULOMB], 0.0);
+    estimate.friction.stribeck = std::max(best[STRIBECK], 0.0);
+    estimate.friction.viscous = std::max(best[VISCOUS], 0.0);
+    estimate.friction.stribeck_velocity = best[STRIBECK_VELOCITY];
+    estimate.residual = std::sqrt(cost / static_cast<double>(estimate.samples));
+    estimate.success = true;
+    estimate.message = best[COULOMB] < 0.0 || best[STRIBECK] < 0.0 || best[VISCOUS] < 0.0
+                           ? "Identified, negative friction terms clamped to 0."
+                           : "Identified.";
+    return estimate;
+  }
+
+  std::vector<FrictionEstimate> fit_joint_friction(const std::vector<FrictionSamples> &joints,
+                                                   bool fit_torque_constant, double smoothing_velocity)
+  {
+    std::vector<std::future<FrictionEstimate>> fits;
+    for (const FrictionSamples &samples : joints)
+    {
+      fits.push_back(std::async(std::launch::async, [&samples, fit_torque_constant, smoothing_velocity]()
+                                { return fit_friction(samples, fit_torque_constant, smoothing_velocity); }));
+    }
+    std::vector<FrictionEstimate> estimates;
+    for (auto &fit : fits)
+    {
+      estimates.push_back(fit.get());
+    }
+    return estimates;
+  }
+
+} // namespace robot_calibration
@@ -0,0 +1,463 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_calibration/friction_identification_node.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+#include "rclcpp_components/register_node_macro.hpp"
+#include "robot_planning/kinematics.hpp"
+
+namespace robot_calibration
+{
+  namespace
+  {
+    using robot_dynamics::NUM_JOINTS;
+
+    // incommensurate so the joints do not move in lockstep
+    constexpr std::array<double, NUM_JOINTS> FREQUENCY_RATIOS = {1.0, 1.17, 1.35, 1.53, 1.71, 1.89};
+
+    constexpr double LIMIT_MARGIN = 0.05; // rad kept from the joint limits
+
+    std::vector<std::string> default_joint_names()
+    {
+      std::vector<std::string> names;
+      for (std::size_t i = 0; i < NUM_JOINTS; i++)
+      {
+        names.push_back("joint_" + std::to_string(i + 1));
+      }
+      return names;
+    }
+
+    // index of name in names, names.size() if it is not there
+    std::size_t find(const std::vector<std::string> &names, const std::string &name)
+    {
+      return static_cast<std::size_t>(std::find(names.begin(), names.end(), name) - names.begin());
+    }
+  } // namespace
+
+  FrictionIdentificationNode::FrictionIdentificationNode(const rclcpp::NodeOptions &options)
+      : Node("friction_identification_node", options),
+        joint_names_(default_joint_names())
+  {
+    declare_parameter("root_link", std::string("base_link"));
+    declare_parameter("tip_link", std::string("link_7"));
+    declare_parameter("samples_topic", std::string("/state_recorder/samples"));
+    declare_parameter("current_interface", std::string("")); // recorded motor current, "" fits to the effort
+    declare_parameter("duration", 30.0);  // s of excitation
+    declare_parameter("amplitude", 0.4);  // rad per joint
+    declare_parameter("frequency", 0.15); // Hz of joint 1, the others run faster
+    declare_parameter("settle_time", 1.0); // s recorded after the excitation
+    declare_parameter("smoothing_velocity", 0.01); // rad/s, has to match the hardware's friction model
+
+    robot_description_sub_ = create_subscription<std_msgs::msg::String>(
+        "/robot_description", rclcpp::QoS(1).transient_local(), [this](const std_msgs::msg::String &msg)
+        { robot_description_callback(msg); });
+    joint_states_sub_ = create_subscription<sensor_msgs::msg::JointState>(
+        "/joint_states", 10, [this](const sensor_msgs::msg::JointState &msg)
+        { joint_states_callback(msg); });
+    samples_sub_ = create_subscription<JointSamples>(
+        get_parameter("samples_topic").as_string(), rclcpp::QoS(100), [this](const JointSamples &msg)
+        { samples_callback(msg); });
+
+    traj_pub_ = create_publisher<trajectory_msgs::msg::JointTrajectory>("/joint_trajectory_controller/joint_trajectory", 10);
+    friction_pub_ = create_publisher<control_msgs::msg::DynamicInterfaceGroupValues>("/friction_controller/commands", 10);
+
+    action_server_ = rclcpp_action::create_server<IdentifyFriction>(
+        this, "/robot_calibration/identify_friction",
+        [this](const rclcpp_action::GoalUUID &, std::shared_ptr<const IdentifyFriction::Goal> goal)
+        { return handle_goal(*goal); },
+        [](const std::shared_ptr<GoalHandle>)
+        { return rclcpp_action::CancelResponse::ACCEPT; },
+        [this](const std::shared_ptr<GoalHandle> goal_handle)
+        { handle_accepted(goal_handle); });
+
+    timer_ = create_wall_timer(std::chrono::milliseconds(100), [this]()
+                               { update(); });
+
+    RCLCPP_INFO(get_logger(), "Friction identification node ready.");
+  }
+
+  void FrictionIdentificationNode::robot_description_callback(const std_msgs::msg::String &msg)
+  {
+    try
+    {
+      model_ = robot_dynamics::DynamicsModel::from_urdf(msg.data, get_parameter("root_link").as_string(),
+                                                        get_parameter("tip_link").as_string());
+      limits_ = robot_planning::JointLimits::from_urdf(msg.data, joint_names_);
+      has_model_ = true;
+    }
+    catch (const std::exception &e)
+    {
+      RCLCPP_ERROR(get_logger(), "Cannot read the robot description: %s", e.what());
+    }
+  }
+
+  void FrictionIdentificationNode::joint_states_callback(const sensor_msgs::msg::JointState &msg)
+  {
+    JointVector q;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      const std::size_t index = find(msg.name, joint_names_[i]);
+      if (index >= msg.name.size() || index >= msg.position.size())
+      {
+        return;
+      }
+      q[i] = msg.position[index];
+    }
+    current_joint_positions_ = q;
+    has_joint_state_ = true;
+  }
+
+  void FrictionIdentificationNode::samples_callback(const JointSamples &msg)
+  {
+    if (!recording_ || !recording_error_.empty())
+    {
+      return;
+    }
+
+    const std::string current_interface = get_parameter("current_interface").as_string();
+    const std::array<std::string, 4> names = {"position", "velocity", "acceleration",
+                                              current_interface.empty() ? std::string("effort") : current_interface};
+    std::array<std::size_t, 4> interfaces;
+    for (std::size_t k = 0; k < names.size(); k++)
+    {
+      interfaces[k] = find(msg.interface_names, names[k]);
+      if (interfaces[k] >= msg.interface_names.size())
+      {
+        recording_error_ = "The recorder has no '" + names[k] + "' interface.";
+        return;
+      }
+    }
+    std::array<std::size_t, NUM_JOINTS> joints;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      joints[i] = find(msg.joint_names, joint_names_[i]);
+      if (joints[i] >= msg.joint_names.size())
+      {
+        recording_error_ = "The recorder has no joint '" + joint_names_[i] + "'.";
+        return;
+      }
+    }
+    const std::size_t stride = msg.joint_names.size() * msg.interface_names.size();
+    if (msg.values.size() != msg.time.size() * stride)
+    {
+      recording_error_ = "Malformed recorder samples.";
+      return;
+    }
+
+    if (!has_dropped_)
+    {
+      first_dropped_ = msg.dropped;
+      has_dropped_ = true;
+    }
+    last_dropped_ = msg.dropped;
+
+    const double start = start_time_.seconds();
+    for (std::size_t n = 0; n < msg.time.size(); n++)
+    {
+      if (msg.time[n] < start)
+      {
+        continue;
+      }
+      Sample sample;
+      const std::array<JointVector *, 4> targets = {&sample.q, &sample.qd, &sample.qdd, &sample.measured};
+      for (std::size_t i = 0; i < NUM_JOINTS; i++)
+      {
+        const std::size_t offset = n * stride + joints[i] * msg.interface_names.size();
+        for (std::size_t k = 0; k < interfaces.size(); k++)
+        {
+          (*targets[k])[i] = msg.values[offset + interfaces[k]];
+        }
+      }
+      samples_.push_back(sample);
+    }
+  }
+
+  rclcpp_action::GoalResponse FrictionIdentificationNode::handle_goal(const IdentifyFriction::Goal &goal)
+  {
+    if (active_goal_)
+    {
+      RCLCPP_WARN(get_logger(), "Friction identification already running.");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    if (!has_model_ || !has_joint_state_)
+    {
+      RCLCPP_WARN(get_logger(), "No %s yet.", has_model_ ? "joint states" : "robot description");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    if (goal.duration < 0.0 || goal.amplitude < 0.0)
+    {
+      RCLCPP_WARN(get_logger(), "Negative duration or amplitude.");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    for (const auto &name : goal.joint_names)
+    {
+      if (find(joint_names_, name) >= joint_names_.size())
+      {
+        RCLCPP_WARN(get_logger(), "Unknown joint '%s'.", name.c_str());
+        return rclcpp_action::GoalResponse::REJECT;
+      }
+    }
+    return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+  }
+
+  void FrictionIdentificationNode::handle_accepted(const std::shared_ptr<GoalHandle> goal_handle)
+  {
+    const auto goal = goal_handle->get_goal();
+    duration_ = goal->duration > 0.0 ? goal->duration : get_parameter("duration").as_double();
+    const double amplitude = goal->amplitude > 0.0 ? goal->amplitude : get_parameter("amplitude").as_double();
+
+    joints_.clear();
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      if (goal->joint_names.empty() || find(goal->joint_names, joint_names_[i]) < goal->joint_names.size())
+      {
+        joints_.push_back(i);
+      }
+    }
+
+    active_goal_ = goal_handle;
+    start_position_ = current_joint_positions_;
+    samples_.clear();
+    samples_.reserve(static_cast<std::size_t>((duration_ + get_parameter("settle_time").as_double()) * 1000.0));
+    recording_error_.clear();
+    has_dropped_ = false;
+
+    auto trajectory = excitation(start_position_, duration_, amplitude);
+    start_time_ = rclcpp::Time(trajectory->header.stamp);
+    recording_ = true;
+    traj_pub_->publish(std::move(trajectory));
+    RCLCPP_INFO(get_logger(), "Friction identification of %zu joints started (%.1f s, %.2f rad).", joints_.size(),
+                duration_, amplitude);
+  }
+
+  std::unique_ptr<trajectory_msgs::msg::JointTrajectory> FrictionIdentificationNode::excitation(
+      const JointVector &start, double duration, double amplitude) const
+  {
+    const robot_planning::JointLimits &limits = limits_;
+    const double frequency = get_parameter("frequency").as_double();
+
+    // q = q0 + A sin^2(pi t / T) sin(w t): starts and ends at rest at the start pose,
+    // and every zero crossing of the velocity sweeps the Stribeck region
+    JointVector amplitudes = JointVector::Zero();
+    JointVector omegas = JointVector::Zero();
+    for (std::size_t joint : joints_)
+    {
+      const double room = std::min(limits.upper[joint] - start[joint], start[joint] - limits.lower[joint]) - LIMIT_MARGIN;
+      amplitudes[joint] = std::clamp(room, 0.0, amplitude);
+      omegas[joint] = 2.0 * M_PI * frequency * FREQUENCY_RATIOS[joint];
+    }
+
+    auto trajectory = std::make_unique<trajectory_msgs::msg::JointTrajectory>();
+    trajectory->header.stamp = now();
+    trajectory->joint_names = joint_names_;
+
+    const double period = 0.05;
+    const std::size_t num_points = static_cast<std::size_t>(std::ceil(duration / period)) + 1;
+    const double window = M_PI / duration;
+    trajectory->points.resize(num_points);
+    for (std::size_t i = 0; i < num_points; i++)
+    {
+      const double t = std::min(i * period, duration);
+      const double s = std::sin(window * t);
+      const double c = std::cos(window * t);
+      const double w = s * s;
+      const double w_dot = 2.0 * window * s * c;
+      const double w_ddot = 2.0 * window * window * (c * c - s * s);
+
+      auto &point = trajectory->points[i];
+      point.positions.assign(start.data(), start.data() + NUM_JOINTS);
+      point.velocities.assign(NUM_JOINTS, 0.0);
+      point.accelerations.assign(NUM_JOINTS, 0.0);
+      for (std::size_t joint : joints_)
+      {
+        const double A = amplitudes[joint];
+        const double omega = omegas[joint];
+        const double sin_wt = std::sin(omega * t);
+        const double cos_wt = std::cos(omega * t);
+        point.positions[joint] += A * w * sin_wt;
+        point.velocities[joint] = A * (w_dot * sin_wt + w * omega * cos_wt);
+        point.accelerations[joint] = A * (w_ddot * sin_wt + 2.0 * w_dot * omega * cos_wt - w * omega * omega * sin_wt);
+      }
+      point.time_from_start = rclcpp::Duration::from_seconds(t);
+    }
+    return trajectory;
+  }
+
+  void FrictionIdentificationNode::update()
+  {
+    if (!active_goal_)
+    {
+      return;
+    }
+
+    const double total = duration_ + get_parameter("settle_time").as_double();
+    const double elapsed = (now() - start_time_).seconds();
+
+    if (active_goal_->is_canceling())
+    {
+      recording_ = false;
+      // back to where the excitation started
+      auto hold = std::make_unique<trajectory_msgs::msg::JointTrajectory>();
+      hold->header.stamp = now();
+      hold->joint_names = joint_names_;
+      hold->points.resize(1);
+      hold->points[0].positions.assign(start_position_.data(), start_position_.data() + NUM_JOINTS);
+      hold->points[0].time_from_start = rclcpp::Duration::from_seconds(1.0);
+      traj_pub_->publish(std::move(hold));
+
+      auto result = std::make_shared<IdentifyFriction::Result>();
+      result->message = "Canceled.";
+      active_goal_->canceled(result);
+      active_goal_.reset();
+      return;
+    }
+
+    if (elapsed < total)
+    {
+      auto feedback = std::make_shared<IdentifyFriction::Feedback>();
+      feedback->progress = std::clamp(elapsed / total, 0.0, 1.0);
+      feedback->samples = static_cast<uint32_t>(samples_.size());
+      active_goal_->publish_feedback(feedback);
+      return;
+    }
+
+    recording_ = false;
+    identify();
+  }
+
+  void FrictionIdentificationNode::identify()
+  {
+    auto result = std::make_shared<IdentifyFriction::Result>();
+    result->samples = static_cast<uint32_t>(samples_.size());
+    if (!recording_error_.empty() || samples_.empty())
+    {
+      result->message = recording_error_.empty() ? "No samples from the state recorder." : recording_error_;
+      RCLCPP_WARN(get_logger(), "Friction identification failed: %s", result->message.c_str());
+      active_goal_->abort(result);
+      active_goal_.reset();
+      return;
+    }
+
+    // whatever the rigid body model does not explain is left to the friction
+    std::vector<FrictionSamples> joints(joints_.size());
+    for (FrictionSamples &joint : joints)
+    {
+      joint.velocity.reserve(samples_.size());
+      joint.measured.reserve(samples_.size());
+      joint.rigid_torque.reserve(samples_.size());
+    }
+    JointVector tau;
+    for (const Sample &sample : samples_)
+    {
+      model_.inverse_dynamics(sample.q, sample.qd, sample.qdd, tau);
+      for (std::size_t k = 0; k < joints_.size(); k++)
+      {
+        joints[k].velocity.push_back(sample.qd[joints_[k]]);
+        joints[k].measured.push_back(sample.measured[joints_[k]]);
+        joints[k].rigid_torque.push_back(tau[joints_[k]]);
+      }
+    }
+
+    const bool fit_torque_constant = !get_parameter("current_interface").as_string().empty();
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<FrictionEstimate> estimates =
+        fit_joint_friction(joints, fit_torque_constant, get_parameter("smoothing_velocity").as_double());
+    const double fit_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    result->success = true;
+    for (std::size_t k = 0; k < joints_.size(); k++)
+    {
+      const FrictionEstimate &estimate = estimates[k];
+      const std::string &name = joint_names_[joints_[k]];
+      result->joint_names.push_back(name);
+      result->coulomb.push_back(estimate.friction.coulomb);
+      result->stribeck.push_back(estimate.friction.stribeck);
+      result->viscous.push_back(estimate.friction.viscous);
+      result->stribeck_velocity.push_back(estimate.friction.stribeck_velocity);
+      result->torque_constant.push_back(estimate.torque_constant);
+      result->residual.push_back(estimate.residual);
+      if (estimate.success)
+      {
+        RCLCPP_INFO(get_logger(), "%s: coulomb %.3f Nm, stribeck %.3f Nm at %.3f rad/s, viscous %.3f Nm s/rad, "
+                                  "torque constant %.3f Nm/A, residual %.3f Nm (%zu iterations).",
+                    name.c_str(), estimate.friction.coulomb, estimate.friction.stribeck,
+                    estimate.friction.stribeck_velocity, estimate.friction.viscous, estimate.torque_constant,
+                    estimate.residual, estimate.iterations);
+      }
+      else
+      {
+        RCLCPP_WARN(get_logger(), "%s: %s", name.c_str(), estimate.message.c_str());
+        result->success = false;
+        result->message += name + ": " + estimate.message + " ";
+      }
+    }
+    if (has_dropped_ && last_dropped_ > first_dropped_)
+    {
+      result->message += "The recorder dropped " + std::to_string(last_dropped_ - first_dropped_) + " samples. ";
+    }
+
+    if (result->success)
+    {
+      if (active_goal_->get_goal()->apply)
+      {
+        apply(estimates);
+      }
+      result->message += "Fitted in " + std::to_string(static_cast<int>(fit_time * 1000.0)) + " ms.";
+      active_goal_->succeed(result);
+    }
+    else
+    {
+      result->message.pop_back();
+      active_goal_->abort(result);
+    }
+    active_goal_.reset();
+  }
+
+  void FrictionIdentificationNode::apply(const std::vector<FrictionEstimate> &estimates)
+  {
+    control_msgs::msg::InterfaceValue values;
+    for (std::size_t k = 0; k < joints_.size(); k++)
+    {
+      const std::string &name = joint_names_[joints_[k]];
+      const robot_dynamics::FrictionParameters &friction = estimates[k].friction;
+      values.interface_names.insert(values.interface_names.end(),
+                                    {name + ".coulomb", name + ".stribeck", name + ".viscous",
+                                     name + ".stribeck_velocity"});
+      values.values.insert(values.values.end(),
+                           {friction.coulomb, friction.stribeck, friction.viscous, friction.stribeck_velocity});
+    }
+
+    control_msgs::msg::DynamicInterfaceGroupValues msg;
+    msg.header.stamp = now();
+    msg.interface_groups = {"friction"};
+    msg.interface_values = {values};
+    friction_pub_->publish(msg);
+    RCLCPP_INFO(get_logger(), "Applied the friction of %zu joints.", joints_.size());
+  }
+
+} // namespace robot_calibration
+
+RCLCPP_COMPONENTS_REGISTER_NODE(robot_calibration::FrictionIdentificationNode)
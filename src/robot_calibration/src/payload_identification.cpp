@@ -0,0 +1,215 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_calibration/payload_identification.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Eigenvalues>
+
+namespace robot_calibration
+{
+  namespace
+  {
+    Eigen::Matrix3d skew(const Eigen::Vector3d &v)
+    {
+      Eigen::Matrix3d S;
+      S << 0.0, -v.z(), v.y(),
+          v.z(), 0.0, -v.x(),
+          -v.y(), v.x(), 0.0;
+      return S;
+    }
+
+    // I w = L(w) * (xx, xy, xz, yy, yz, zz)
+    Eigen::Matrix<double, 3, 6> inertia_map(const Eigen::Vector3d &w)
+    {
+      Eigen::Matrix<double, 3, 6> L;
+      L << w.x(), w.y(), w.z(), 0.0, 0.0, 0.0,
+          0.0, w.x(), 0.0, w.y(), w.z(), 0.0,
+          0.0, 0.0, w.x(), 0.0, w.y(), w.z();
+      return L;
+    }
+
+    constexpr std::size_t MASS = 0;
+    constexpr std::size_t FIRST_MOMENT = 1;
+    constexpr std::size_t INERTIA = 4;
+    constexpr std::size_t FORCE_OFFSET = 10;
+    constexpr std::size_t TORQUE_OFFSET = 13;
+
+    // below this ratio of the extreme eigenvalues of the scaled normal matrix the
+    // excitation did not separate the parameters
+    constexpr double MIN_CONDITION = 1e-8;
+  } // namespace
+
+  void PayloadIdentification::regressor(const robot_dynamics::TipMotion &motion, const Eigen::Vector3d &gravity,
+                                        Regressor &Y)
+  {
+    // force  = m (g - a) - w' x m c - w x (w x m c) + f0
+    // torque = m c x (g - a) - I w' - w x I w + t0, I about the frame origin
+    const Eigen::Vector3d &w = motion.angular_velocity;
+    const Eigen::Vector3d &w_dot = motion.angular_acceleration;
+    const Eigen::Vector3d g = motion.rotation.transpose() * gravity - motion.linear_acceleration;
+    const Eigen::Matrix3d W = skew(w);
+
+    Y.setZero();
+    Y.block<3, 1>(0, MASS) = g;
+    Y.block<3, 3>(0, FIRST_MOMENT) = -(skew(w_dot) + W * W);
+    Y.block<3, 3>(0, FORCE_OFFSET).setIdentity();
+    Y.block<3, 3>(3, FIRST_MOMENT) = -skew(g);
+    Y.block<3, 6>(3, INERTIA) = -(inertia_map(w_dot) + W * inertia_map(w));
+    Y.block<3, 3>(3, TORQUE_OFFSET).setIdentity();
+  }
+
+  void PayloadIdentification::add(const robot_dynamics::TipMotion &motion, const Eigen::Vector3d &gravity,
+                                  const Vector6d &wrench)
+  {
+    Regressor Y;
+    regressor(motion, gravity, Y);
+    const auto Yf = Y.topRows<3>();
+    const auto Yt = Y.bottomRows<3>();
+    force_normal_.noalias() += Yf.transpose() * Yf;
+    torque_normal_.noalias() += Yt.transpose() * Yt;
+    force_rhs_.noalias() += Yf.transpose() * wrench.head<3>();
+    torque_rhs_.noalias() += Yt.transpose() * wrench.tail<3>();
+    force_squares_ += wrench.head<3>().squaredNorm();
+    torque_squares_ += wrench.tail<3>().squaredNorm();
+    samples_++;
+  }
+
+  void PayloadIdentification::clear()
+  {
+    *this = PayloadIdentification();
+  }
+
+  bool PayloadIdentification::solve_parameters(bool with_inertia, Parameters &phi) const
+  {
+    std::array<std::size_t, NUM_PARAMETERS> columns;
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < NUM_PARAMETERS; i++)
+    {
+      if (with_inertia || i < INERTIA || i >= FORCE_OFFSET)
+      {
+        columns[n++] = i;
+      }
+    }
+
+    const Eigen::MatrixXd normal = force_normal_ + torque_normal_;
+    const Eigen::VectorXd rhs = force_rhs_ + torque_rhs_;
+    Eigen::MatrixXd A(n, n);
+    Eigen::VectorXd b(n);
+    Eigen::VectorXd scale(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+      scale[i] = normal(columns[i], columns[i]) > 0.0 ? 1.0 / std::sqrt(normal(columns[i], columns[i])) : 0.0;
+    }
+    for (std::size_t i = 0; i < n; i++)
+    {
+      b[i] = scale[i] * rhs[columns[i]];
+      for (std::size_t j = 0; j < n; j++)
+      {
+        A(i, j) = scale[i] * normal(columns[i], columns[j]) * scale[j];
+      }
+    }
+
+    const Eigen::VectorXd eigenvalues = Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>(A, Eigen::EigenvaluesOnly).eigenvalues();
+    if (!(eigenvalues.minCoeff() > MIN_CONDITION * eigenvalues.maxCoeff()))
+    {
+      return false;
+    }
+
+    const Eigen::VectorXd y = A.ldlt().solve(b);
+    phi.setZero();
+    for (std::size_t i = 0; i < n; i++)
+    {
+      phi[columns[i]] = scale[i] * y[i];
+    }
+    return true;
+  }
+
+  bool PayloadIdentification::physical_inertia(const Parameters &phi, Eigen::Matrix3d &inertia)
+  {
+    if (!(phi[MASS] > 0.0))
+    {
+      return false;
+    }
+    const Eigen::Matrix<double, 6, 1> I = phi.segment<6>(INERTIA);
+    const Eigen::Vector3d c = phi.segment<3>(FIRST_MOMENT) / phi[MASS];
+    inertia << I[0], I[1], I[2],
+        I[1], I[3], I[4],
+        I[2], I[4], I[5];
+    inertia -= phi[MASS] * (c.squaredNorm() * Eigen::Matrix3d::Identity() - c * c.transpose());
+    return Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d>(inertia, Eigen::EigenvaluesOnly).eigenvalues().minCoeff() >= 0.0;
+  }
+
+  PayloadEstimate PayloadIdentification::solve(double min_mass) const
+  {
+    PayloadEstimate estimate;
+    estimate.samples = samples_;
+    if (samples_ < NUM_PARAMETERS)
+    {
+      estimate.message = "Not enough samples (" + std::to_string(samples_) + ").";
+      return estimate;
+    }
+
+    // the inertia needs angular acceleration well above the noise, without it the
+    // inertia columns soak up noise and spoil the centre of mass
+    Parameters phi;
+    Eigen::Matrix3d inertia = Eigen::Matrix3d::Zero();
+    estimate.inertia_identified = solve_parameters(true, phi) && physical_inertia(phi, inertia);
+    if (!estimate.inertia_identified)
+    {
+      inertia.setZero();
+    }
+    if (!estimate.inertia_identified && !solve_parameters(false, phi))
+    {
+      estimate.message = "Excitation does not separate the payload from the sensor bias.";
+      return estimate;
+    }
+
+    const double force_error = phi.dot(force_normal_ * phi) - 2.0 * phi.dot(force_rhs_) + force_squares_;
+    const double torque_error = phi.dot(torque_normal_ * phi) - 2.0 * phi.dot(torque_rhs_) + torque_squares_;
+    estimate.force_residual = std::sqrt(std::max(force_error, 0.0) / (3.0 * samples_));
+    estimate.torque_residual = std::sqrt(std::max(torque_error, 0.0) / (3.0 * samples_));
+    estimate.offset << phi.segment<3>(FORCE_OFFSET), phi.segment<3>(TORQUE_OFFSET);
+    estimate.success = true;
+
+    if (phi[MASS] < min_mass)
+    {
+      estimate.inertia_identified = false;
+      estimate.message = "No payload detected.";
+      return estimate;
+    }
+
+    estimate.mass = phi[MASS];
+    estimate.com = phi.segment<3>(FIRST_MOMENT) / estimate.mass;
+    estimate.inertia = inertia;
+    estimate.message = "Identified " + std::to_string(estimate.mass) + " kg from " + std::to_string(samples_) + " samples.";
+    if (!estimate.inertia_identified)
+    {
+      estimate.message += " Too little excitation for the inertia, point mass assumed.";
+    }
+    return estimate;
+  }
+
+} // namespace robot_calibration
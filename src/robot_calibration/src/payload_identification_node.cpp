@@ -0,0 +1,381 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_calibration/payload_identification_node.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+#include "rclcpp_components/register_node_macro.hpp"
+#include "robot_planning/kinematics.hpp"
+
+namespace robot_calibration
+{
+  namespace
+  {
+    using robot_dynamics::NUM_JOINTS;
+
+    // wrist joints 4 to 6 at incommensurate frequencies, so the payload sees many
+    // orientations and some angular acceleration about every axis
+    constexpr std::size_t FIRST_EXCITED_JOINT = 3;
+    constexpr std::array<double, 3> FREQUENCY_RATIOS = {1.0, 1.35, 1.7};
+
+    constexpr double LIMIT_MARGIN = 0.05; // rad kept from the joint limits
+
+    std::vector<std::string> default_joint_names()
+    {
+      std::vector<std::string> names;
+      for (std::size_t i = 0; i < NUM_JOINTS; i++)
+      {
+        names.push_back("joint_" + std::to_string(i + 1));
+      }
+      return names;
+    }
+  } // namespace
+
+  PayloadIdentificationNode::PayloadIdentificationNode(const rclcpp::NodeOptions &options)
+      : Node("payload_identification_node", options),
+        joint_names_(default_joint_names())
+  {
+    declare_parameter("root_link", std::string("base_link"));
+    declare_parameter("tip_link", std::string("link_7")); // the frame of tcp_fts_sensor
+    declare_parameter("wrench_topic", std::string("/fts_broadcaster/wrench"));
+    declare_parameter("duration", 20.0); // s of excitation
+    declare_parameter("amplitude", 0.6); // rad per wrist joint
+    declare_parameter("frequency", 0.4); // Hz of joint 4, joints 5 and 6 run faster
+    declare_parameter("settle_time", 1.0); // s recorded after the excitation
+    declare_parameter("differentiation_step", 0.05); // s, central differences of the joint states
+    declare_parameter("min_mass", 0.005); // kg, lighter is reported as no payload
+
+    robot_description_sub_ = create_subscription<std_msgs::msg::String>(
+        "/robot_description", rclcpp::QoS(1).transient_local(), [this](const std_msgs::msg::String &msg)
+        { robot_description_callback(msg); });
+    joint_states_sub_ = create_subscription<sensor_msgs::msg::JointState>(
+        "/joint_states", 10, [this](const sensor_msgs::msg::JointState &msg)
+        { joint_states_callback(msg); });
+    wrench_sub_ = create_subscription<geometry_msgs::msg::WrenchStamped>(
+        get_parameter("wrench_topic").as_string(), rclcpp::SensorDataQoS(),
+        [this](const geometry_msgs::msg::WrenchStamped &msg)
+        { wrench_callback(msg); });
+
+    traj_pub_ = create_publisher<trajectory_msgs::msg::JointTrajectory>("/joint_trajectory_controller/joint_trajectory", 10);
+    payload_pub_ = create_publisher<control_msgs::msg::DynamicInterfaceGroupValues>("/payload_controller/commands", 10);
+
+    action_server_ = rclcpp_action::create_server<IdentifyPayload>(
+        this, "/robot_calibration/identify_payload",
+        [this](const rclcpp_action::GoalUUID &, std::shared_ptr<const IdentifyPayload::Goal> goal)
+        { return handle_goal(*goal); },
+        [](const std::shared_ptr<GoalHandle>)
+        { return rclcpp_action::CancelResponse::ACCEPT; },
+        [this](const std::shared_ptr<GoalHandle> goal_handle)
+        { handle_accepted(goal_handle); });
+
+    timer_ = create_wall_timer(std::chrono::milliseconds(100), [this]()
+                               { update(); });
+
+    RCLCPP_INFO(get_logger(), "Payload identification node ready.");
+  }
+
+  void PayloadIdentificationNode::robot_description_callback(const std_msgs::msg::String &msg)
+  {
+    try
+    {
+      model_ = robot_dynamics::DynamicsModel::from_urdf(msg.data, get_parameter("root_link").as_string(),
+                                                        get_parameter("tip_link").as_string());
+      limits_ = robot_planning::JointLimits::from_urdf(msg.data, joint_names_);
+      has_model_ = true;
+    }
+    catch (const std::exception &e)
+    {
+      RCLCPP_ERROR(get_logger(), "Cannot read the robot description: %s", e.what());
+    }
+  }
+
+  void PayloadIdentificationNode::joint_states_callback(const sensor_msgs::msg::JointState &msg)
+  {
+    JointVector q;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      const auto it = std::find(msg.name.begin(), msg.name.end(), joint_names_[i]);
+      const std::size_t index = static_cast<std::size_t>(it - msg.name.begin());
+      if (it == msg.name.end() || index >= msg.position.size())
+      {
+        return;
+      }
+      q[i] = msg.position[index];
+    }
+    current_joint_positions_ = q;
+    has_joint_state_ = true;
+    if (recording_)
+    {
+      joint_samples_.push_back({rclcpp::Time(msg.header.stamp).seconds(), q});
+    }
+  }
+
+  void PayloadIdentificationNode::wrench_callback(const geometry_msgs::msg::WrenchStamped &msg)
+  {
+    if (!recording_)
+    {
+      return;
+    }
+    WrenchSample sample;
+    sample.time = rclcpp::Time(msg.header.stamp).seconds();
+    sample.wrench << msg.wrench.force.x, msg.wrench.force.y, msg.wrench.force.z,
+        msg.wrench.torque.x, msg.wrench.torque.y, msg.wrench.torque.z;
+    wrench_samples_.push_back(sample);
+  }
+
+  rclcpp_action::GoalResponse PayloadIdentificationNode::handle_goal(const IdentifyPayload::Goal &goal)
+  {
+    if (active_goal_)
+    {
+      RCLCPP_WARN(get_logger(), "Payload identification already running.");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    if (!has_model_ || !has_joint_state_)
+    {
+      RCLCPP_WARN(get_logger(), "No %s yet.", has_model_ ? "joint states" : "robot description");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    if (goal.duration < 0.0 || goal.amplitude < 0.0)
+    {
+      RCLCPP_WARN(get_logger(), "Negative duration or amplitude.");
+      return rclcpp_action::GoalResponse::REJECT;
+    }
+    return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+  }
+
+  void PayloadIdentificationNode::handle_accepted(const std::shared_ptr<GoalHandle> goal_handle)
+  {
+    const auto goal = goal_handle->get_goal();
+    duration_ = goal->duration > 0.0 ? goal->duration : get_parameter("duration").as_double();
+    const double amplitude = goal->amplitude > 0.0 ? goal->amplitude : get_parameter("amplitude").as_double();
+
+    active_goal_ = goal_handle;
+    start_position_ = current_joint_positions_;
+    joint_samples_.clear();
+    wrench_samples_.clear();
+    const std::size_t expected = static_cast<std::size_t>(duration_ * 1000.0);
+    joint_samples_.reserve(expected);
+    wrench_samples_.reserve(expected);
+
+    auto trajectory = excitation(start_position_, duration_, amplitude);
+    start_time_ = rclcpp::Time(trajectory->header.stamp);
+    recording_ = true;
+    traj_pub_->publish(std::move(trajectory));
+    RCLCPP_INFO(get_logger(), "Payload identification started (%.1f s, %.2f rad).", duration_, amplitude);
+  }
+
+  std::unique_ptr<trajectory_msgs::msg::JointTrajectory> PayloadIdentificationNode::excitation(
+      const JointVector &start, double duration, double amplitude) const
+  {
+    const robot_planning::JointLimits &limits = limits_;
+    const double frequency = get_parameter("frequency").as_double();
+
+    // q = q0 + A sin^2(pi t / T) sin(w t): starts and ends at rest at the start pose
+    std::array<double, 3> amplitudes;
+    std::array<double, 3> omegas;
+    for (std::size_t j = 0; j < 3; j++)
+    {
+      const std::size_t joint = FIRST_EXCITED_JOINT + j;
+      const double room = std::min(limits.upper[joint] - start[joint], start[joint] - limits.lower[joint]) - LIMIT_MARGIN;
+      amplitudes[j] = std::clamp(room, 0.0, amplitude);
+      omegas[j] = 2.0 * M_PI * frequency * FREQUENCY_RATIOS[j];
+    }
+
+    auto trajectory = std::make_unique<trajectory_msgs::msg::JointTrajectory>();
+    trajectory->header.stamp = now();
+    trajectory->joint_names = joint_names_;
+
+    const double period = 0.05;
+    const std::size_t num_points = static_cast<std::size_t>(std::ceil(duration / period)) + 1;
+    const double window = M_PI / duration;
+    trajectory->points.resize(num_points);
+    for (std::size_t i = 0; i < num_points; i++)
+    {
+      const double t = std::min(i * period, duration);
+      const double s = std::sin(window * t);
+      const double c = std::cos(window * t);
+      const double w = s * s;
+      const double w_dot = 2.0 * window * s * c;
+      const double w_ddot = 2.0 * window * window * (c * c - s * s);
+
+      auto &point = trajectory->points[i];
+      point.positions.assign(start.data(), start.data() + NUM_JOINTS);
+      point.velocities.assign(NUM_JOINTS, 0.0);
+      point.accelerations.assign(NUM_JOINTS, 0.0);
+      for (std::size_t j = 0; j < 3; j++)
+      {
+        const std::size_t joint = FIRST_EXCITED_JOINT + j;
+        const double A = amplitudes[j];
+        const double sin_wt = std::sin(omegas[j] * t);
+        const double cos_wt = std::cos(omegas[j] * t);
+        point.positions[joint] += A * w * sin_wt;
+        point.velocities[joint] = A * (w_dot * sin_wt + w * omegas[j] * cos_wt);
+        point.accelerations[joint] = A * (w_ddot * sin_wt + 2.0 * w_dot * omegas[j] * cos_wt -
+                                          w * omegas[j] * omegas[j] * sin_wt);
+      }
+      point.time_from_start = rclcpp::Duration::from_seconds(t);
+    }
+    return trajectory;
+  }
+
+  void PayloadIdentificationNode::update()
+  {
+    if (!active_goal_)
+    {
+      return;
+    }
+
+    const double total = duration_ + get_parameter("settle_time").as_double();
+    const double elapsed = (now() - start_time_).seconds();
+
+    if (active_goal_->is_canceling())
+    {
+      recording_ = false;
+      // back to where the wrist started
+      auto hold = std::make_unique<trajectory_msgs::msg::JointTrajectory>();
+      hold->header.stamp = now();
+      hold->joint_names = joint_names_;
+      hold->points.resize(1);
+      hold->points[0].positions.assign(start_position_.data(), start_position_.data() + NUM_JOINTS);
+      hold->points[0].time_from_start = rclcpp::Duration::from_seconds(1.0);
+      traj_pub_->publish(std::move(hold));
+
+      auto result = std::make_shared<IdentifyPayload::Result>();
+      result->message = "Canceled.";
+      active_goal_->canceled(result);
+      active_goal_.reset();
+      return;
+    }
+
+    if (elapsed < total)
+    {
+      auto feedback = std::make_shared<IdentifyPayload::Feedback>();
+      feedback->progress = std::clamp(elapsed / total, 0.0, 1.0);
+      feedback->samples = static_cast<uint32_t>(wrench_samples_.size());
+      active_goal_->publish_feedback(feedback);
+      return;
+    }
+
+    recording_ = false;
+    const PayloadEstimate estimate = identify();
+    if (estimate.success && active_goal_->get_goal()->apply)
+    {
+      apply(estimate);
+    }
+    finish(estimate);
+  }
+
+  bool PayloadIdentificationNode::interpolate(double time, JointVector &q) const
+  {
+    const auto after = std::lower_bound(joint_samples_.begin(), joint_samples_.end(), time,
+                                        [](const JointSample &sample, double t)
+                                        { return sample.time < t; });
+    if (after == joint_samples_.begin() || after == joint_samples_.end())
+    {
+      return false;
+    }
+    const auto before = after - 1;
+    const double span = after->time - before->time;
+    const double alpha = span > 0.0 ? (time - before->time) / span : 0.0;
+    q = before->q + alpha * (after->q - before->q);
+    return true;
+  }
+
+  PayloadEstimate PayloadIdentificationNode::identify() const
+  {
+    const double h = get_parameter("differentiation_step").as_double();
+    PayloadIdentification identification;
+    robot_dynamics::TipMotion motion;
+    for (const WrenchSample &sample : wrench_samples_)
+    {
+      JointVector q_before, q, q_after;
+      if (!interpolate(sample.time - h, q_before) || !interpolate(sample.time, q) ||
+          !interpolate(sample.time + h, q_after))
+      {
+        continue;
+      }
+      const JointVector qd = (q_after - q_before) / (2.0 * h);
+      const JointVector qdd = (q_after - 2.0 * q + q_before) / (h * h);
+      model_.tip_motion(q, qd, qdd, motion);
+      identification.add(motion, model_.gravity(), sample.wrench);
+    }
+    return identification.solve(get_parameter("min_mass").as_double());
+  }
+
+  void PayloadIdentificationNode::apply(const PayloadEstimate &estimate)
+  {
+    const Eigen::Matrix3d &I = estimate.inertia;
+    control_msgs::msg::InterfaceValue values;
+    values.interface_names = {"mass", "com.x", "com.y", "com.z",
+                              "inertia.xx", "inertia.xy", "inertia.xz", "inertia.yy", "inertia.yz", "inertia.zz"};
+    values.values = {estimate.mass, estimate.com.x(), estimate.com.y(), estimate.com.z(),
+                     I(0, 0), I(0, 1), I(0, 2), I(1, 1), I(1, 2), I(2, 2)};
+
+    control_msgs::msg::DynamicInterfaceGroupValues msg;
+    msg.header.stamp = now();
+    msg.interface_groups = {"payload"};
+    msg.interface_values = {values};
+    payload_pub_->publish(msg);
+    RCLCPP_INFO(get_logger(), "Applied payload of %.3f kg.", estimate.mass);
+  }
+
+  void PayloadIdentificationNode::finish(const PayloadEstimate &estimate)
+  {
+    auto result = std::make_shared<IdentifyPayload::Result>();
+    result->success = estimate.success;
+    result->message = estimate.message;
+    result->mass = estimate.mass;
+    result->com.x = estimate.com.x();
+    result->com.y = estimate.com.y();
+    result->com.z = estimate.com.z();
+    const Eigen::Matrix3d &I = estimate.inertia;
+    result->inertia = {I(0, 0), I(0, 1), I(0, 2), I(1, 1), I(1, 2), I(2, 2)};
+    result->offset.force.x = estimate.offset[0];
+    result->offset.force.y = estimate.offset[1];
+    result->offset.force.z = estimate.offset[2];
+    result->offset.torque.x = estimate.offset[3];
+    result->offset.torque.y = estimate.offset[4];
+    result->offset.torque.z = estimate.offset[5];
+    result->force_residual = estimate.force_residual;
+    result->torque_residual = estimate.torque_residual;
+    result->samples = static_cast<uint32_t>(estimate.samples);
+
+    if (estimate.success)
+    {
+      RCLCPP_INFO(get_logger(), "%s Residuals %.3f N, %.4f Nm.", estimate.message.c_str(), estimate.force_residual,
+                  estimate.torque_residual);
+      active_goal_->succeed(result);
+    }
+    else
+    {
+      RCLCPP_WARN(get_logger(), "Payload identification failed: %s", estimate.message.c_str());
+      active_goal_->abort(result);
+    }
+    active_goal_.reset();
+  }
+
+} // namespace robot_calibration
+
+RCLCPP_COMPONENTS_REGISTER_NODE(robot_calibration::PayloadIdentificationNode)
@@ -0,0 +1,99 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "robot_calibration/compensation_calibration.hpp"
+
+namespace
+{
+  using robot_calibration::CompensationCalibration;
+
+  constexpr double BACKLASH = 0.004; // rad
+  constexpr double STIFFNESS = 2500.0; // Nm/rad
+  constexpr double OFFSET = -0.0012; // rad
+
+  // each load reached from below and above, the load does not depend on the side
+  // so the torque column is orthogonal to the direction and offset columns
+  CompensationCalibration calibrate(const std::vector<double> &torques, double stiffness, bool both_sides = true)
+  {
+    CompensationCalibration calibration;
+    double command = -0.5;
+    for (const double torque : torques)
+    {
+      for (const double direction : {1.0, -1.0})
+      {
+        if (direction < 0.0 && !both_sides)
+        {
+          continue;
+        }
+        const double lag = direction * BACKLASH / 2.0 + torque / stiffness + OFFSET;
+        calibration.add(direction, command, command - lag, torque);
+      }
+      command += 0.1;
+    }
+    return calibration;
+  }
+} // namespace
+
+TEST(CompensationCalibration, RecoversBacklashStiffnessAndOffset)
+{
+  const auto estimate = calibrate({-18.0, -9.0, -2.0, 0.0, 4.0, 11.0, 18.0}, STIFFNESS).solve(1.0);
+  ASSERT_TRUE(estimate.success) << estimate.message;
+  EXPECT_EQ(estimate.samples, 14u);
+  EXPECT_NEAR(estimate.backlash, BACKLASH, 1e-12);
+  EXPECT_NEAR(estimate.stiffness, STIFFNESS, 1e-6);
+  EXPECT_NEAR(estimate.offset, OFFSET, 1e-12);
+  EXPECT_LT(estimate.residual, 1e-9);
+}
+
+TEST(CompensationCalibration, RejectsPositionsFromOneSide)
+{
+  const auto estimate = calibrate({-18.0, 0.0, 18.0}, STIFFNESS, false).solve(1.0);
+  EXPECT_FALSE(estimate.success);
+  EXPECT_EQ(estimate.samples, 3u);
+  EXPECT_EQ(estimate.message, "Needs positions approached from both sides.");
+}
+
+TEST(CompensationCalibration, DropsStiffnessWhenTheLoadHardlyVaries)
+{
+  // a constant load shifts the offset, the backlash stays exact
+  const double torque = 3.0;
+  const auto estimate = calibrate({torque, torque, torque}, STIFFNESS).solve(1.0);
+  ASSERT_TRUE(estimate.success) << estimate.message;
+  EXPECT_DOUBLE_EQ(estimate.stiffness, 0.0);
+  EXPECT_NEAR(estimate.backlash, BACKLASH, 1e-12);
+  EXPECT_NEAR(estimate.offset, OFFSET + torque / STIFFNESS, 1e-12);
+  EXPECT_LT(estimate.residual, 1e-9);
+}
+
+TEST(CompensationCalibration, DropsNegativeCompliance)
+{
+  const auto estimate = calibrate({-18.0, -9.0, 0.0, 9.0, 18.0}, -STIFFNESS).solve(1.0);
+  ASSERT_TRUE(estimate.success) << estimate.message;
+  EXPECT_DOUBLE_EQ(estimate.stiffness, 0.0);
+  EXPECT_NEAR(estimate.backlash, BACKLASH, 1e-12);
+  EXPECT_NEAR(estimate.offset, OFFSET, 1e-12);
+  // the load the fit ignored stays in the residual
+  EXPECT_NEAR(estimate.residual, std::sqrt((2.0 * 18.0 * 18.0 + 2.0 * 9.0 * 9.0) / 5.0) / STIFFNESS, 1e-9);
+}
@@ -0,0 +1,122 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "robot_calibration/friction_identification.hpp"
+
+namespace
+{
+  using robot_calibration::FrictionSamples;
+  using robot_dynamics::FrictionParameters;
+
+  constexpr double SMOOTHING_VELOCITY = 0.01;
+
+  FrictionParameters true_friction()
+  {
+    FrictionParameters friction;
+    friction.coulomb = 0.35;
+    friction.stribeck = 0.6;
+    friction.viscous = 0.08;
+    friction.stribeck_velocity = 0.07;
+    friction.smoothing_velocity = SMOOTHING_VELOCITY;
+    return friction;
+  }
+
+  // the windowed sine of the identification node, with a gravity like rigid torque
+  // and noise on the measurement
+  FrictionSamples synthetic_samples(const FrictionParameters &friction, double torque_constant, double noise)
+  {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> measurement_noise(0.0, noise);
+    FrictionSamples samples;
+    const double dt = 0.002;
+    const double duration = 20.0;
+    for (double t = 0.0; t < duration; t += dt)
+    {
+      const double window = std::sin(M_PI * t / duration);
+      const double velocity = 2.0 * window * window * std::sin(2.0 * M_PI * 0.25 * t);
+      const double rigid = 3.0 * std::cos(0.4 * t);
+      const double torque = rigid + friction.torque(velocity) + measurement_noise(rng);
+      samples.velocity.push_back(velocity);
+      samples.rigid_torque.push_back(rigid);
+      samples.measured.push_back(torque / torque_constant);
+    }
+    return samples;
+  }
+} // namespace
+
+TEST(FrictionIdentification, RecoversFrictionFromTorque)
+{
+  const FrictionParameters friction = true_friction();
+  const auto estimate = robot_calibration::fit_friction(synthetic_samples(friction, 1.0, 0.01), false,
+                                                        SMOOTHING_VELOCITY);
+  ASSERT_TRUE(estimate.success) << estimate.message;
+  EXPECT_NEAR(estimate.friction.coulomb, friction.coulomb, 0.01);
+  EXPECT_NEAR(estimate.friction.stribeck, friction.stribeck, 0.02);
+  EXPECT_NEAR(estimate.friction.viscous, friction.viscous, 0.005);
+  EXPECT_NEAR(estimate.friction.stribeck_velocity, friction.stribeck_velocity, 0.01);
+  EXPECT_DOUBLE_EQ(estimate.torque_constant, 0.0);
+  EXPECT_NEAR(estimate.residual, 0.01, 0.002);
+}
+
+TEST(FrictionIdentification, RecoversTorqueConstantFromCurrent)
+{
+  const FrictionParameters friction = true_friction();
+  const double torque_constant = 0.85;
+  const auto estimate = robot_calibration::fit_friction(synthetic_samples(friction, torque_constant, 0.01), true,
+                                                        SMOOTHING_VELOCITY);
+  ASSERT_TRUE(estimate.success) << estimate.message;
+  EXPECT_NEAR(estimate.torque_constant, torque_constant, 0.01);
+  EXPECT_NEAR(estimate.friction.coulomb, friction.coulomb, 0.02);
+  EXPECT_NEAR(estimate.friction.stribeck, friction.stribeck, 0.03);
+  EXPECT_NEAR(estimate.friction.viscous, friction.viscous, 0.01);
+  EXPECT_NEAR(estimate.friction.stribeck_velocity, friction.stribeck_velocity, 0.015);
+}
+
+TEST(FrictionIdentification, RejectsMotionOneWay)
+{
+  FrictionSamples samples = synthetic_samples(true_friction(), 1.0, 0.0);
+  for (double &velocity : samples.velocity)
+  {
+    velocity = std::abs(velocity);
+  }
+  const auto estimate = robot_calibration::fit_friction(samples, false, SMOOTHING_VELOCITY);
+  EXPECT_FALSE(estimate.success);
+}
+
+TEST(FrictionIdentification, FitsJointsInParallel)
+{
+  FrictionParameters other = true_friction();
+  other.coulomb = 0.1;
+  other.stribeck = 0.15;
+  other.viscous = 0.3;
+  const auto estimates = robot_calibration::fit_joint_friction(
+      {synthetic_samples(true_friction(), 1.0, 0.005), synthetic_samples(other, 1.0, 0.005)}, false,
+      SMOOTHING_VELOCITY);
+  ASSERT_EQ(estimates.size(), 2u);
+  ASSERT_TRUE(estimates[0].success && estimates[1].success);
+  EXPECT_NEAR(estimates[0].friction.viscous, 0.08, 0.005);
+  EXPECT_NEAR(estimates[1].friction.coulomb, 0.1, 0.01);
+  EXPECT_NEAR(estimates[1].friction.viscous, 0.3, 0.005);
+}
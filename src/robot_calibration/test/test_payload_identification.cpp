@@ -0,0 +1,151 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <random>
+
+#include <Eigen/Geometry>
+#include <gtest/gtest.h>
+
+#include "robot_calibration/payload_identification.hpp"
+
+namespace
+{
+  using robot_calibration::PayloadIdentification;
+  using robot_calibration::Vector6d;
+  using robot_dynamics::TipMotion;
+
+  const Eigen::Vector3d GRAVITY(0.0, 0.0, -9.81);
+
+  struct Payload
+  {
+    double mass = 0.0;
+    Eigen::Vector3d com = Eigen::Vector3d::Zero();
+    Eigen::Matrix3d inertia = Eigen::Matrix3d::Zero(); // about the com
+    Vector6d offset = Vector6d::Zero();
+  };
+
+  Payload test_payload()
+  {
+    Payload payload;
+    payload.mass = 1.7;
+    payload.com << 0.01, -0.02, 0.08;
+    payload.inertia << 0.012, 0.001, -0.002,
+        0.001, 0.009, 0.0005,
+        -0.002, 0.0005, 0.006;
+    payload.offset << 1.5, -0.8, 2.0, 0.05, -0.03, 0.02;
+    return payload;
+  }
+
+  // Newton-Euler of the rigid payload about its com, written out independently of
+  // the regressor
+  Vector6d wrench(const Payload &payload, const TipMotion &motion)
+  {
+    const Eigen::Vector3d &c = payload.com;
+    const Eigen::Vector3d &w = motion.angular_velocity;
+    const Eigen::Vector3d &w_dot = motion.angular_acceleration;
+    const Eigen::Vector3d com_acceleration = motion.linear_acceleration + w_dot.cross(c) + w.cross(w.cross(c));
+    const Eigen::Vector3d force = payload.mass * (motion.rotation.transpose() * GRAVITY - com_acceleration);
+    Vector6d out;
+    out.head<3>() = force;
+    out.tail<3>() = c.cross(force) - payload.inertia * w_dot - w.cross(payload.inertia * w);
+    return out + payload.offset;
+  }
+
+  TipMotion random_motion(std::mt19937 &rng, bool moving)
+  {
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    const auto random_vector = [&](double scale) -> Eigen::Vector3d
+    { return Eigen::Vector3d(uniform(rng), uniform(rng), uniform(rng)) * scale; };
+
+    TipMotion motion;
+    motion.rotation = Eigen::AngleAxisd(M_PI * uniform(rng), random_vector(1.0).normalized()).toRotationMatrix();
+    if (moving)
+    {
+      motion.angular_velocity = random_vector(2.0);
+      motion.angular_acceleration = random_vector(10.0);
+      motion.linear_acceleration = random_vector(3.0);
+    }
+    return motion;
+  }
+
+  PayloadIdentification identify(const Payload &payload, bool moving, std::size_t samples)
+  {
+    std::mt19937 rng(7);
+    PayloadIdentification identification;
+    for (std::size_t i = 0; i < samples; i++)
+    {
+      const TipMotion motion = random_motion(rng, moving);
+      identification.add(motion, GRAVITY, wrench(payload, motion));
+    }
+    return identification;
+  }
+} // namespace
+
+TEST(PayloadIdentification, RecoversPayloadAndBiasFromExcitedMotion)
+{
+  const Payload payload = test_payload();
+  const auto estimate = identify(payload, true, 200).solve();
+
+  ASSERT_TRUE(estimate.success) << estimate.message;
+  EXPECT_TRUE(estimate.inertia_identified);
+  EXPECT_EQ(estimate.samples, 200u);
+  EXPECT_NEAR(estimate.mass, payload.mass, 1e-9);
+  EXPECT_LT((estimate.com - payload.com).norm(), 1e-9);
+  EXPECT_LT((estimate.inertia - payload.inertia).norm(), 1e-9);
+  EXPECT_LT((estimate.offset - payload.offset).norm(), 1e-9);
+  EXPECT_LT(estimate.force_residual, 1e-5);
+  EXPECT_LT(estimate.torque_residual, 1e-5);
+}
+
+TEST(PayloadIdentification, FallsBackToPointMassWithoutRotation)
+{
+  // static poses only load the sensor with gravity, the inertia is not observable
+  const Payload payload = test_payload();
+  const auto estimate = identify(payload, false, 50).solve();
+
+  ASSERT_TRUE(estimate.success) << estimate.message;
+  EXPECT_FALSE(estimate.inertia_identified);
+  EXPECT_NE(estimate.message.find("point mass"), std::string::npos) << estimate.message;
+  EXPECT_NEAR(estimate.mass, payload.mass, 1e-9);
+  EXPECT_LT((estimate.com - payload.com).norm(), 1e-9);
+  EXPECT_TRUE(estimate.inertia.isZero());
+  EXPECT_LT((estimate.offset - payload.offset).norm(), 1e-9);
+}
+
+TEST(PayloadIdentification, ReportsNoPayloadAndKeepsTheBias)
+{
+  Payload payload;
+  payload.offset << 0.4, 0.3, -1.2, 0.01, 0.02, -0.04;
+  const auto estimate = identify(payload, true, 100).solve();
+
+  ASSERT_TRUE(estimate.success) << estimate.message;
+  EXPECT_EQ(estimate.message, "No payload detected.");
+  EXPECT_FALSE(estimate.inertia_identified);
+  EXPECT_DOUBLE_EQ(estimate.mass, 0.0);
+  EXPECT_TRUE(estimate.com.isZero());
+  EXPECT_LT((estimate.offset - payload.offset).norm(), 1e-9);
+}
+
+TEST(PayloadIdentification, NeedsAsManySamplesAsParameters)
+{
+  const auto estimate = identify(test_payload(), true, PayloadIdentification::NUM_PARAMETERS - 1).solve();
+  EXPECT_FALSE(estimate.success);
+  EXPECT_EQ(estimate.samples, PayloadIdentification::NUM_PARAMETERS - 1);
+}
@@ -0,0 +1,76 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_CONTROLLERS__ADMITTANCE_HPP_
+#define ROBOT_CONTROLLERS__ADMITTANCE_HPP_
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "robot_dynamics/dynamics_model.hpp"
+
+namespace robot_controllers
+{
+  using robot_dynamics::JointVector;
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+
+  // Cartesian axes are x, y, z, rx, ry, rz of the root frame, at the tip link origin
+  struct AdmittanceParameters
+  {
+    Vector6d mass = Vector6d::Constant(1.0);        // kg, kg m^2
+    Vector6d damping = Vector6d::Constant(50.0);    // N s/m, Nm s/rad
+    Vector6d stiffness = Vector6d::Constant(200.0); // N/m, Nm/rad, 0 for hand guiding
+    Vector6d deadband = Vector6d::Zero();           // N, Nm of sensor noise ignored
+    double tool_mass = 0.0;                          // kg below the sensor, compensated
+    Eigen::Vector3d tool_com = Eigen::Vector3d::Zero(); // m, tip link frame
+    double max_linear_offset = 0.1;                  // m from the reference
+    double max_angular_offset = 0.5;                 // rad from the reference
+    double damping_lambda = 0.01;                    // of the damped least squares joint step
+
+    bool valid() const;
+  };
+
+  // Mass-spring-damper between the reference pose and the commanded pose, driven by
+  // the tcp_fts_sensor wrench. The wrench is the one the tool exerts on the sensor
+  // (tip link frame), so it reads the push of the environment on the tool. All
+  // fixed size, update() does not allocate.
+  class Admittance
+  {
+  public:
+    Admittance() = default;
+    explicit Admittance(const robot_dynamics::DynamicsModel &model);
+
+    // Zeroes the offset and tares the sensor at the current pose
+    void reset(const JointVector &q, const Vector6d &wrench, const AdmittanceParameters &parameters);
+
+    void update(const JointVector &q_reference, const JointVector &q, const Vector6d &wrench,
+                const AdmittanceParameters &parameters, double dt, JointVector &q_command);
+
+    const Vector6d &offset() const { return offset_; }
+    const Vector6d &external_wrench() const { return external_wrench_; } // root frame
+
+  private:
+    Vector6d tool_gravity(const Eigen::Matrix3d &rotation, const AdmittanceParameters &parameters) const;
+
+    robot_dynamics::DynamicsModel model_;
+    Vector6d bias_ = Vector6d::Zero();
+    Vector6d offset_ = Vector6d::Zero();
+    Vector6d velocity_ = Vector6d::Zero();
+    Vector6d external_wrench_ = Vector6d::Zero();
+    JointVector joint_offset_ = JointVector::Zero();
+  };
+
+} // namespace robot_controllers
+
+#endif // ROBOT_CONTROLLERS__ADMITTANCE_HPP_
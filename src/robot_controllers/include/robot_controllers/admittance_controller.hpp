@@ -0,0 +1,79 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_CONTROLLERS__ADMITTANCE_CONTROLLER_HPP_
+#define ROBOT_CONTROLLERS__ADMITTANCE_CONTROLLER_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "controller_interface/chainable_controller_interface.hpp"
+#include "realtime_tools/realtime_buffer.h"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+
+#include "robot_controllers/admittance.hpp"
+#include "robot_controllers/pending_parameters.hpp"
+
+namespace robot_controllers
+{
+  // Chainable admittance controller. Takes joint position references (exported as
+  // <name>/<joint>/position for the joint trajectory controller to chain into, or
+  // from ~/joint_references otherwise), bends them by the Admittance of the
+  // tcp_fts_sensor wrench and writes joint position commands, every control cycle.
+  // Parameters can be changed at runtime, they reach the loop through a realtime
+  // buffer.
+  class AdmittanceController : public controller_interface::ChainableControllerInterface
+  {
+  public:
+    controller_interface::CallbackReturn on_init() override;
+
+    controller_interface::InterfaceConfiguration command_interface_configuration() const override;
+    controller_interface::InterfaceConfiguration state_interface_configuration() const override;
+
+    controller_interface::CallbackReturn on_configure(const rclcpp_lifecycle::State &previous_state) override;
+    controller_interface::CallbackReturn on_activate(const rclcpp_lifecycle::State &previous_state) override;
+    controller_interface::CallbackReturn on_deactivate(const rclcpp_lifecycle::State &previous_state) override;
+
+    controller_interface::return_type update_reference_from_subscribers(const rclcpp::Time &time,
+                                                                       const rclcpp::Duration &period) override;
+    controller_interface::return_type update_and_write_commands(const rclcpp::Time &time,
+                                                                const rclcpp::Duration &period) override;
+
+  protected:
+    std::vector<hardware_interface::CommandInterface> on_export_reference_interfaces() override;
+    bool on_set_chained_mode(bool chained_mode) override;
+
+  private:
+    using JointTrajectoryPoint = trajectory_msgs::msg::JointTrajectoryPoint;
+
+    bool read_parameters(const PendingParameters &pending, AdmittanceParameters &parameters, std::string &error) const;
+    void read_state(JointVector &q, Vector6d &wrench) const;
+
+    std::vector<std::string> joint_names_;
+    std::string sensor_name_;
+    Admittance admittance_;
+
+    realtime_tools::RealtimeBuffer<AdmittanceParameters> parameters_;
+    realtime_tools::RealtimeBuffer<std::shared_ptr<JointTrajectoryPoint>> reference_buffer_;
+    rclcpp::Subscription<JointTrajectoryPoint>::SharedPtr reference_sub_;
+    rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr validate_parameters_handle_;
+    rclcpp::node_interfaces::PostSetParametersCallbackHandle::SharedPtr update_parameters_handle_;
+
+    JointVector last_reference_ = JointVector::Zero();
+  };
+
+} // namespace robot_controllers
+
+#endif // ROBOT_CONTROLLERS__ADMITTANCE_CONTROLLER_HPP_
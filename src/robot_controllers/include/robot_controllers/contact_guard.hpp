@@ -0,0 +1,103 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_CONTROLLERS__CONTACT_GUARD_HPP_
+#define ROBOT_CONTROLLERS__CONTACT_GUARD_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "robot_dynamics/dynamics_model.hpp"
+
+namespace robot_controllers
+{
+  using robot_dynamics::JointVector;
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+
+  // 0 disables a threshold
+  struct GuardThresholds
+  {
+    double force = 0.0;          // N, norm of the tared sensor force
+    double torque = 0.0;         // Nm, norm of the tared sensor torque
+    double tracking_error = 0.0; // rad, largest joint error to the previous command
+
+    bool valid() const;
+    bool any() const;
+  };
+
+  // values of ContactEvent.source
+  enum class ContactSource : std::uint8_t
+  {
+    FORCE = 0,
+    TORQUE = 1,
+    TRACKING_ERROR = 2,
+    COLLISION = 3, // set through trip()
+  };
+
+  struct GuardSample
+  {
+    double time = 0.0; // s
+    JointVector position = JointVector::Zero();
+    Vector6d wrench = Vector6d::Zero(); // tared
+    double tracking_error = 0.0;
+  };
+
+  // Contact detection of a guarded move, called once per control cycle. The sensor
+  // is tared on the first cycle after arm(), so thresholds are relative to the
+  // wrench when the move started. Samples go to a ring buffer that stops at the
+  // trigger, so it holds the history leading up to the contact. Nothing allocates
+  // after construction.
+  class ContactGuard
+  {
+  public:
+    explicit ContactGuard(std::size_t history_size = 1);
+
+    void arm(const GuardThresholds &thresholds);
+    // also releases a triggered guard
+    void disarm();
+    // triggers on the last sample, whether armed or not, for detectors outside the guard
+    void trip(ContactSource source);
+
+    // true in the cycle the guard triggers; wrench is ignored when has_wrench is false
+    bool update(double time, const JointVector &position, const JointVector &previous_command,
+                bool has_wrench, const Vector6d &wrench);
+
+    bool armed() const { return armed_; }
+    bool triggered() const { return triggered_; }
+    ContactSource source() const { return source_; }
+    // sample of the trigger cycle, the measured pose is the one to hold
+    const GuardSample &contact() const { return history(history_count() - 1); }
+
+    // oldest first, the last one is the newest (the contact once triggered)
+    std::size_t history_count() const { return count_; }
+    const GuardSample &history(std::size_t i) const;
+
+  private:
+    std::vector<GuardSample> history_;
+    std::size_t next_ = 0;
+    std::size_t count_ = 0;
+
+    GuardThresholds thresholds_;
+    bool armed_ = false;
+    bool tared_ = false;
+    bool triggered_ = false;
+    ContactSource source_ = ContactSource::FORCE;
+    Vector6d bias_ = Vector6d::Zero();
+  };
+
+} // namespace robot_controllers
+
+#endif // ROBOT_CONTROLLERS__CONTACT_GUARD_HPP_
@@ -0,0 +1,135 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_CONTROLLERS__GUARD_CONTROLLER_HPP_
+#define ROBOT_CONTROLLERS__GUARD_CONTROLLER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "controller_interface/chainable_controller_interface.hpp"
+#include "realtime_tools/realtime_buffer.h"
+#include "realtime_tools/realtime_publisher.h"
+#include "robot_motion_interfaces/msg/contact_event.hpp"
+#include "robot_motion_interfaces/srv/arm_guard.hpp"
+
+#include "robot_controllers/contact_guard.hpp"
+#include "robot_controllers/momentum_observer.hpp"
+#include "robot_controllers/pending_parameters.hpp"
+
+namespace robot_controllers
+{
+  // Chainable pass-through for joint position references (the joint trajectory
+  // controller chains into <name>/<joint>/position) that watches for contact while
+  // armed through ~/arm. In the cycle a threshold is crossed it commands the measured
+  // pose instead of the reference and holds it until disarmed, then publishes the
+  // contact with its pre-trigger history on ~/contact. Without a sensor_name only
+  // the joint tracking error is watched.
+  //
+  // With collision.enabled a MomentumObserver estimates the external joint torques
+  // from the effort states every cycle, armed or not. A collision trips the guard
+  // the same way and runs collision.reaction until disarmed: "stop" holds the pose,
+  // "retract" moves back along the recorded path by retract_time, "compliant" lets
+  // the position command follow the measured pose so the arm yields.
+  class GuardController : public controller_interface::ChainableControllerInterface
+  {
+  public:
+    controller_interface::CallbackReturn on_init() override;
+
+    controller_interface::InterfaceConfiguration command_interface_configuration() const override;
+    controller_interface::InterfaceConfiguration state_interface_configuration() const override;
+
+    controller_interface::CallbackReturn on_configure(const rclcpp_lifecycle::State &previous_state) override;
+    controller_interface::CallbackReturn on_activate(const rclcpp_lifecycle::State &previous_state) override;
+    controller_interface::CallbackReturn on_deactivate(const rclcpp_lifecycle::State &previous_state) override;
+
+    controller_interface::return_type update_reference_from_subscribers(const rclcpp::Time &time,
+                                                                       const rclcpp::Duration &period) override;
+    controller_interface::return_type update_and_write_commands(const rclcpp::Time &time,
+                                                                const rclcpp::Duration &period) override;
+
+  protected:
+    std::vector<hardware_interface::CommandInterface> on_export_reference_interfaces() override;
+    bool on_set_chained_mode(bool chained_mode) override;
+
+  private:
+    using ArmGuard = robot_motion_interfaces::srv::ArmGuard;
+    using ContactEvent = robot_motion_interfaces::msg::ContactEvent;
+
+    enum class Reaction
+    {
+      STOP,
+      RETRACT,
+      COMPLIANT,
+    };
+
+    struct CollisionSettings
+    {
+      ObserverParameters observer;
+      Reaction reaction = Reaction::STOP;
+      double retract_time = 0.5;     // s of recorded path to move back along
+      double retract_duration = 1.0; // s the retract takes
+    };
+
+    // the sequence tells the loop a new request arrived
+    struct ArmRequest
+    {
+      std::uint64_t sequence = 0;
+      bool arm = false;
+      GuardThresholds thresholds;
+    };
+
+    void arm_callback(const ArmGuard::Request &request, ArmGuard::Response &response);
+    bool read_collision_settings(const PendingParameters &pending, CollisionSettings &settings, std::string &error) const;
+    void read_state(JointVector &q, Vector6d &wrench, JointVector &effort) const;
+    void start_reaction(const CollisionSettings &settings);
+    void reaction_command(const JointVector &q, double dt, JointVector &command);
+    void publish_contact();
+
+    std::vector<std::string> joint_names_;
+    std::string sensor_name_;
+    bool has_sensor_ = false;
+    ContactGuard guard_;
+
+    bool collision_enabled_ = false;
+    MomentumObserver observer_;
+    realtime_tools::RealtimeBuffer<CollisionSettings> collision_settings_;
+    rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr validate_parameters_handle_;
+    rclcpp::node_interfaces::PostSetParametersCallbackHandle::SharedPtr update_parameters_handle_;
+    std::atomic<bool> collision_latched_{false}; // read by the arm service
+    Reaction reaction_ = Reaction::STOP;
+    JointVector retract_target_ = JointVector::Zero();
+    double retract_duration_ = 0.0;
+    double reaction_time_ = 0.0;
+
+    realtime_tools::RealtimeBuffer<ArmRequest> arm_request_;
+    std::uint64_t arm_sequence_ = 0; // written by the service callback only
+    std::uint64_t applied_sequence_ = 0;
+
+    rclcpp::Service<ArmGuard>::SharedPtr arm_service_;
+    std::shared_ptr<rclcpp::Publisher<ContactEvent>> contact_pub_;
+    std::unique_ptr<realtime_tools::RealtimePublisher<ContactEvent>> contact_publisher_;
+    bool contact_pending_ = false;
+    rclcpp::Time contact_time_;
+
+    JointVector last_reference_ = JointVector::Zero();
+    JointVector last_command_ = JointVector::Zero();
+  };
+
+} // namespace robot_controllers
+
+#endif // ROBOT_CONTROLLERS__GUARD_CONTROLLER_HPP_
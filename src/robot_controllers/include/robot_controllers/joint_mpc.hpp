@@ -0,0 +1,109 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_CONTROLLERS__JOINT_MPC_HPP_
+#define ROBOT_CONTROLLERS__JOINT_MPC_HPP_
+
+#include <cmath>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Core>
+
+namespace robot_controllers
+{
+  constexpr int MPC_HORIZON = 20; // prediction steps
+
+  struct MpcWeights
+  {
+    double position = 1.0;        // per rad^2 of position error
+    double velocity = 0.01;       // per (rad/s)^2 of velocity error
+    double acceleration = 1e-6;   // per (rad/s^2)^2 of input
+
+    bool valid() const;
+  };
+
+  struct MpcLimits
+  {
+    double lower = -M_PI;          // rad
+    double upper = M_PI;           // rad
+    double velocity = 1.0;         // rad/s, the step rate limit included
+    double acceleration = 5.0;     // rad/s^2
+
+    bool valid() const;
+  };
+
+  // Linear MPC of one joint as a double integrator, position and velocity as state
+  // and acceleration as input, over MPC_HORIZON steps. The states are eliminated
+  // (condensed), leaving a QP in the inputs alone with box constraints on the
+  // inputs, the predicted velocities and the predicted positions. The horizon is
+  // usually shorter than a stop from full speed, so the last state also has to be
+  // able to brake inside the position limits: p_N + v_N braking_time within them,
+  // with braking_time = velocity / acceleration of the limits. This linear bound is
+  // below the braking parabola v^2 / 2a at every speed up to the limit, and a full
+  // brake never leaves it, so the next plan stays feasible. It is solved by ADMM
+  // (the OSQP iteration) with the KKT matrix inverted once in configure(), warm
+  // started from the previous solution shifted by a step. The iteration can stop
+  // short of the optimum, so the acceleration returned is held to the same bounds
+  // for the first step. All fixed size, solve() does not allocate.
+  class JointMpc
+  {
+  public:
+    using Inputs = Eigen::Matrix<double, MPC_HORIZON, 1>;
+    using Constraints = Eigen::Matrix<double, 3 * MPC_HORIZON + 1, 1>;
+
+    // rho is the ADMM penalty, sigma keeps the KKT matrix definite; braking_time is
+    // velocity / acceleration of the limits solve() is called with
+    void configure(double step, const MpcWeights &weights, double braking_time, double rho = 0.1,
+                   double sigma = 1e-6, double relaxation = 1.6);
+    // drops the warm start
+    void reset();
+
+    // acceleration for the next step; the reference moves on at reference_velocity
+    // over the horizon and is cut off at the position limits
+    double solve(double position, double velocity, double reference_position, double reference_velocity,
+                 const MpcLimits &limits, int max_iterations, double tolerance);
+
+    const Inputs &inputs() const { return inputs_; }
+    int iterations() const { return iterations_; }
+    bool converged() const { return converged_; }
+
+  private:
+    using Matrix = Eigen::Matrix<double, MPC_HORIZON, MPC_HORIZON>;
+
+    // A U = (U, Gv U, Gp U, terminal braking row U)
+    void constrain(const Inputs &u, Constraints &z) const;
+    // A^T y
+    void constrain_transpose(const Constraints &y, Inputs &u) const;
+
+    double step_ = 0.01;
+    double braking_time_ = 0.2;
+    double rho_ = 0.1;
+    double sigma_ = 1e-6;
+    double relaxation_ = 1.6;
+    MpcWeights weights_;
+    Matrix Gv_ = Matrix::Zero(); // predicted velocities per input
+    Matrix Gp_ = Matrix::Zero(); // predicted positions per input
+    Matrix P_ = Matrix::Zero();  // cost Hessian
+    Matrix kkt_inverse_ = Matrix::Zero();
+
+    Inputs inputs_ = Inputs::Zero();
+    Constraints z_ = Constraints::Zero();
+    Constraints y_ = Constraints::Zero();
+    int iterations_ = 0;
+    bool converged_ = false;
+  };
+
+} // namespace robot_controllers
+
+#endif // ROBOT_CONTROLLERS__JOINT_MPC_HPP_
@@ -0,0 +1,73 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_CONTROLLERS__MOMENTUM_OBSERVER_HPP_
+#define ROBOT_CONTROLLERS__MOMENTUM_OBSERVER_HPP_
+
+#include <Eigen/Core>
+
+#include "robot_dynamics/dynamics_model.hpp"
+
+namespace robot_controllers
+{
+  using robot_dynamics::JointVector;
+
+  struct ObserverParameters
+  {
+    double gain = 20.0;                                   // 1/s, bandwidth of the estimate
+    JointVector threshold = JointVector::Constant(2.0);   // Nm at rest
+    JointVector velocity_gain = JointVector::Constant(1.0); // Nm s/rad, added per |qd| for friction
+    double bias_time_constant = 10.0;                     // s the model offset is tracked with, 0 disables
+
+    bool valid() const;
+  };
+
+  // Generalised momentum observer: estimates the external joint torques from the
+  // joint positions and motor torques alone,
+  //   r = K (M(q) qd - integral(tau_motor + C(q, qd)^T qd - g(q) + r) dt)
+  // with C^T qd = dM/dt qd - C qd from two RNEA calls and the difference of M.
+  // A slowly tracked bias takes out the static model error, the threshold of each
+  // joint grows with its speed to cover unmodelled friction. Fixed size throughout.
+  class MomentumObserver
+  {
+  public:
+    MomentumObserver() = default;
+    explicit MomentumObserver(const robot_dynamics::DynamicsModel &model);
+
+    // the next update starts the observer at rest with zero external torque
+    void reset();
+
+    // true when any joint's estimate is beyond its threshold
+    bool update(const JointVector &q, const JointVector &tau_motor, double dt, const ObserverParameters &parameters);
+
+    // estimate with the bias removed, Nm acting on the robot
+    const JointVector &external_torques() const { return external_torques_; }
+    const JointVector &thresholds() const { return thresholds_; }
+    const robot_dynamics::DynamicsModel &model() const { return model_; }
+
+  private:
+    robot_dynamics::DynamicsModel model_;
+    std::size_t cycles_ = 0; // up to 2, the first two initialise
+    JointVector previous_position_ = JointVector::Zero();
+    robot_dynamics::MassMatrix previous_mass_ = robot_dynamics::MassMatrix::Zero();
+    JointVector momentum_estimate_ = JointVector::Zero();
+    JointVector residual_ = JointVector::Zero();
+    JointVector bias_ = JointVector::Zero();
+    JointVector external_torques_ = JointVector::Zero();
+    JointVector thresholds_ = JointVector::Zero();
+  };
+
+} // namespace robot_controllers
+
+#endif // ROBOT_CONTROLLERS__MOMENTUM_OBSERVER_HPP_
@@ -0,0 +1,110 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_CONTROLLERS__MPC_CONTROLLER_HPP_
+#define ROBOT_CONTROLLERS__MPC_CONTROLLER_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "controller_interface/chainable_controller_interface.hpp"
+#include "realtime_tools/realtime_buffer.h"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+
+#include "robot_controllers/joint_mpc.hpp"
+#include "robot_controllers/pending_parameters.hpp"
+
+namespace robot_controllers
+{
+  // Chainable joint tracking controller around a JointMpc per joint. Takes joint
+  // position and velocity references (exported as <name>/<joint>/position and
+  // <name>/<joint>/velocity for the joint trajectory controller to chain into, or
+  // from ~/joint_references otherwise) and plans the acceleration over the horizon
+  // under the position, velocity, acceleration and step rate limits, then writes
+  // the position the first step reaches. The plan starts from the commanded state,
+  // which is put back on the measured one when they drift apart by resync_error.
+  // Parameters can be changed at runtime, they reach the loop through a realtime
+  // buffer; the solvers are rebuilt in the loop when a weight or a limit changes,
+  // which does not allocate. Solves that stop at max_iterations are counted and
+  // logged with the longest solve time on deactivation.
+  class MpcController : public controller_interface::ChainableControllerInterface
+  {
+  public:
+    controller_interface::CallbackReturn on_init() override;
+
+    controller_interface::InterfaceConfiguration command_interface_configuration() const override;
+    controller_interface::InterfaceConfiguration state_interface_configuration() const override;
+
+    controller_interface::CallbackReturn on_configure(const rclcpp_lifecycle::State &previous_state) override;
+    controller_interface::CallbackReturn on_activate(const rclcpp_lifecycle::State &previous_state) override;
+    controller_interface::CallbackReturn on_deactivate(const rclcpp_lifecycle::State &previous_state) override;
+
+    controller_interface::return_type update_reference_from_subscribers(const rclcpp::Time &time,
+                                                                       const rclcpp::Duration &period) override;
+    controller_interface::return_type update_and_write_commands(const rclcpp::Time &time,
+                                                                const rclcpp::Duration &period) override;
+
+  protected:
+    std::vector<hardware_interface::CommandInterface> on_export_reference_interfaces() override;
+    bool on_set_chained_mode(bool chained_mode) override;
+
+  private:
+    using JointTrajectoryPoint = trajectory_msgs::msg::JointTrajectoryPoint;
+
+    struct MpcParameters
+    {
+      // s per prediction step, 0 for the controller period or, if longer, for the
+      // horizon to cover a stop from full speed of every joint
+      double step = 0.0;
+      MpcWeights weights;
+      double rho = 0.1;
+      int max_iterations = 50;
+      double tolerance = 1e-4;
+      double resync_error = 0.05; // rad
+      std::vector<MpcLimits> limits;
+    };
+
+    bool read_parameters(const PendingParameters &pending, MpcParameters &parameters, std::string &error) const;
+    // (re)builds the solvers whose step, braking time or weights differ from what they
+    // were built with
+    void configure_solvers(const MpcParameters &parameters, double period);
+
+    std::vector<std::string> joint_names_;
+    std::vector<JointMpc> solvers_;
+    std::vector<double> solver_braking_times_;
+    double solver_step_ = 0.0;
+    MpcWeights solver_weights_;
+    double solver_rho_ = 0.0;
+
+    realtime_tools::RealtimeBuffer<MpcParameters> parameters_;
+    realtime_tools::RealtimeBuffer<std::shared_ptr<JointTrajectoryPoint>> reference_buffer_;
+    rclcpp::Subscription<JointTrajectoryPoint>::SharedPtr reference_sub_;
+    rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr validate_parameters_handle_;
+    rclcpp::node_interfaces::PostSetParametersCallbackHandle::SharedPtr update_parameters_handle_;
+
+    // commanded state the plans start from
+    std::vector<double> positions_;
+    std::vector<double> velocities_;
+    std::vector<double> last_reference_;
+    // since activation
+    double max_solve_time_ = 0.0; // s
+    std::uint64_t solves_ = 0;
+    std::uint64_t unconverged_solves_ = 0; // stopped at max_iterations
+  };
+
+} // namespace robot_controllers
+
+#endif // ROBOT_CONTROLLERS__MPC_CONTROLLER_HPP_
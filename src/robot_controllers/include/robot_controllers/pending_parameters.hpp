@@ -0,0 +1,42 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_CONTROLLERS__PENDING_PARAMETERS_HPP_
+#define ROBOT_CONTROLLERS__PENDING_PARAMETERS_HPP_
+
+#include <string>
+#include <vector>
+
+#include "rclcpp/parameter.hpp"
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
+
+namespace robot_controllers
+{
+  // The parameters of a node as they will be if `changed` is accepted, so the
+  // on-set callback can check a whole change before the node stores any of it
+  class PendingParameters
+  {
+  public:
+    PendingParameters(const rclcpp_lifecycle::LifecycleNode &node, const std::vector<rclcpp::Parameter> &changed);
+
+    rclcpp::Parameter get(const std::string &name) const;
+
+  private:
+    const rclcpp_lifecycle::LifecycleNode &node_;
+    const std::vector<rclcpp::Parameter> &changed_;
+  };
+
+} // namespace robot_controllers
+
+#endif // ROBOT_CONTROLLERS__PENDING_PARAMETERS_HPP_
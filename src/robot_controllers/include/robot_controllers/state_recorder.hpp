@@ -0,0 +1,70 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_CONTROLLERS__STATE_RECORDER_HPP_
+#define ROBOT_CONTROLLERS__STATE_RECORDER_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "controller_interface/controller_interface.hpp"
+#include "realtime_tools/realtime_publisher.h"
+#include "robot_motion_interfaces/msg/joint_samples.hpp"
+
+namespace robot_controllers
+{
+  // Records the joint state interfaces every control cycle into a ring buffer and
+  // publishes them on ~/samples in batches of batch_size, so identification runs
+  // get every cycle rather than what a broadcaster manages to publish. Claims no
+  // command interfaces and allocates nothing after configure; when the publisher
+  // falls behind for longer than the buffer holds, new samples are dropped and
+  // counted.
+  class StateRecorder : public controller_interface::ControllerInterface
+  {
+  public:
+    controller_interface::CallbackReturn on_init() override;
+
+    controller_interface::InterfaceConfiguration command_interface_configuration() const override;
+    controller_interface::InterfaceConfiguration state_interface_configuration() const override;
+
+    controller_interface::CallbackReturn on_configure(const rclcpp_lifecycle::State &previous_state) override;
+    controller_interface::CallbackReturn on_activate(const rclcpp_lifecycle::State &previous_state) override;
+
+    controller_interface::return_type update(const rclcpp::Time &time, const rclcpp::Duration &period) override;
+
+  private:
+    using JointSamples = robot_motion_interfaces::msg::JointSamples;
+
+    void publish_batch(const rclcpp::Time &time);
+
+    std::vector<std::string> joint_names_;
+    std::vector<std::string> interface_names_;
+    std::size_t stride_ = 0; // values per sample
+    std::size_t batch_size_ = 0;
+
+    std::vector<double> times_;
+    std::vector<double> values_;
+    std::size_t first_ = 0; // oldest sample
+    std::size_t count_ = 0;
+    std::uint64_t dropped_ = 0;
+
+    std::shared_ptr<rclcpp::Publisher<JointSamples>> samples_pub_;
+    std::unique_ptr<realtime_tools::RealtimePublisher<JointSamples>> samples_publisher_;
+  };
+
+} // namespace robot_controllers
+
+#endif // ROBOT_CONTROLLERS__STATE_RECORDER_HPP_
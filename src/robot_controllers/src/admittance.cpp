@@ -0,0 +1,129 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_controllers/admittance.hpp"
+
+#include <cmath>
+
+#include <Eigen/Cholesky>
+
+namespace robot_controllers
+{
+  namespace
+  {
+    double apply_deadband(double value, double deadband)
+    {
+      const double magnitude = std::abs(value) - deadband;
+      return magnitude > 0.0 ? std::copysign(magnitude, value) : 0.0;
+    }
+
+    // keeps a 3 vector within radius, and stops the motion further out
+    void limit(Eigen::Ref<Eigen::Vector3d> offset, Eigen::Ref<Eigen::Vector3d> velocity, double radius)
+    {
+      const double norm = offset.norm();
+      if (norm <= radius)
+      {
+        return;
+      }
+      offset *= radius / norm;
+      const Eigen::Vector3d direction = offset / radius;
+      const double outward = velocity.dot(direction);
+      if (outward > 0.0)
+      {
+        velocity -= outward * direction;
+      }
+    }
+
+    // position and rotation vector of `target` relative to `current`, root frame
+    Vector6d pose_error(const Eigen::Isometry3d &target, const Eigen::Isometry3d &current)
+    {
+      Vector6d error;
+      error.head<3>() = target.translation() - current.translation();
+      const Eigen::AngleAxisd rotation(target.linear() * current.linear().transpose());
+      error.tail<3>() = rotation.angle() * rotation.axis();
+      return error;
+    }
+  } // namespace
+
+  bool AdmittanceParameters::valid() const
+  {
+    return (mass.array() > 0.0).all() && (damping.array() >= 0.0).all() && (stiffness.array() >= 0.0).all() &&
+           (deadband.array() >= 0.0).all() && tool_mass >= 0.0 && max_linear_offset >= 0.0 &&
+           max_angular_offset >= 0.0 && damping_lambda > 0.0;
+  }
+
+  Admittance::Admittance(const robot_dynamics::DynamicsModel &model)
+      : model_(model)
+  {
+  }
+
+  Vector6d Admittance::tool_gravity(const Eigen::Matrix3d &rotation, const AdmittanceParameters &parameters) const
+  {
+    Vector6d wrench;
+    wrench.head<3>() = parameters.tool_mass * (rotation.transpose() * model_.gravity());
+    wrench.tail<3>() = parameters.tool_com.cross(wrench.head<3>());
+    return wrench;
+  }
+
+  void Admittance::reset(const JointVector &q, const Vector6d &wrench, const AdmittanceParameters &parameters)
+  {
+    bias_ = wrench - tool_gravity(model_.forward_kinematics(q).linear(), parameters);
+    offset_.setZero();
+    velocity_.setZero();
+    external_wrench_.setZero();
+    joint_offset_.setZero();
+  }
+
+  void Admittance::update(const JointVector &q_reference, const JointVector &q, const Vector6d &wrench,
+                          const AdmittanceParameters &parameters, double dt, JointVector &q_command)
+  {
+    const Eigen::Matrix3d R = model_.forward_kinematics(q).linear();
+    Vector6d sensed = wrench - bias_ - tool_gravity(R, parameters);
+    for (int i = 0; i < 6; i++)
+    {
+      sensed[i] = apply_deadband(sensed[i], parameters.deadband[i]);
+    }
+    external_wrench_.head<3>() = R * sensed.head<3>();
+    external_wrench_.tail<3>() = R * sensed.tail<3>();
+
+    // semi-implicit Euler of M x'' + D x' + K x = F
+    const Vector6d acceleration = (external_wrench_ - parameters.damping.cwiseProduct(velocity_) -
+                                   parameters.stiffness.cwiseProduct(offset_))
+                                      .cwiseQuotient(parameters.mass);
+    velocity_ += acceleration * dt;
+    offset_ += velocity_ * dt;
+    limit(offset_.head<3>(), velocity_.head<3>(), parameters.max_linear_offset);
+    limit(offset_.tail<3>(), velocity_.tail<3>(), parameters.max_angular_offset);
+
+    Eigen::Isometry3d target = model_.forward_kinematics(q_reference);
+    target.translation() += offset_.head<3>();
+    const double angle = offset_.tail<3>().norm();
+    if (angle > 0.0)
+    {
+      target.linear() = Eigen::AngleAxisd(angle, offset_.tail<3>() / angle).toRotationMatrix() * target.linear();
+    }
+
+    // one damped least squares step per cycle, the joint offset tracks the
+    // Cartesian offset as the reference moves
+    q_command = q_reference + joint_offset_;
+    const Vector6d error = pose_error(target, model_.forward_kinematics(q_command));
+    robot_dynamics::Jacobian J;
+    model_.jacobian(q_command, J);
+    const Eigen::Matrix<double, 6, 6> JJt = J * J.transpose() +
+                                           parameters.damping_lambda * parameters.damping_lambda * Eigen::Matrix<double, 6, 6>::Identity();
+    joint_offset_ += J.transpose() * JJt.ldlt().solve(error);
+    q_command = q_reference + joint_offset_;
+  }
+
+} // namespace robot_controllers
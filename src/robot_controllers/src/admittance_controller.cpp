@@ -0,0 +1,291 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_controllers/admittance_controller.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "hardware_interface/types/hardware_interface_type_values.hpp"
+
+namespace robot_controllers
+{
+  namespace
+  {
+    const std::array<const char *, 6> WRENCH_INTERFACES = {"force.x", "force.y", "force.z",
+                                                           "torque.x", "torque.y", "torque.z"};
+
+    const std::array<const char *, 4> VECTOR_PARAMETERS = {"mass", "damping", "stiffness", "deadband"};
+
+    std::vector<double> to_vector(const Vector6d &v)
+    {
+      return std::vector<double>(v.data(), v.data() + v.size());
+    }
+  } // namespace
+
+  controller_interface::CallbackReturn AdmittanceController::on_init()
+  {
+    const AdmittanceParameters defaults;
+    auto_declare<std::vector<std::string>>("joints", std::vector<std::string>());
+    auto_declare<std::string>("sensor_name", "tcp_fts_sensor");
+    auto_declare<std::string>("root_link", "base_link");
+    auto_declare<std::string>("tip_link", "link_7"); // the frame of the sensor
+    auto_declare<std::vector<double>>("mass", to_vector(defaults.mass));
+    auto_declare<std::vector<double>>("damping", to_vector(defaults.damping));
+    auto_declare<std::vector<double>>("stiffness", to_vector(defaults.stiffness));
+    auto_declare<std::vector<double>>("deadband", to_vector(defaults.deadband));
+    auto_declare<double>("tool_mass", defaults.tool_mass);
+    auto_declare<std::vector<double>>("tool_com", {0.0, 0.0, 0.0});
+    auto_declare<double>("max_linear_offset", defaults.max_linear_offset);
+    auto_declare<double>("max_angular_offset", defaults.max_angular_offset);
+    auto_declare<double>("damping_lambda", defaults.damping_lambda);
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::InterfaceConfiguration AdmittanceController::command_interface_configuration() const
+  {
+    controller_interface::InterfaceConfiguration config;
+    config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+    for (const auto &joint : joint_names_)
+    {
+      config.names.push_back(joint + "/" + hardware_interface::HW_IF_POSITION);
+    }
+    return config;
+  }
+
+  controller_interface::InterfaceConfiguration AdmittanceController::state_interface_configuration() const
+  {
+    // joint positions first, then the wrench, read_state relies on the order
+    controller_interface::InterfaceConfiguration config;
+    config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+    for (const auto &joint : joint_names_)
+    {
+      config.names.push_back(joint + "/" + hardware_interface::HW_IF_POSITION);
+    }
+    for (const char *interface : WRENCH_INTERFACES)
+    {
+      config.names.push_back(sensor_name_ + "/" + interface);
+    }
+    return config;
+  }
+
+  bool AdmittanceController::read_parameters(const PendingParameters &pending, AdmittanceParameters &parameters,
+                                             std::string &error) const
+  {
+    for (std::size_t i = 0; i < VECTOR_PARAMETERS.size(); i++)
+    {
+      const std::vector<double> values = pending.get(VECTOR_PARAMETERS[i]).as_double_array();
+      if (values.size() != 6)
+      {
+        error = std::string("Parameter '") + VECTOR_PARAMETERS[i] + "' needs 6 values.";
+        return false;
+      }
+      Vector6d &target = i == 0 ? parameters.mass : i == 1 ? parameters.damping : i == 2 ? parameters.stiffness : parameters.deadband;
+      target = Eigen::Map<const Vector6d>(values.data());
+    }
+    const std::vector<double> tool_com = pending.get("tool_com").as_double_array();
+    if (tool_com.size() != 3)
+    {
+      error = "Parameter 'tool_com' needs 3 values.";
+      return false;
+    }
+    parameters.tool_mass = pending.get("tool_mass").as_double();
+    parameters.tool_com = Eigen::Map<const Eigen::Vector3d>(tool_com.data());
+    parameters.max_linear_offset = pending.get("max_linear_offset").as_double();
+    parameters.max_angular_offset = pending.get("max_angular_offset").as_double();
+    parameters.damping_lambda = pending.get("damping_lambda").as_double();
+    if (!parameters.valid())
+    {
+      error = "Admittance parameters out of range (mass > 0, everything else >= 0).";
+      return false;
+    }
+    return true;
+  }
+
+  controller_interface::CallbackReturn AdmittanceController::on_configure(const rclcpp_lifecycle::State &)
+  {
+    const auto node = get_node();
+    joint_names_ = node->get_parameter("joints").as_string_array();
+    sensor_name_ = node->get_parameter("sensor_name").as_string();
+    if (joint_names_.size() != robot_dynamics::NUM_JOINTS)
+    {
+      RCLCPP_ERROR(node->get_logger(), "Expected 6 joints, got %zu.", joint_names_.size());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+
+    try
+    {
+      const auto model = robot_dynamics::DynamicsModel::from_urdf(
+          get_robot_description(), node->get_parameter("root_link").as_string(),
+          node->get_parameter("tip_link").as_string());
+      for (std::size_t i = 0; i < joint_names_.size(); i++)
+      {
+        if (joint_names_[i] != model.joint_names()[i])
+        {
+          throw std::runtime_error("Joint '" + joint_names_[i] + "' is not joint " + std::to_string(i + 1) + " of the chain.");
+        }
+      }
+      admittance_ = Admittance(model);
+    }
+    catch (const std::exception &e)
+    {
+      RCLCPP_ERROR(node->get_logger(), "Cannot build the dynamics model: %s", e.what());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+
+    AdmittanceParameters parameters;
+    std::string error;
+    if (!read_parameters(PendingParameters(*node, {}), parameters, error))
+    {
+      RCLCPP_ERROR(node->get_logger(), "%s", error.c_str());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    parameters_.writeFromNonRT(parameters);
+
+    // a change is checked as a whole before it is set, so the post-set callback
+    // only ever swaps in a valid set
+    validate_parameters_handle_ = node->add_on_set_parameters_callback(
+        [this](const std::vector<rclcpp::Parameter> &changed)
+        {
+          rcl_interfaces::msg::SetParametersResult result;
+          result.successful = true;
+          for (const auto &parameter : changed)
+          {
+            if (parameter.get_name() == "joints" || parameter.get_name() == "sensor_name" ||
+                parameter.get_name() == "root_link" || parameter.get_name() == "tip_link")
+            {
+              result.successful = false;
+              result.reason = "'" + parameter.get_name() + "' only changes on configure.";
+              return result;
+            }
+          }
+          AdmittanceParameters candidate;
+          result.successful = read_parameters(PendingParameters(*get_node(), changed), candidate, result.reason);
+          return result;
+        });
+    update_parameters_handle_ = node->add_post_set_parameters_callback(
+        [this](const std::vector<rclcpp::Parameter> &)
+        {
+          AdmittanceParameters updated;
+          std::string error;
+          if (read_parameters(PendingParameters(*get_node(), {}), updated, error))
+          {
+            parameters_.writeFromNonRT(updated);
+          }
+        });
+
+    reference_interfaces_.assign(joint_names_.size(), std::numeric_limits<double>::quiet_NaN());
+    reference_sub_ = node->create_subscription<JointTrajectoryPoint>(
+        "~/joint_references", rclcpp::SystemDefaultsQoS(),
+        [this](const std::shared_ptr<JointTrajectoryPoint> msg)
+        {
+          if (msg->positions.size() == joint_names_.size())
+          {
+            reference_buffer_.writeFromNonRT(msg);
+          }
+        });
+
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  std::vector<hardware_interface::CommandInterface> AdmittanceController::on_export_reference_interfaces()
+  {
+    std::vector<hardware_interface::CommandInterface> interfaces;
+    for (std::size_t i = 0; i < joint_names_.size(); i++)
+    {
+      interfaces.emplace_back(get_node()->get_name(), joint_names_[i] + "/" + hardware_interface::HW_IF_POSITION,
+                              &reference_interfaces_[i]);
+    }
+    return interfaces;
+  }
+
+  bool AdmittanceController::on_set_chained_mode(bool)
+  {
+    return true;
+  }
+
+  void AdmittanceController::read_state(JointVector &q, Vector6d &wrench) const
+  {
+    for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+    {
+      q[i] = state_interfaces_[i].get_value();
+    }
+    for (std::size_t i = 0; i < 6; i++)
+    {
+      wrench[i] = state_interfaces_[robot_dynamics::NUM_JOINTS + i].get_value();
+    }
+  }
+
+  controller_interface::CallbackReturn AdmittanceController::on_activate(const rclcpp_lifecycle::State &)
+  {
+    JointVector q;
+    Vector6d wrench;
+    read_state(q, wrench);
+    admittance_.reset(q, wrench, *parameters_.readFromNonRT());
+    last_reference_ = q;
+    std::fill(reference_interfaces_.begin(), reference_interfaces_.end(), std::numeric_limits<double>::quiet_NaN());
+    reference_buffer_.writeFromNonRT(nullptr);
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::CallbackReturn AdmittanceController::on_deactivate(const rclcpp_lifecycle::State &)
+  {
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::return_type AdmittanceController::update_reference_from_subscribers(const rclcpp::Time &,
+                                                                                            const rclcpp::Duration &)
+  {
+    const auto reference = *reference_buffer_.readFromRT();
+    if (reference)
+    {
+      std::copy(reference->positions.begin(), reference->positions.end(), reference_interfaces_.begin());
+    }
+    return controller_interface::return_type::OK;
+  }
+
+  controller_interface::return_type AdmittanceController::update_and_write_commands(const rclcpp::Time &,
+                                                                                    const rclcpp::Duration &period)
+  {
+    JointVector q;
+    Vector6d wrench;
+    read_state(q, wrench);
+
+    // until a reference arrives (or while the upstream controller writes none) hold
+    // the last one
+    for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+    {
+      if (std::isfinite(reference_interfaces_[i]))
+      {
+        last_reference_[i] = reference_interfaces_[i];
+      }
+    }
+
+    JointVector q_command;
+    admittance_.update(last_reference_, q, wrench, *parameters_.readFromRT(), period.seconds(), q_command);
+    for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+    {
+      command_interfaces_[i].set_value(q_command[i]);
+    }
+    return controller_interface::return_type::OK;
+  }
+
+} // namespace robot_controllers
+
+#include "pluginlib/class_list_macros.hpp"
+
+PLUGINLIB_EXPORT_CLASS(robot_controllers::AdmittanceController, controller_interface::ChainableControllerInterface)
@@ -0,0 +1,109 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_controllers/contact_guard.hpp"
+
+#include <algorithm>
+
+namespace robot_controllers
+{
+  bool GuardThresholds::valid() const
+  {
+    return force >= 0.0 && torque >= 0.0 && tracking_error >= 0.0;
+  }
+
+  bool GuardThresholds::any() const
+  {
+    return force > 0.0 || torque > 0.0 || tracking_error > 0.0;
+  }
+
+  ContactGuard::ContactGuard(std::size_t history_size)
+      : history_(std::max<std::size_t>(history_size, 1))
+  {
+  }
+
+  void ContactGuard::arm(const GuardThresholds &thresholds)
+  {
+    thresholds_ = thresholds;
+    armed_ = true;
+    tared_ = false;
+    triggered_ = false;
+  }
+
+  void ContactGuard::disarm()
+  {
+    armed_ = false;
+    triggered_ = false;
+  }
+
+  void ContactGuard::trip(ContactSource source)
+  {
+    if (!triggered_ && count_ > 0)
+    {
+      triggered_ = true;
+      source_ = source;
+    }
+  }
+
+  const GuardSample &ContactGuard::history(std::size_t i) const
+  {
+    return history_[(next_ + history_.size() - count_ + i) % history_.size()];
+  }
+
+  bool ContactGuard::update(double time, const JointVector &position, const JointVector &previous_command,
+                            bool has_wrench, const Vector6d &wrench)
+  {
+    if (triggered_)
+    {
+      return false; // history stays frozen at the contact until disarm()
+    }
+    if (armed_ && !tared_ && has_wrench)
+    {
+      bias_ = wrench;
+      tared_ = true;
+    }
+
+    GuardSample &sample = history_[next_];
+    sample.time = time;
+    sample.position = position;
+    sample.wrench = has_wrench ? Vector6d(wrench - bias_) : Vector6d::Zero();
+    sample.tracking_error = (previous_command - position).cwiseAbs().maxCoeff();
+    next_ = (next_ + 1) % history_.size();
+    count_ = std::min(count_ + 1, history_.size());
+
+    if (!armed_)
+    {
+      return false;
+    }
+    if (has_wrench && thresholds_.force > 0.0 && sample.wrench.head<3>().norm() > thresholds_.force)
+    {
+      source_ = ContactSource::FORCE;
+    }
+    else if (has_wrench && thresholds_.torque > 0.0 && sample.wrench.tail<3>().norm() > thresholds_.torque)
+    {
+      source_ = ContactSource::TORQUE;
+    }
+    else if (thresholds_.tracking_error > 0.0 && sample.tracking_error > thresholds_.tracking_error)
+    {
+      source_ = ContactSource::TRACKING_ERROR;
+    }
+    else
+    {
+      return false;
+    }
+    triggered_ = true;
+    return true;
+  }
+
+} // namespace robot_controllers
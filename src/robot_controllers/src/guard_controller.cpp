@@ -0,0 +1,511 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_controllers/guard_controller.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "hardware_interface/types/hardware_interface_type_values.hpp"
+
+namespace robot_controllers
+{
+  namespace
+  {
+    const std::array<const char *, 6> WRENCH_INTERFACES = {"force.x", "force.y", "force.z",
+                                                           "torque.x", "torque.y", "torque.z"};
+
+    std::vector<double> to_vector(const JointVector &v)
+    {
+      return std::vector<double>(v.data(), v.data() + v.size());
+    }
+  } // namespace
+
+  controller_interface::CallbackReturn GuardController::on_init()
+  {
+    auto_declare<std::vector<std::string>>("joints", std::vector<std::string>());
+    auto_declare<std::string>("sensor_name", "tcp_fts_sensor"); // "" watches the tracking error only
+    auto_declare<int>("history_size", 100);                     // control cycles before the contact
+
+    const ObserverParameters observer;
+    auto_declare<bool>("collision.enabled", false);
+    auto_declare<std::string>("collision.root_link", "base_link");
+    auto_declare<std::string>("collision.tip_link", "link_7");
+    auto_declare<std::string>("collision.reaction", "stop"); // "stop", "retract" or "compliant"
+    auto_declare<double>("collision.gain", observer.gain);
+    auto_declare<std::vector<double>>("collision.threshold", to_vector(observer.threshold));
+    auto_declare<std::vector<double>>("collision.velocity_gain", to_vector(observer.velocity_gain));
+    auto_declare<double>("collision.bias_time_constant", observer.bias_time_constant);
+    auto_declare<double>("collision.retract_time", 0.5);
+    auto_declare<double>("collision.retract_duration", 1.0);
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::InterfaceConfiguration GuardController::command_interface_configuration() const
+  {
+    controller_interface::InterfaceConfiguration config;
+    config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+    for (const auto &joint : joint_names_)
+    {
+      config.names.push_back(joint + "/" + hardware_interface::HW_IF_POSITION);
+    }
+    return config;
+  }
+
+  controller_interface::InterfaceConfiguration GuardController::state_interface_configuration() const
+  {
+    // joint positions, the wrench, then the efforts, read_state relies on the order
+    controller_interface::InterfaceConfiguration config;
+    config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+    for (const auto &joint : joint_names_)
+    {
+      config.names.push_back(joint + "/" + hardware_interface::HW_IF_POSITION);
+    }
+    if (has_sensor_)
+    {
+      for (const char *interface : WRENCH_INTERFACES)
+      {
+        config.names.push_back(sensor_name_ + "/" + interface);
+      }
+    }
+    if (collision_enabled_)
+    {
+      for (const auto &joint : joint_names_)
+      {
+        config.names.push_back(joint + "/" + hardware_interface::HW_IF_EFFORT);
+      }
+    }
+    return config;
+  }
+
+  bool GuardController::read_collision_settings(const PendingParameters &pending, CollisionSettings &settings,
+                                                std::string &error) const
+  {
+    const std::vector<double> threshold = pending.get("collision.threshold").as_double_array();
+    const std::vector<double> velocity_gain = pending.get("collision.velocity_gain").as_double_array();
+    if (threshold.size() != robot_dynamics::NUM_JOINTS || velocity_gain.size() != robot_dynamics::NUM_JOINTS)
+    {
+      error = "Parameters 'collision.threshold' and 'collision.velocity_gain' need 6 values.";
+      return false;
+    }
+    settings.observer.gain = pending.get("collision.gain").as_double();
+    settings.observer.threshold = Eigen::Map<const JointVector>(threshold.data());
+    settings.observer.velocity_gain = Eigen::Map<const JointVector>(velocity_gain.data());
+    settings.observer.bias_time_constant = pending.get("collision.bias_time_constant").as_double();
+    settings.retract_time = pending.get("collision.retract_time").as_double();
+    settings.retract_duration = pending.get("collision.retract_duration").as_double();
+
+    const std::string reaction = pending.get("collision.reaction").as_string();
+    if (reaction == "stop")
+    {
+      settings.reaction = Reaction::STOP;
+    }
+    else if (reaction == "retract")
+    {
+      settings.reaction = Reaction::RETRACT;
+    }
+    else if (reaction == "compliant")
+    {
+      settings.reaction = Reaction::COMPLIANT;
+    }
+    else
+    {
+      error = "Unknown collision reaction '" + reaction + "'.";
+      return false;
+    }
+
+    if (!settings.observer.valid() || settings.retract_time < 0.0 || settings.retract_duration <= 0.0)
+    {
+      error = "Collision parameters out of range (gain, thresholds and retract_duration > 0).";
+      return false;
+    }
+    return true;
+  }
+
+  controller_interface::CallbackReturn GuardController::on_configure(const rclcpp_lifecycle::State &)
+  {
+    const auto node = get_node();
+    joint_names_ = node->get_parameter("joints").as_string_array();
+    sensor_name_ = node->get_parameter("sensor_name").as_string();
+    has_sensor_ = !sensor_name_.empty();
+    if (joint_names_.size() != robot_dynamics::NUM_JOINTS)
+    {
+      RCLCPP_ERROR(node->get_logger(), "Expected 6 joints, got %zu.", joint_names_.size());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    const int64_t history_size = node->get_parameter("history_size").as_int();
+    if (history_size < 1)
+    {
+      RCLCPP_ERROR(node->get_logger(), "Parameter 'history_size' has to be at least 1.");
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    guard_ = ContactGuard(static_cast<std::size_t>(history_size));
+
+    collision_enabled_ = node->get_parameter("collision.enabled").as_bool();
+    if (collision_enabled_)
+    {
+      try
+      {
+        const auto model = robot_dynamics::DynamicsModel::from_urdf(
+            get_robot_description(), node->get_parameter("collision.root_link").as_string(),
+            node->get_parameter("collision.tip_link").as_string());
+        for (std::size_t i = 0; i < joint_names_.size(); i++)
+        {
+          if (joint_names_[i] != model.joint_names()[i])
+          {
+            throw std::runtime_error("Joint '" + joint_names_[i] + "' is not joint " + std::to_string(i + 1) + " of the chain.");
+          }
+        }
+        observer_ = MomentumObserver(model);
+      }
+      catch (const std::exception &e)
+      {
+        RCLCPP_ERROR(node->get_logger(), "Cannot build the dynamics model: %s", e.what());
+        return controller_interface::CallbackReturn::ERROR;
+      }
+    }
+    CollisionSettings settings;
+    std::string error;
+    if (!read_collision_settings(PendingParameters(*node, {}), settings, error))
+    {
+      RCLCPP_ERROR(node->get_logger(), "%s", error.c_str());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    collision_settings_.writeFromNonRT(settings);
+    validate_parameters_handle_ = node->add_on_set_parameters_callback(
+        [this](const std::vector<rclcpp::Parameter> &changed)
+        {
+          rcl_interfaces::msg::SetParametersResult result;
+          result.successful = true;
+          for (const auto &parameter : changed)
+          {
+            if (parameter.get_name() == "collision.enabled" || parameter.get_name() == "collision.root_link" ||
+                parameter.get_name() == "collision.tip_link")
+            {
+              result.successful = false;
+              result.reason = "'" + parameter.get_name() + "' only changes on configure.";
+              return result;
+            }
+          }
+          CollisionSettings candidate;
+          result.successful = read_collision_settings(PendingParameters(*get_node(), changed), candidate, result.reason);
+          return result;
+        });
+    update_parameters_handle_ = node->add_post_set_parameters_callback(
+        [this](const std::vector<rclcpp::Parameter> &)
+        {
+          CollisionSettings updated;
+          std::string error;
+          if (read_collision_settings(PendingParameters(*get_node(), {}), updated, error))
+          {
+            collision_settings_.writeFromNonRT(updated);
+          }
+        });
+
+    // the message is filled in the control loop, reserve everything up front
+    contact_pub_ = node->create_publisher<ContactEvent>("~/contact", rclcpp::SystemDefaultsQoS());
+    contact_publisher_ = std::make_unique<realtime_tools::RealtimePublisher<ContactEvent>>(contact_pub_);
+    contact_publisher_->lock();
+    auto &msg = contact_publisher_->msg_;
+    msg.joint_positions.resize(robot_dynamics::NUM_JOINTS);
+    msg.external_torques.resize(robot_dynamics::NUM_JOINTS);
+    msg.history_time.reserve(history_size);
+    msg.history_joint_positions.reserve(history_size * robot_dynamics::NUM_JOINTS);
+    msg.history_wrench.reserve(history_size * 6);
+    msg.history_tracking_error.reserve(history_size);
+    contact_publisher_->unlock();
+
+    arm_request_.writeFromNonRT(ArmRequest());
+    arm_sequence_ = 0;
+    applied_sequence_ = 0;
+    arm_service_ = node->create_service<ArmGuard>(
+        "~/arm",
+        [this](const std::shared_ptr<ArmGuard::Request> request, std::shared_ptr<ArmGuard::Response> response)
+        { arm_callback(*request, *response); });
+
+    reference_interfaces_.assign(joint_names_.size(), std::numeric_limits<double>::quiet_NaN());
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  void GuardController::arm_callback(const ArmGuard::Request &request, ArmGuard::Response &response)
+  {
+    ArmRequest arm_request;
+    arm_request.arm = request.arm;
+    arm_request.thresholds.force = request.force_threshold;
+    arm_request.thresholds.torque = request.torque_threshold;
+    arm_request.thresholds.tracking_error = request.tracking_error_threshold;
+
+    if (request.arm)
+    {
+      if (!arm_request.thresholds.valid() || !arm_request.thresholds.any())
+      {
+        response.message = "Thresholds have to be >= 0 and at least one of them set.";
+        return;
+      }
+      if (!has_sensor_ && (request.force_threshold > 0.0 || request.torque_threshold > 0.0))
+      {
+        response.message = "No force torque sensor configured, only the tracking error can be watched.";
+        return;
+      }
+      if (collision_latched_)
+      {
+        response.message = "A collision is latched, disarm the guard first.";
+        return;
+      }
+    }
+
+    arm_request.sequence = ++arm_sequence_;
+    arm_request_.writeFromNonRT(arm_request);
+    response.success = true;
+    response.message = request.arm ? "Guard armed." : "Guard disarmed.";
+  }
+
+  std::vector<hardware_interface::CommandInterface> GuardController::on_export_reference_interfaces()
+  {
+    std::vector<hardware_interface::CommandInterface> interfaces;
+    for (std::size_t i = 0; i < joint_names_.size(); i++)
+    {
+      interfaces.emplace_back(get_node()->get_name(), joint_names_[i] + "/" + hardware_interface::HW_IF_POSITION,
+                              &reference_interfaces_[i]);
+    }
+    return interfaces;
+  }
+
+  bool GuardController::on_set_chained_mode(bool)
+  {
+    return true;
+  }
+
+  void GuardController::read_state(JointVector &q, Vector6d &wrench, JointVector &effort) const
+  {
+    for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+    {
+      q[i] = state_interfaces_[i].get_value();
+    }
+    wrench.setZero();
+    if (has_sensor_)
+    {
+      for (std::size_t i = 0; i < 6; i++)
+      {
+        wrench[i] = state_interfaces_[robot_dynamics::NUM_JOINTS + i].get_value();
+      }
+    }
+    effort.setZero();
+    if (collision_enabled_)
+    {
+      const std::size_t offset = robot_dynamics::NUM_JOINTS + (has_sensor_ ? 6 : 0);
+      for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+      {
+        effort[i] = state_interfaces_[offset + i].get_value();
+      }
+    }
+  }
+
+  controller_interface::CallbackReturn GuardController::on_activate(const rclcpp_lifecycle::State &)
+  {
+    JointVector q;
+    Vector6d wrench;
+    JointVector effort;
+    read_state(q, wrench, effort);
+    last_reference_ = q;
+    last_command_ = q;
+    std::fill(reference_interfaces_.begin(), reference_interfaces_.end(), std::numeric_limits<double>::quiet_NaN());
+    guard_.disarm();
+    observer_.reset();
+    collision_latched_ = false;
+    applied_sequence_ = arm_request_.readFromNonRT()->sequence; // nothing armed before activation carries over
+    contact_pending_ = false;
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::CallbackReturn GuardController::on_deactivate(const rclcpp_lifecycle::State &)
+  {
+    guard_.disarm();
+    collision_latched_ = false;
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::return_type GuardController::update_reference_from_subscribers(const rclcpp::Time &,
+                                                                                       const rclcpp::Duration &)
+  {
+    // references only come from the chained controller
+    return controller_interface::return_type::OK;
+  }
+
+  void GuardController::start_reaction(const CollisionSettings &settings)
+  {
+    reaction_ = settings.reaction;
+    reaction_time_ = 0.0;
+    retract_duration_ = settings.retract_duration;
+
+    // back to where the robot was retract_time before the collision, or as far as the
+    // history goes
+    const GuardSample &contact = guard_.contact();
+    retract_target_ = guard_.history(0).position;
+    for (std::size_t i = guard_.history_count(); i-- > 0;)
+    {
+      if (guard_.history(i).time <= contact.time - settings.retract_time)
+      {
+        retract_target_ = guard_.history(i).position;
+        break;
+      }
+    }
+  }
+
+  void GuardController::reaction_command(const JointVector &q, double dt, JointVector &command)
+  {
+    const JointVector &contact = guard_.contact().position;
+    switch (reaction_)
+    {
+    case Reaction::STOP:
+      command = contact;
+      break;
+    case Reaction::RETRACT:
+    {
+      // smoothstep from the contact pose, zero velocity at both ends
+      reaction_time_ += dt;
+      const double s = std::min(reaction_time_ / retract_duration_, 1.0);
+      command = contact + s * s * (3.0 - 2.0 * s) * (retract_target_ - contact);
+      break;
+    }
+    case Reaction::COMPLIANT:
+      command = q;
+      break;
+    }
+  }
+
+  controller_interface::return_type GuardController::update_and_write_commands(const rclcpp::Time &time,
+                                                                               const rclcpp::Duration &period)
+  {
+    const ArmRequest &request = *arm_request_.readFromRT();
+    if (request.sequence != applied_sequence_)
+    {
+      applied_sequence_ = request.sequence;
+      if (request.arm)
+      {
+        guard_.arm(request.thresholds);
+      }
+      else
+      {
+        guard_.disarm();
+        observer_.reset(); // the estimate of the collision must not trip again
+        collision_latched_ = false;
+      }
+    }
+
+    JointVector q;
+    Vector6d wrench;
+    JointVector effort;
+    read_state(q, wrench, effort);
+    for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+    {
+      if (std::isfinite(reference_interfaces_[i]))
+      {
+        last_reference_[i] = reference_interfaces_[i];
+      }
+    }
+
+    // compared against the command of the previous cycle, the one q had time to follow
+    if (guard_.update(time.seconds(), q, last_command_, has_sensor_, wrench))
+    {
+      contact_pending_ = true;
+      contact_time_ = time;
+    }
+
+    // the observer keeps running while the guard holds, so its estimate is current
+    // in the event of a guarded move too
+    if (collision_enabled_)
+    {
+      const CollisionSettings &settings = *collision_settings_.readFromRT();
+      if (observer_.update(q, effort, period.seconds(), settings.observer) && !guard_.triggered())
+      {
+        guard_.trip(ContactSource::COLLISION);
+        start_reaction(settings);
+        collision_latched_ = true;
+        contact_pending_ = true;
+        contact_time_ = time;
+      }
+    }
+
+    if (collision_latched_)
+    {
+      reaction_command(q, period.seconds(), last_command_);
+    }
+    else
+    {
+      last_command_ = guard_.triggered() ? guard_.contact().position : last_reference_;
+    }
+    for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+    {
+      command_interfaces_[i].set_value(last_command_[i]);
+    }
+
+    if (contact_pending_)
+    {
+      publish_contact();
+    }
+    return controller_interface::return_type::OK;
+  }
+
+  void GuardController::publish_contact()
+  {
+    // retried next cycle if the publisher thread still holds the message
+    if (!contact_publisher_->trylock())
+    {
+      return;
+    }
+    contact_pending_ = false;
+
+    auto &msg = contact_publisher_->msg_;
+    const GuardSample &contact = guard_.contact();
+    msg.header.stamp = contact_time_;
+    msg.source = static_cast<std::uint8_t>(guard_.source());
+    std::copy(contact.position.data(), contact.position.data() + robot_dynamics::NUM_JOINTS,
+              msg.joint_positions.begin());
+    msg.wrench.force.x = contact.wrench[0];
+    msg.wrench.force.y = contact.wrench[1];
+    msg.wrench.force.z = contact.wrench[2];
+    msg.wrench.torque.x = contact.wrench[3];
+    msg.wrench.torque.y = contact.wrench[4];
+    msg.wrench.torque.z = contact.wrench[5];
+    msg.tracking_error = contact.tracking_error;
+    std::copy(observer_.external_torques().data(), observer_.external_torques().data() + robot_dynamics::NUM_JOINTS,
+              msg.external_torques.begin());
+
+    // within the capacity reserved on configure
+    const std::size_t count = guard_.history_count();
+    msg.history_time.resize(count);
+    msg.history_joint_positions.resize(count * robot_dynamics::NUM_JOINTS);
+    msg.history_wrench.resize(count * 6);
+    msg.history_tracking_error.resize(count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+      const GuardSample &sample = guard_.history(i);
+      msg.history_time[i] = sample.time - contact.time;
+      std::copy(sample.position.data(), sample.position.data() + robot_dynamics::NUM_JOINTS,
+                msg.history_joint_positions.begin() + i * robot_dynamics::NUM_JOINTS);
+      std::copy(sample.wrench.data(), sample.wrench.data() + 6, msg.history_wrench.begin() + i * 6);
+      msg.history_tracking_error[i] = sample.tracking_error;
+    }
+    contact_publisher_->unlockAndPublish();
+  }
+
+} // namespace robot_controllers
+
+#include "pluginlib/class_list_macros.hpp"
+
+PLUGINLIB_EXPORT_CLASS(robot_controllers::GuardController, controller_interface::ChainableControllerInterface)
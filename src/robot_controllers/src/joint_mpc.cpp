@@ -0,0 +1,193 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_controllers/joint_mpc.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robot_controllers
+{
+  bool MpcWeights::valid() const
+  {
+    return position > 0.0 && velocity >= 0.0 && acceleration > 0.0;
+  }
+
+  bool MpcLimits::valid() const
+  {
+    return lower < upper && velocity > 0.0 && acceleration > 0.0;
+  }
+
+  void JointMpc::configure(double step, const MpcWeights &weights, double braking_time, double rho, double sigma,
+                           double relaxation)
+  {
+    step_ = step;
+    braking_time_ = braking_time;
+    weights_ = weights;
+    rho_ = rho;
+    sigma_ = sigma;
+    relaxation_ = relaxation;
+
+    // the inputs are the velocity changes w = u dt, which keeps A close to unit scale
+    // v_k = v_0 + sum_{j<k} w_j
+    // p_k = p_0 + k dt v_0 + dt sum_{j<k} (k - j - 1/2) w_j,  k = 1 .. N
+    Gv_.setZero();
+    Gp_.setZero();
+    for (int k = 0; k < MPC_HORIZON; k++)
+    {
+      for (int j = 0; j <= k; j++)
+      {
+        Gv_(k, j) = 1.0;
+        Gp_(k, j) = (k - j + 0.5) * step;
+      }
+    }
+    P_ = weights.position * Gp_.transpose() * Gp_ + weights.velocity * Gv_.transpose() * Gv_ +
+         weights.acceleration / (step * step) * Matrix::Identity();
+
+    // P + sigma I + rho A^T A
+    const Eigen::Matrix<double, 1, MPC_HORIZON> terminal =
+        Gp_.row(MPC_HORIZON - 1) + braking_time * Gv_.row(MPC_HORIZON - 1);
+    const Matrix AtA = Matrix::Identity() + Gv_.transpose() * Gv_ + Gp_.transpose() * Gp_ +
+                       terminal.transpose() * terminal;
+    kkt_inverse_ = (P_ + sigma * Matrix::Identity() + rho * AtA).llt().solve(Matrix::Identity());
+    reset();
+  }
+
+  void JointMpc::reset()
+  {
+    inputs_.setZero();
+    z_.setZero();
+    y_.setZero();
+    iterations_ = 0;
+    converged_ = false;
+  }
+
+  // Gv and Gp are running sums, so the products take O(N) instead of O(N^2)
+  void JointMpc::constrain(const Inputs &u, Constraints &z) const
+  {
+    double velocity = 0.0;
+    double position = 0.0;
+    for (int k = 0; k < MPC_HORIZON; k++)
+    {
+      z[k] = u[k];
+      velocity += u[k];
+      z[MPC_HORIZON + k] = velocity;
+      z[2 * MPC_HORIZON + k] = step_ * (position + 0.5 * velocity);
+      position += velocity;
+    }
+    z[3 * MPC_HORIZON] = z[3 * MPC_HORIZON - 1] + braking_time_ * velocity;
+  }
+
+  void JointMpc::constrain_transpose(const Constraints &y, Inputs &u) const
+  {
+    // the terminal row weighs on the last velocity and position
+    double velocity = braking_time_ * y[3 * MPC_HORIZON];
+    double position = 0.0;
+    double position_sum = 0.0;
+    for (int k = MPC_HORIZON - 1; k >= 0; k--)
+    {
+      velocity += y[MPC_HORIZON + k];
+      position_sum += position;
+      position += y[2 * MPC_HORIZON + k] + (k == MPC_HORIZON - 1 ? y[3 * MPC_HORIZON] : 0.0);
+      u[k] = y[k] + velocity + step_ * (position_sum + 0.5 * position);
+    }
+  }
+
+  double JointMpc::solve(double position, double velocity, double reference_position, double reference_velocity,
+                         const MpcLimits &limits, int max_iterations, double tolerance)
+  {
+    // free response and reference over the horizon; the reference is cut off at the
+    // limits, a target the plan cannot reach only holds the iteration against the bounds
+    Inputs position_error;
+    Inputs velocity_error;
+    Constraints lower;
+    Constraints upper;
+    const double target_velocity = std::clamp(reference_velocity, -limits.velocity, limits.velocity);
+    for (int k = 0; k < MPC_HORIZON; k++)
+    {
+      const double t = (k + 1) * step_;
+      const double free_position = position + t * velocity;
+      const double target = reference_position + t * reference_velocity;
+      const bool inside = target > limits.lower && target < limits.upper;
+      position_error[k] = free_position - std::clamp(target, limits.lower, limits.upper);
+      velocity_error[k] = velocity - (inside ? target_velocity : 0.0);
+      lower[k] = -limits.acceleration * step_;
+      upper[k] = limits.acceleration * step_;
+      lower[MPC_HORIZON + k] = -limits.velocity - velocity;
+      upper[MPC_HORIZON + k] = limits.velocity - velocity;
+      // a start outside the box is steered back in rather than made infeasible
+      lower[2 * MPC_HORIZON + k] = std::min(limits.lower, position) - free_position;
+      upper[2 * MPC_HORIZON + k] = std::max(limits.upper, position) - free_position;
+    }
+    const double free_terminal = position + MPC_HORIZON * step_ * velocity + braking_time_ * velocity;
+    lower[3 * MPC_HORIZON] = std::min(limits.lower, position) - free_terminal;
+    upper[3 * MPC_HORIZON] = std::max(limits.upper, position) - free_terminal;
+    Inputs q;
+    q.noalias() = weights_.position * Gp_.transpose() * position_error;
+    q.noalias() += weights_.velocity * Gv_.transpose() * velocity_error;
+
+    // warm start: the previous plan one step on, the last input repeated
+    Inputs u;
+    u.head<MPC_HORIZON - 1>() = inputs_.tail<MPC_HORIZON - 1>();
+    u[MPC_HORIZON - 1] = inputs_[MPC_HORIZON - 1];
+    for (int block = 0; block < 3; block++)
+    {
+      y_.segment<MPC_HORIZON - 1>(block * MPC_HORIZON) = y_.segment<MPC_HORIZON - 1>(block * MPC_HORIZON + 1);
+    }
+    constrain(u, z_);
+    z_ = z_.cwiseMax(lower).cwiseMin(upper);
+
+    Inputs rhs;
+    Inputs u_tilde;
+    Inputs dual;
+    Constraints z_tilde;
+    Constraints z_relaxed;
+    converged_ = false;
+    iterations_ = 0;
+    while (iterations_ < max_iterations && !converged_)
+    {
+      iterations_++;
+      constrain_transpose(rho_ * z_ - y_, rhs);
+      rhs += sigma_ * u - q;
+      u_tilde.noalias() = kkt_inverse_ * rhs;
+      constrain(u_tilde, z_tilde);
+
+      u = relaxation_ * u_tilde + (1.0 - relaxation_) * u;
+      z_relaxed = relaxation_ * z_tilde + (1.0 - relaxation_) * z_;
+      z_ = (z_relaxed + y_ / rho_).cwiseMax(lower).cwiseMin(upper);
+      y_ += rho_ * (z_relaxed - z_);
+
+      // primal and dual residuals, scaled like the iterates
+      constrain(u, z_tilde);
+      const double primal = (z_tilde - z_).lpNorm<Eigen::Infinity>();
+      constrain_transpose(y_, dual);
+      dual.noalias() += P_ * u;
+      dual += q;
+      converged_ = primal <= tolerance * (1.0 + z_.lpNorm<Eigen::Infinity>()) &&
+                   dual.lpNorm<Eigen::Infinity>() <= tolerance * (1.0 + q.lpNorm<Eigen::Infinity>());
+    }
+    inputs_ = u;
+
+    // the iteration may stop short of the solution, so the step taken is held to the
+    // velocity and braking bounds on its own; from inside them a full brake always
+    // meets both, from outside it steers back in
+    const double reach = step_ * (0.5 * step_ + braking_time_);
+    const double drift = position + (step_ + braking_time_) * velocity;
+    double acceleration = u[0] / step_;
+    acceleration = std::min(acceleration, std::min((limits.upper - drift) / reach, (limits.velocity - velocity) / step_));
+    acceleration = std::max(acceleration, std::max((limits.lower - drift) / reach, (-limits.velocity - velocity) / step_));
+    return std::clamp(acceleration, -limits.acceleration, limits.acceleration);
+  }
+
+} // namespace robot_controllers
@@ -0,0 +1,87 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_controllers/momentum_observer.hpp"
+
+#include <algorithm>
+
+namespace robot_controllers
+{
+  bool ObserverParameters::valid() const
+  {
+    return gain > 0.0 && (threshold.array() > 0.0).all() && (velocity_gain.array() >= 0.0).all() &&
+           bias_time_constant >= 0.0;
+  }
+
+  MomentumObserver::MomentumObserver(const robot_dynamics::DynamicsModel &model)
+      : model_(model)
+  {
+  }
+
+  void MomentumObserver::reset()
+  {
+    cycles_ = 0;
+  }
+
+  bool MomentumObserver::update(const JointVector &q, const JointVector &tau_motor, double dt,
+                                const ObserverParameters &parameters)
+  {
+    if (dt <= 0.0)
+    {
+      return false;
+    }
+    robot_dynamics::MassMatrix mass;
+    model_.mass_matrix(q, mass);
+    const JointVector qd = cycles_ > 0 ? JointVector((q - previous_position_) / dt) : JointVector::Zero();
+    const JointVector momentum = mass * qd;
+
+    if (cycles_ < 2)
+    {
+      // no velocity in the first cycle, the estimate then starts at the momentum of
+      // the second so the residual begins at zero
+      momentum_estimate_ = momentum;
+      residual_.setZero();
+      bias_.setZero();
+      external_torques_.setZero();
+      thresholds_ = parameters.threshold;
+      cycles_++;
+    }
+    else
+    {
+      JointVector gravity;
+      JointVector coriolis; // C qd
+      model_.gravity_torques(q, gravity);
+      model_.motion_torques(q, qd, JointVector::Zero(), coriolis);
+      const JointVector coriolis_transposed = (mass - previous_mass_) / dt * qd - coriolis;
+
+      momentum_estimate_ += (tau_motor + coriolis_transposed - gravity + residual_) * dt;
+      residual_ = parameters.gain * (momentum - momentum_estimate_);
+    }
+
+    thresholds_ = parameters.threshold + parameters.velocity_gain.cwiseProduct(qd.cwiseAbs());
+    external_torques_ = residual_ - bias_;
+    const bool tripped = (external_torques_.cwiseAbs().array() > thresholds_.array()).any();
+
+    // the bias only follows while nothing is touching, a contact must not be learnt away
+    if (!tripped && parameters.bias_time_constant > 0.0)
+    {
+      bias_ += std::min(dt / parameters.bias_time_constant, 1.0) * external_torques_;
+    }
+
+    previous_position_ = q;
+    previous_mass_ = mass;
+    return tripped;
+  }
+
+} // namespace robot_controllers
@@ -0,0 +1,368 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_controllers/mpc_controller.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "hardware_interface/types/hardware_interface_type_values.hpp"
+
+namespace robot_controllers
+{
+  namespace
+  {
+    const std::array<const char *, 6> LIMIT_PARAMETERS = {"lower", "upper", "max_velocity", "max_acceleration",
+                                                          "max_step_rate", "steps_per_rad"};
+
+    bool same_weights(const MpcWeights &a, const MpcWeights &b)
+    {
+      return a.position == b.position && a.velocity == b.velocity && a.acceleration == b.acceleration;
+    }
+  } // namespace
+
+  controller_interface::CallbackReturn MpcController::on_init()
+  {
+    const MpcParameters defaults;
+    auto_declare<std::vector<std::string>>("joints", std::vector<std::string>());
+    auto_declare<double>("step", defaults.step);
+    auto_declare<double>("position_weight", defaults.weights.position);
+    auto_declare<double>("velocity_weight", defaults.weights.velocity);
+    auto_declare<double>("acceleration_weight", defaults.weights.acceleration);
+    auto_declare<double>("rho", defaults.rho);
+    auto_declare<int>("max_iterations", defaults.max_iterations);
+    auto_declare<double>("tolerance", defaults.tolerance);
+    auto_declare<double>("resync_error", defaults.resync_error);
+    // per joint; a max_step_rate of 0 leaves the velocity to max_velocity
+    for (const char *name : LIMIT_PARAMETERS)
+    {
+      auto_declare<std::vector<double>>(name, std::vector<double>());
+    }
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::InterfaceConfiguration MpcController::command_interface_configuration() const
+  {
+    controller_interface::InterfaceConfiguration config;
+    config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+    for (const auto &joint : joint_names_)
+    {
+      config.names.push_back(joint + "/" + hardware_interface::HW_IF_POSITION);
+    }
+    return config;
+  }
+
+  controller_interface::InterfaceConfiguration MpcController::state_interface_configuration() const
+  {
+    // positions then velocities, the update relies on the order
+    controller_interface::InterfaceConfiguration config;
+    config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+    for (const auto &joint : joint_names_)
+    {
+      config.names.push_back(joint + "/" + hardware_interface::HW_IF_POSITION);
+    }
+    for (const auto &joint : joint_names_)
+    {
+      config.names.push_back(joint + "/" + hardware_interface::HW_IF_VELOCITY);
+    }
+    return config;
+  }
+
+  bool MpcController::read_parameters(const PendingParameters &pending, MpcParameters &parameters,
+                                      std::string &error) const
+  {
+    parameters.step = pending.get("step").as_double();
+    parameters.weights.position = pending.get("position_weight").as_double();
+    parameters.weights.velocity = pending.get("velocity_weight").as_double();
+    parameters.weights.acceleration = pending.get("acceleration_weight").as_double();
+    parameters.rho = pending.get("rho").as_double();
+    parameters.max_iterations = static_cast<int>(pending.get("max_iterations").as_int());
+    parameters.tolerance = pending.get("tolerance").as_double();
+    parameters.resync_error = pending.get("resync_error").as_double();
+    if (parameters.step < 0.0 || !parameters.weights.valid() || parameters.rho <= 0.0 ||
+        parameters.max_iterations < 1 || parameters.tolerance < 0.0 || parameters.resync_error <= 0.0)
+    {
+      error = "MPC parameters out of range (weights and rho > 0, max_iterations >= 1).";
+      return false;
+    }
+
+    std::array<std::vector<double>, LIMIT_PARAMETERS.size()> values;
+    for (std::size_t i = 0; i < LIMIT_PARAMETERS.size(); i++)
+    {
+      values[i] = pending.get(LIMIT_PARAMETERS[i]).as_double_array();
+      if (values[i].size() != joint_names_.size())
+      {
+        error = std::string("Parameter '") + LIMIT_PARAMETERS[i] + "' needs " + std::to_string(joint_names_.size()) +
+                " values.";
+        return false;
+      }
+    }
+    parameters.limits.resize(joint_names_.size());
+    for (std::size_t i = 0; i < joint_names_.size(); i++)
+    {
+      MpcLimits &limits = parameters.limits[i];
+      limits.lower = values[0][i];
+      limits.upper = values[1][i];
+      limits.velocity = values[2][i];
+      limits.acceleration = values[3][i];
+      if (values[4][i] < 0.0 || values[5][i] < 0.0 || (values[4][i] > 0.0 && values[5][i] == 0.0))
+      {
+        error = "Step rate of joint '" + joint_names_[i] + "' out of range (max_step_rate >= 0, steps_per_rad > 0).";
+        return false;
+      }
+      // the steppers stall above their step rate, whatever max_velocity says
+      if (values[4][i] > 0.0)
+      {
+        limits.velocity = std::min(limits.velocity, values[4][i] / values[5][i]);
+      }
+      if (!limits.valid())
+      {
+        error = "Limits of joint '" + joint_names_[i] + "' out of range (lower < upper, maxima > 0).";
+        return false;
+      }
+    }
+    return true;
+  }
+
+  controller_interface::CallbackReturn MpcController::on_configure(const rclcpp_lifecycle::State &)
+  {
+    const auto node = get_node();
+    joint_names_ = node->get_parameter("joints").as_string_array();
+    if (joint_names_.empty())
+    {
+      RCLCPP_ERROR(node->get_logger(), "No joints given.");
+      return controller_interface::CallbackReturn::ERROR;
+    }
+
+    MpcParameters parameters;
+    std::string error;
+    if (!read_parameters(PendingParameters(*node, {}), parameters, error))
+    {
+      RCLCPP_ERROR(node->get_logger(), "%s", error.c_str());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    parameters_.writeFromNonRT(parameters);
+
+    // a change is checked as a whole before it is set, so the post-set callback
+    // only ever swaps in a valid set
+    validate_parameters_handle_ = node->add_on_set_parameters_callback(
+        [this](const std::vector<rclcpp::Parameter> &changed)
+        {
+          rcl_interfaces::msg::SetParametersResult result;
+          result.successful = true;
+          for (const auto &parameter : changed)
+          {
+            if (parameter.get_name() == "joints")
+            {
+              result.successful = false;
+              result.reason = "'joints' only changes on configure.";
+              return result;
+            }
+          }
+          MpcParameters candidate;
+          result.successful = read_parameters(PendingParameters(*get_node(), changed), candidate, result.reason);
+          return result;
+        });
+    update_parameters_handle_ = node->add_post_set_parameters_callback(
+        [this](const std::vector<rclcpp::Parameter> &)
+        {
+          MpcParameters updated;
+          std::string error;
+          if (read_parameters(PendingParameters(*get_node(), {}), updated, error))
+          {
+            parameters_.writeFromNonRT(updated);
+          }
+        });
+
+    // everything the loop touches is sized here
+    solvers_.assign(joint_names_.size(), JointMpc());
+    solver_braking_times_.assign(joint_names_.size(), 0.0);
+    solver_step_ = 0.0;
+    positions_.assign(joint_names_.size(), 0.0);
+    velocities_.assign(joint_names_.size(), 0.0);
+    last_reference_.assign(joint_names_.size(), 0.0);
+
+    // positions then velocities
+    reference_interfaces_.assign(2 * joint_names_.size(), std::numeric_limits<double>::quiet_NaN());
+    reference_sub_ = node->create_subscription<JointTrajectoryPoint>(
+        "~/joint_references", rclcpp::SystemDefaultsQoS(),
+        [this](const std::shared_ptr<JointTrajectoryPoint> msg)
+        {
+          if (msg->positions.size() == joint_names_.size() &&
+              (msg->velocities.empty() || msg->velocities.size() == joint_names_.size()))
+          {
+            reference_buffer_.writeFromNonRT(msg);
+          }
+        });
+
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  std::vector<hardware_interface::CommandInterface> MpcController::on_export_reference_interfaces()
+  {
+    std::vector<hardware_interface::CommandInterface> interfaces;
+    const std::size_t n = joint_names_.size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+      interfaces.emplace_back(get_node()->get_name(), joint_names_[i] + "/" + hardware_interface::HW_IF_POSITION,
+                              &reference_interfaces_[i]);
+    }
+    for (std::size_t i = 0; i < n; i++)
+    {
+      interfaces.emplace_back(get_node()->get_name(), joint_names_[i] + "/" + hardware_interface::HW_IF_VELOCITY,
+                              &reference_interfaces_[n + i]);
+    }
+    return interfaces;
+  }
+
+  bool MpcController::on_set_chained_mode(bool)
+  {
+    return true;
+  }
+
+  void MpcController::configure_solvers(const MpcParameters &parameters, double period)
+  {
+    double step = parameters.step;
+    if (step <= 0.0)
+    {
+      // a horizon of controller periods is far shorter than a stop, the plan would
+      // only ever see the next few milliseconds
+      step = period;
+      for (const auto &limits : parameters.limits)
+      {
+        step = std::max(step, limits.velocity / (limits.acceleration * MPC_HORIZON));
+      }
+    }
+    const bool rebuild_all =
+        step != solver_step_ || parameters.rho != solver_rho_ || !same_weights(parameters.weights, solver_weights_);
+    for (std::size_t i = 0; i < solvers_.size(); i++)
+    {
+      const double braking_time = parameters.limits[i].velocity / parameters.limits[i].acceleration;
+      if (rebuild_all || braking_time != solver_braking_times_[i])
+      {
+        solvers_[i].configure(step, parameters.weights, braking_time, parameters.rho);
+        solver_braking_times_[i] = braking_time;
+      }
+    }
+    solver_step_ = step;
+    solver_weights_ = parameters.weights;
+    solver_rho_ = parameters.rho;
+  }
+
+  controller_interface::CallbackReturn MpcController::on_activate(const rclcpp_lifecycle::State &)
+  {
+    configure_solvers(*parameters_.readFromNonRT(), 1.0 / get_update_rate());
+    const std::size_t n = joint_names_.size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+      positions_[i] = state_interfaces_[i].get_value();
+      velocities_[i] = state_interfaces_[n + i].get_value();
+      last_reference_[i] = positions_[i];
+      solvers_[i].reset();
+    }
+    max_solve_time_ = 0.0;
+    solves_ = 0;
+    unconverged_solves_ = 0;
+    std::fill(reference_interfaces_.begin(), reference_interfaces_.end(), std::numeric_limits<double>::quiet_NaN());
+    reference_buffer_.writeFromNonRT(nullptr);
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::CallbackReturn MpcController::on_deactivate(const rclcpp_lifecycle::State &)
+  {
+    RCLCPP_INFO(get_node()->get_logger(), "Longest solve of all joints: %.3f ms, %lu of %lu solves stopped at max_iterations.",
+                1e3 * max_solve_time_, static_cast<unsigned long>(unconverged_solves_),
+                static_cast<unsigned long>(solves_));
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::return_type MpcController::update_reference_from_subscribers(const rclcpp::Time &,
+                                                                                     const rclcpp::Duration &)
+  {
+    const auto reference = *reference_buffer_.readFromRT();
+    if (reference)
+    {
+      const std::size_t n = joint_names_.size();
+      std::copy(reference->positions.begin(), reference->positions.end(), reference_interfaces_.begin());
+      if (reference->velocities.empty())
+      {
+        std::fill(reference_interfaces_.begin() + n, reference_interfaces_.end(), 0.0);
+      }
+      else
+      {
+        std::copy(reference->velocities.begin(), reference->velocities.end(), reference_interfaces_.begin() + n);
+      }
+    }
+    return controller_interface::return_type::OK;
+  }
+
+  controller_interface::return_type MpcController::update_and_write_commands(const rclcpp::Time &,
+                                                                             const rclcpp::Duration &period)
+  {
+    const MpcParameters &parameters = *parameters_.readFromRT();
+    configure_solvers(parameters, 1.0 / get_update_rate());
+    const double dt = period.seconds();
+    const std::size_t n = joint_names_.size();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; i++)
+    {
+      const MpcLimits &limits = parameters.limits[i];
+      const double measured = state_interfaces_[i].get_value();
+      if (std::abs(measured - positions_[i]) > parameters.resync_error)
+      {
+        // blocked or pushed away, planning on from the command would wind up
+        positions_[i] = measured;
+        velocities_[i] = state_interfaces_[n + i].get_value();
+        solvers_[i].reset();
+      }
+
+      // until a reference arrives (or while the upstream controller writes none)
+      // hold the last one
+      if (std::isfinite(reference_interfaces_[i]))
+      {
+        last_reference_[i] = reference_interfaces_[i];
+      }
+      double reference_velocity = 0.0;
+      if (std::isfinite(reference_interfaces_[i]) && std::isfinite(reference_interfaces_[n + i]))
+      {
+        reference_velocity = reference_interfaces_[n + i];
+      }
+
+      const double acceleration = solvers_[i].solve(positions_[i], velocities_[i], last_reference_[i],
+                                                    reference_velocity, limits, parameters.max_iterations,
+                                                    parameters.tolerance);
+      solves_++;
+      if (!solvers_[i].converged())
+      {
+        unconverged_solves_++;
+      }
+      positions_[i] += velocities_[i] * dt + 0.5 * acceleration * dt * dt;
+      velocities_[i] = std::clamp(velocities_[i] + acceleration * dt, -limits.velocity, limits.velocity);
+      positions_[i] = std::clamp(positions_[i], std::min(limits.lower, measured), std::max(limits.upper, measured));
+      command_interfaces_[i].set_value(positions_[i]);
+    }
+    max_solve_time_ = std::max(max_solve_time_,
+                               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return controller_interface::return_type::OK;
+  }
+
+} // namespace robot_controllers
+
+#include "pluginlib/class_list_macros.hpp"
+
+PLUGINLIB_EXPORT_CLASS(robot_controllers::MpcController, controller_interface::ChainableControllerInterface)
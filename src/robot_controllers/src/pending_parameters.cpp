@@ -0,0 +1,38 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_controllers/pending_parameters.hpp"
+
+namespace robot_controllers
+{
+  PendingParameters::PendingParameters(const rclcpp_lifecycle::LifecycleNode &node,
+                                       const std::vector<rclcpp::Parameter> &changed)
+      : node_(node), changed_(changed)
+  {
+  }
+
+  rclcpp::Parameter PendingParameters::get(const std::string &name) const
+  {
+    // the last of several changes to one parameter is the one that sticks
+    for (auto it = changed_.rbegin(); it != changed_.rend(); ++it)
+    {
+      if (it->get_name() == name)
+      {
+        return *it;
+      }
+    }
+    return node_.get_parameter(name);
+  }
+
+} // namespace robot_controllers
@@ -0,0 +1,147 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_controllers/state_recorder.hpp"
+
+#include <algorithm>
+
+#include "hardware_interface/types/hardware_interface_type_values.hpp"
+
+namespace robot_controllers
+{
+  controller_interface::CallbackReturn StateRecorder::on_init()
+  {
+    auto_declare<std::vector<std::string>>("joints", std::vector<std::string>());
+    auto_declare<std::vector<std::string>>(
+        "interfaces", {hardware_interface::HW_IF_POSITION, hardware_interface::HW_IF_VELOCITY,
+                       hardware_interface::HW_IF_ACCELERATION, hardware_interface::HW_IF_EFFORT});
+    auto_declare<int>("buffer_size", 2000); // control cycles held while the publisher is busy
+    auto_declare<int>("batch_size", 100);   // control cycles per message
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::InterfaceConfiguration StateRecorder::command_interface_configuration() const
+  {
+    return {controller_interface::interface_configuration_type::NONE, {}};
+  }
+
+  controller_interface::InterfaceConfiguration StateRecorder::state_interface_configuration() const
+  {
+    // joint major, the order of the values in a sample
+    controller_interface::InterfaceConfiguration config;
+    config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+    for (const auto &joint : joint_names_)
+    {
+      for (const auto &interface : interface_names_)
+      {
+        config.names.push_back(joint + "/" + interface);
+      }
+    }
+    return config;
+  }
+
+  controller_interface::CallbackReturn StateRecorder::on_configure(const rclcpp_lifecycle::State &)
+  {
+    const auto node = get_node();
+    joint_names_ = node->get_parameter("joints").as_string_array();
+    interface_names_ = node->get_parameter("interfaces").as_string_array();
+    const int64_t buffer_size = node->get_parameter("buffer_size").as_int();
+    const int64_t batch_size = node->get_parameter("batch_size").as_int();
+    if (joint_names_.empty() || interface_names_.empty())
+    {
+      RCLCPP_ERROR(node->get_logger(), "Parameters 'joints' and 'interfaces' cannot be empty.");
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    if (batch_size < 1 || buffer_size < batch_size)
+    {
+      RCLCPP_ERROR(node->get_logger(), "Parameter 'batch_size' has to be at least 1 and at most 'buffer_size'.");
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    stride_ = joint_names_.size() * interface_names_.size();
+    batch_size_ = static_cast<std::size_t>(batch_size);
+    times_.assign(static_cast<std::size_t>(buffer_size), 0.0);
+    values_.assign(times_.size() * stride_, 0.0);
+
+    // the message is filled in the control loop, reserve everything up front
+    samples_pub_ = node->create_publisher<JointSamples>("~/samples", rclcpp::SystemDefaultsQoS());
+    samples_publisher_ = std::make_unique<realtime_tools::RealtimePublisher<JointSamples>>(samples_pub_);
+    samples_publisher_->lock();
+    auto &msg = samples_publisher_->msg_;
+    msg.joint_names = joint_names_;
+    msg.interface_names = interface_names_;
+    msg.time.resize(batch_size_);
+    msg.values.resize(batch_size_ * stride_);
+    samples_publisher_->unlock();
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::CallbackReturn StateRecorder::on_activate(const rclcpp_lifecycle::State &)
+  {
+    first_ = 0;
+    count_ = 0;
+    dropped_ = 0;
+    return controller_interface::CallbackReturn::SUCCESS;
+  }
+
+  controller_interface::return_type StateRecorder::update(const rclcpp::Time &time, const rclcpp::Duration &)
+  {
+    if (count_ < times_.size())
+    {
+      const std::size_t slot = (first_ + count_) % times_.size();
+      times_[slot] = time.seconds();
+      for (std::size_t k = 0; k < stride_; k++)
+      {
+        values_[slot * stride_ + k] = state_interfaces_[k].get_value();
+      }
+      count_++;
+    }
+    else
+    {
+      dropped_++;
+    }
+
+    if (count_ >= batch_size_)
+    {
+      publish_batch(time);
+    }
+    return controller_interface::return_type::OK;
+  }
+
+  void StateRecorder::publish_batch(const rclcpp::Time &time)
+  {
+    // the samples wait in the buffer if the publisher thread still holds the message
+    if (!samples_publisher_->trylock())
+    {
+      return;
+    }
+    auto &msg = samples_publisher_->msg_;
+    msg.header.stamp = time;
+    msg.dropped = dropped_;
+    for (std::size_t i = 0; i < batch_size_; i++)
+    {
+      const std::size_t slot = (first_ + i) % times_.size();
+      msg.time[i] = times_[slot];
+      std::copy(values_.begin() + slot * stride_, values_.begin() + (slot + 1) * stride_,
+                msg.values.begin() + i * stride_);
+    }
+    first_ = (first_ + batch_size_) % times_.size();
+    count_ -= batch_size_;
+    samples_publisher_->unlockAndPublish();
+  }
+
+} // namespace robot_controllers
+
+#include "pluginlib/class_list_macros.hpp"
+
+PLUGINLIB_EXPORT_CLASS(robot_controllers::StateRecorder, controller_interface::ControllerInterface)
@@ -0,0 +1,163 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "robot_controllers/joint_mpc.hpp"
+
+namespace
+{
+  using robot_controllers::JointMpc;
+  using robot_controllers::MpcLimits;
+  using robot_controllers::MpcWeights;
+
+  constexpr double PERIOD = 0.001; // s, the controller update rate
+  constexpr int MAX_ITERATIONS = 50;
+  constexpr double TOLERANCE = 1e-4;
+
+  MpcLimits test_limits()
+  {
+    MpcLimits limits;
+    limits.lower = -1.0;
+    limits.upper = 1.0;
+    limits.velocity = 1.0;
+    limits.acceleration = 5.0;
+    return limits;
+  }
+
+  // as MpcController::configure_solvers sets it up, the horizon at least a stop from
+  // full speed long
+  void configure(JointMpc &mpc, const MpcLimits &limits)
+  {
+    const double braking_time = limits.velocity / limits.acceleration;
+    mpc.configure(std::max(PERIOD, braking_time / robot_controllers::MPC_HORIZON), MpcWeights(), braking_time);
+  }
+
+  struct Reference
+  {
+    double position;
+    double velocity;
+  };
+
+  struct Trace
+  {
+    double lowest = 0.0;
+    double highest = 0.0;
+    double fastest = 0.0;    // rad/s
+    double hardest = 0.0;    // rad/s^2
+    double final_error = 0.0;
+    int unconverged = 0;
+    int solves = 0;
+    std::vector<double> solve_times; // us
+  };
+
+  // the joint as a double integrator under the MPC at the controller rate
+  Trace simulate(const std::function<Reference(double)> &reference, double duration, double start = 0.0)
+  {
+    const MpcLimits limits = test_limits();
+    JointMpc mpc;
+    configure(mpc, limits);
+    Trace run;
+    double position = start;
+    double velocity = 0.0;
+    run.lowest = run.highest = position;
+    for (int k = 0; k * PERIOD < duration; k++)
+    {
+      const Reference target = reference(k * PERIOD);
+      const auto begin = std::chrono::steady_clock::now();
+      const double acceleration =
+          mpc.solve(position, velocity, target.position, target.velocity, limits, MAX_ITERATIONS, TOLERANCE);
+      run.solve_times.push_back(
+          std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+      run.unconverged += !mpc.converged();
+      run.solves++;
+      position += velocity * PERIOD + 0.5 * acceleration * PERIOD * PERIOD;
+      velocity += acceleration * PERIOD;
+      run.lowest = std::min(run.lowest, position);
+      run.highest = std::max(run.highest, position);
+      run.fastest = std::max(run.fastest, std::abs(velocity));
+      run.hardest = std::max(run.hardest, std::abs(acceleration));
+      run.final_error = position - target.position;
+    }
+    return run;
+  }
+
+  void expect_inside_limits(const Trace &run)
+  {
+    const MpcLimits limits = test_limits();
+    EXPECT_GE(run.lowest, limits.lower - 1e-9);
+    EXPECT_LE(run.highest, limits.upper + 1e-9);
+    EXPECT_LE(run.fastest, limits.velocity + 1e-9);
+    EXPECT_LE(run.hardest, limits.acceleration + 1e-9);
+  }
+} // namespace
+
+// references past the limits, the joint at full speed towards them: the horizon
+// is shorter than the stop, the terminal braking row keeps it inside regardless
+TEST(JointMpc, StaysInsideThePositionLimits)
+{
+  const Trace step = simulate([](double) { return Reference{2.0, 0.0}; }, 4.0);
+  expect_inside_limits(step);
+  EXPECT_NEAR(step.highest, 1.0, 1e-3); // and gets to the limit
+
+  const Trace ramp = simulate([](double t) { return t < 1.5 / 0.9 ? Reference{0.9 * t, 0.9} : Reference{1.5, 0.0}; },
+                            4.0);
+  expect_inside_limits(ramp);
+
+  const Trace reversal = simulate([](double t) { return Reference{t < 2.0 ? 2.0 : -2.0, 0.0}; }, 6.0);
+  expect_inside_limits(reversal);
+  EXPECT_NEAR(reversal.lowest, -1.0, 1e-3);
+}
+
+TEST(JointMpc, SteersBackFromOutsideTheLimits)
+{
+  const Trace run = simulate([](double) { return Reference{0.0, 0.0}; }, 3.0, 1.2);
+  EXPECT_LE(run.highest, 1.2 + 1e-9);
+  EXPECT_NEAR(run.final_error, 0.0, 1e-3);
+}
+
+// a reference inside the limits is tracked closely and the QP converges nearly
+// every cycle; against the bounds it may stop at the iteration cap, the step
+// filter covers that
+TEST(JointMpc, TracksReachableReference)
+{
+  const Trace run = simulate([](double t) { return Reference{0.5 * std::sin(1.5 * t), 0.75 * std::cos(1.5 * t)}; },
+                           4.0);
+  expect_inside_limits(run);
+  EXPECT_LT(std::abs(run.final_error), 5e-3);
+  EXPECT_LT(run.unconverged, run.solves / 100);
+}
+
+// solve() runs inside the 1 kHz update, so it has to leave most of the period free
+TEST(JointMpc, SolvesWithinTheUpdatePeriod)
+{
+#ifndef NDEBUG
+  GTEST_SKIP() << "timing needs an optimised build";
+#endif
+  const Trace run = simulate([](double t) { return Reference{t < 2.0 ? 2.0 : -2.0, 0.0}; }, 4.0);
+  std::vector<double> times = run.solve_times;
+  std::sort(times.begin(), times.end());
+  const double median = times[times.size() / 2];
+  const double p99 = times[times.size() * 99 / 100];
+  RecordProperty("median_us", std::to_string(median));
+  RecordProperty("p99_us", std::to_string(p99));
+  EXPECT_LT(median, 0.1 * PERIOD * 1e6);
+  EXPECT_LT(p99, 0.5 * PERIOD * 1e6);
+}
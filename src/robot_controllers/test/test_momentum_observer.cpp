@@ -0,0 +1,184 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <Eigen/Cholesky>
+#include <gtest/gtest.h>
+
+#include "robot_controllers/momentum_observer.hpp"
+
+namespace
+{
+  using robot_controllers::JointVector;
+  using robot_controllers::MomentumObserver;
+  using robot_controllers::ObserverParameters;
+  using robot_dynamics::DynamicsModel;
+  using robot_dynamics::NUM_JOINTS;
+
+  constexpr double DT = 0.001;
+
+  // an arm of about the robot's size and mass, axes alternating like a 6R wrist arm
+  DynamicsModel test_model()
+  {
+    const std::array<Eigen::Vector3d, NUM_JOINTS> offsets = {
+        Eigen::Vector3d(0.0, 0.0, 0.18), Eigen::Vector3d(0.0, 0.0135, 0.0), Eigen::Vector3d(0.0, 0.0, 0.2),
+        Eigen::Vector3d(0.0, 0.0, 0.0), Eigen::Vector3d(0.0, 0.0, 0.19), Eigen::Vector3d(0.0, 0.0, 0.058)};
+    const std::array<Eigen::Vector3d, NUM_JOINTS> axes = {
+        Eigen::Vector3d::UnitZ(), Eigen::Vector3d::UnitY(), Eigen::Vector3d::UnitY(),
+        Eigen::Vector3d::UnitZ(), Eigen::Vector3d::UnitY(), Eigen::Vector3d::UnitZ()};
+    const std::array<double, NUM_JOINTS> masses = {1.5, 1.2, 0.9, 0.6, 0.4, 0.2};
+    std::array<robot_dynamics::Body, NUM_JOINTS> bodies;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      bodies[i].origin.translation() = offsets[i];
+      bodies[i].axis = axes[i];
+      bodies[i].inertia.mass = masses[i];
+      bodies[i].inertia.com = Eigen::Vector3d(0.01, 0.0, 0.5 * offsets[(i + 1) % NUM_JOINTS].z());
+      bodies[i].inertia.inertia = Eigen::Vector3d(2e-3, 2e-3, 1e-3).asDiagonal() * masses[i];
+    }
+    return DynamicsModel(bodies);
+  }
+
+  // the arm under computed torque tracking of a sine, pushed by an external torque
+  class SimulatedArm
+  {
+  public:
+    explicit SimulatedArm(const DynamicsModel &model)
+        : model_(model)
+    {
+    }
+
+    // motor torque of this cycle; steps the arm with it and the external torque
+    JointVector step(double t, const JointVector &external)
+    {
+      const JointVector reference = 0.5 * (JointVector() << 1.0, 0.6, -0.8, 1.2, 0.9, 1.5).finished() *
+                                    std::sin(2.0 * t);
+      const JointVector reference_velocity =
+          (JointVector() << 1.0, 0.6, -0.8, 1.2, 0.9, 1.5).finished() * std::cos(2.0 * t);
+      const JointVector reference_acceleration = -2.0 * reference;
+      const JointVector command =
+          reference_acceleration + 400.0 * (reference - q_) + 40.0 * (reference_velocity - qd_);
+      JointVector tau_motor;
+      model_.inverse_dynamics(q_, qd_, command, tau_motor);
+
+      // forward dynamics M qdd = tau + tau_ext - bias, semi implicit Euler
+      JointVector bias;
+      robot_dynamics::MassMatrix mass;
+      model_.inverse_dynamics(q_, qd_, JointVector::Zero(), bias);
+      model_.mass_matrix(q_, mass);
+      const JointVector qdd = mass.llt().solve(tau_motor + external - bias);
+      qd_ += qdd * DT;
+      q_ += qd_ * DT;
+      return tau_motor;
+    }
+
+    const JointVector &position() const { return q_; }
+
+  private:
+    const DynamicsModel &model_;
+    JointVector q_ = JointVector::Zero();
+    JointVector qd_ = JointVector::Zero();
+  };
+} // namespace
+
+// an exact model and a free arm leave nothing to estimate, however it moves
+TEST(MomentumObserver, StaysQuietWithoutContact)
+{
+  const DynamicsModel model = test_model();
+  SimulatedArm arm(model);
+  MomentumObserver observer(model);
+  const ObserverParameters parameters;
+  double largest = 0.0;
+  for (int k = 0; k < 2000; k++)
+  {
+    const JointVector tau_motor = arm.step(k * DT, JointVector::Zero());
+    EXPECT_FALSE(observer.update(arm.position(), tau_motor, DT, parameters)) << "t " << k * DT;
+    largest = std::max(largest, observer.external_torques().lpNorm<Eigen::Infinity>());
+  }
+  EXPECT_LT(largest, 0.1);
+}
+
+// a contact on one joint trips within a few time constants and is estimated on
+// that joint alone
+TEST(MomentumObserver, EstimatesAndDetectsContact)
+{
+  const DynamicsModel model = test_model();
+  SimulatedArm arm(model);
+  MomentumObserver observer(model);
+  const ObserverParameters parameters;
+  const JointVector external = 5.0 * JointVector::Unit(1);
+  const int contact = 1000;
+  int tripped = -1;
+  double threshold = 0.0;
+  for (int k = 0; k < 1500; k++)
+  {
+    const JointVector tau_motor = arm.step(k * DT, k >= contact ? external : JointVector::Zero());
+    if (observer.update(arm.position(), tau_motor, DT, parameters) && tripped < 0)
+    {
+      tripped = k;
+      threshold = observer.thresholds()[1];
+    }
+  }
+  ASSERT_GE(tripped, contact);
+  // the estimate rises as a first order lag at the gain and trips on crossing the
+  // threshold, raised by the joint speed; a few cycles for the discretisation
+  const double crossing = -std::log(1.0 - threshold / external[1]) / parameters.gain;
+  EXPECT_LE((tripped - contact) * DT, crossing + 5.0 * DT);
+  EXPECT_LT((observer.external_torques() - external).lpNorm<Eigen::Infinity>(), 0.05 * external.norm());
+}
+
+// the offset of a wrong payload is learnt as bias while nothing touches
+TEST(MomentumObserver, TracksModelBias)
+{
+  const DynamicsModel model = test_model();
+  SimulatedArm arm(model);
+  MomentumObserver observer(model);
+  ObserverParameters parameters;
+  parameters.bias_time_constant = 0.5;
+  const JointVector offset = 1.0 * JointVector::Unit(2); // below the threshold
+  for (int k = 0; k < 4000; k++)
+  {
+    observer.update(arm.position(), arm.step(k * DT, offset), DT, parameters);
+  }
+  EXPECT_LT(observer.external_torques().lpNorm<Eigen::Infinity>(), 0.05);
+}
+
+// the guard runs the observer inside the 1 kHz update
+TEST(MomentumObserver, UpdatesWithinMicroseconds)
+{
+#ifndef NDEBUG
+  GTEST_SKIP() << "timing needs an optimised build";
+#endif
+  const DynamicsModel model = test_model();
+  SimulatedArm arm(model);
+  MomentumObserver observer(model);
+  const ObserverParameters parameters;
+  std::vector<double> times;
+  for (int k = 0; k < 2000; k++)
+  {
+    const JointVector tau_motor = arm.step(k * DT, JointVector::Zero());
+    const auto begin = std::chrono::steady_clock::now();
+    observer.update(arm.position(), tau_motor, DT, parameters);
+    times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+  }
+  std::sort(times.begin(), times.end());
+  RecordProperty("median_us", std::to_string(times[times.size() / 2]));
+  RecordProperty("p99_us", std::to_string(times[times.size() * 99 / 100]));
+  EXPECT_LT(times[times.size() / 2], 0.05 * DT * 1e6);
+}
@@ -0,0 +1,130 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_DYNAMICS__DYNAMICS_MODEL_HPP_
+#define ROBOT_DYNAMICS__DYNAMICS_MODEL_HPP_
+
+#include <array>
+#include <string>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+namespace robot_dynamics
+{
+  constexpr std::size_t NUM_JOINTS = 6;
+
+  using JointVector = Eigen::Matrix<double, NUM_JOINTS, 1>;
+  using Jacobian = Eigen::Matrix<double, 6, NUM_JOINTS>; // linear (m/rad) over angular rows
+  using MassMatrix = Eigen::Matrix<double, NUM_JOINTS, NUM_JOINTS>;
+
+  // Rigid body in its own frame, SI units like the URDF
+  struct Inertia
+  {
+    double mass = 0.0;
+    Eigen::Vector3d com = Eigen::Vector3d::Zero();
+    Eigen::Matrix3d inertia = Eigen::Matrix3d::Zero(); // about the centre of mass
+
+    // Both bodies in the same frame, `other` moved there by `pose`
+    Inertia &merge(const Inertia &other, const Eigen::Isometry3d &pose = Eigen::Isometry3d::Identity());
+  };
+
+  // Moving body of the chain. `origin` is the joint frame in the parent body frame
+  // at q = 0, the joint rotates about `axis` (unit, in the body frame).
+  struct Body
+  {
+    Eigen::Isometry3d origin = Eigen::Isometry3d::Identity();
+    Eigen::Vector3d axis = Eigen::Vector3d::UnitZ();
+    Inertia inertia;
+  };
+
+  // Motion of the tip link frame, vectors in that frame
+  struct TipMotion
+  {
+    Eigen::Matrix3d rotation = Eigen::Matrix3d::Identity(); // tip frame in the root frame
+    Eigen::Vector3d angular_velocity = Eigen::Vector3d::Zero();
+    Eigen::Vector3d angular_acceleration = Eigen::Vector3d::Zero();
+    Eigen::Vector3d linear_acceleration = Eigen::Vector3d::Zero(); // of the frame origin, without gravity
+  };
+
+  // Recursive Newton-Euler inverse dynamics of the 6 joint serial chain. Everything
+  // is fixed size, so the calls do not allocate.
+  class DynamicsModel
+  {
+  public:
+    DynamicsModel() = default;
+    explicit DynamicsModel(const std::array<Body, NUM_JOINTS> &bodies,
+                           const std::array<std::string, NUM_JOINTS> &joint_names = {});
+
+    // Builds the chain from root_link to tip_link, fixed joints are folded into
+    // their neighbours. Throws std::runtime_error if the chain has no 6 revolute joints.
+    static DynamicsModel from_urdf(const std::string &urdf_xml, const std::string &root_link,
+                                   const std::string &tip_link);
+
+    // Joint torques (Nm) for the given motion, including gravity
+    void inverse_dynamics(const JointVector &q, const JointVector &qd, const JointVector &qdd,
+                          JointVector &tau) const;
+
+    // Split of inverse_dynamics, the holding torque and the torque to accelerate
+    void gravity_torques(const JointVector &q, JointVector &tau) const;
+    void motion_torques(const JointVector &q, const JointVector &qd, const JointVector &qdd,
+                        JointVector &tau) const;
+
+    // Joint space inertia matrix M(q), one column per joint from the motion torques
+    // of a unit acceleration
+    void mass_matrix(const JointVector &q, MassMatrix &M) const;
+
+    void tip_motion(const JointVector &q, const JointVector &qd, const JointVector &qdd, TipMotion &motion) const;
+
+    // Tip link frame in the root frame, and the geometric Jacobian of its origin
+    // with both parts in the root frame
+    Eigen::Isometry3d forward_kinematics(const JointVector &q) const;
+    void jacobian(const JointVector &q, Jacobian &J) const;
+
+    // Payload held by the tip: mass (kg), com in the tip link frame (m) and inertia
+    // about the com (kg m^2). Zero mass removes it.
+    void set_payload(double mass, const Eigen::Vector3d &com,
+                     const Eigen::Matrix3d &inertia = Eigen::Matrix3d::Zero());
+
+    // Gravity in the root frame, default (0, 0, -9.81)
+    void set_gravity(const Eigen::Vector3d &gravity);
+    const Eigen::Vector3d &gravity() const { return gravity_; }
+
+    const std::array<Body, NUM_JOINTS> &bodies() const { return bodies_; }
+    const std::array<std::string, NUM_JOINTS> &joint_names() const { return joint_names_; }
+
+  private:
+    Eigen::Matrix3d joint_rotation(std::size_t i, double q) const;
+    void rnea(const JointVector &q, const JointVector &qd, const JointVector &qdd, const Eigen::Vector3d &gravity,
+              JointVector &tau) const;
+
+    // R0 K and R0 K^2 of each joint, K the cross product matrix of the axis, so the
+    // joint rotation is R0 (I + sin(q) K + (1 - cos(q)) K^2)
+    struct JointTerms
+    {
+      Eigen::Matrix3d R0;
+      Eigen::Matrix3d R0K;
+      Eigen::Matrix3d R0K2;
+    };
+
+    std::array<Body, NUM_JOINTS> bodies_;
+    std::array<JointTerms, NUM_JOINTS> terms_;
+    std::array<std::string, NUM_JOINTS> joint_names_;
+    Inertia tip_inertia_; // last body without the payload
+    Eigen::Vector3d gravity_ = Eigen::Vector3d(0.0, 0.0, -9.81);
+  };
+
+} // namespace robot_dynamics
+
+#endif // ROBOT_DYNAMICS__DYNAMICS_MODEL_HPP_
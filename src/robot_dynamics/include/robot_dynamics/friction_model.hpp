@@ -0,0 +1,39 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_DYNAMICS__FRICTION_MODEL_HPP_
+#define ROBOT_DYNAMICS__FRICTION_MODEL_HPP_
+
+namespace robot_dynamics
+{
+  // Joint friction, Coulomb with a Stribeck peak at low speed plus viscous:
+  //   tau = (coulomb + (stribeck - coulomb) exp(-(v / stribeck_velocity)^2)) tanh(v / smoothing_velocity)
+  //         + viscous v
+  // tanh in place of sign(v) keeps the torque continuous through standstill.
+  struct FrictionParameters
+  {
+    double coulomb = 0.0;             // Nm
+    double stribeck = 0.0;            // Nm, breakaway torque
+    double viscous = 0.0;             // Nm s/rad
+    double stribeck_velocity = 0.1;   // rad/s
+    double smoothing_velocity = 0.01; // rad/s
+
+    bool valid() const;
+    // Nm the motor spends on friction at velocity, with the sign of the velocity
+    double torque(double velocity) const;
+  };
+
+} // namespace robot_dynamics
+
+#endif // ROBOT_DYNAMICS__FRICTION_MODEL_HPP_
@@ -0,0 +1,217 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_dynamics/dynamics_model.hpp"
+
+#include <cmath>
+
+namespace robot_dynamics
+{
+  namespace
+  {
+    // Inertia of a point mass at d about the origin
+    Eigen::Matrix3d steiner(double mass, const Eigen::Vector3d &d)
+    {
+      return mass * (d.squaredNorm() * Eigen::Matrix3d::Identity() - d * d.transpose());
+    }
+  } // namespace
+
+  Inertia &Inertia::merge(const Inertia &other, const Eigen::Isometry3d &pose)
+  {
+    const double total = mass + other.mass;
+    if (total <= 0.0)
+    {
+      return *this;
+    }
+
+    const Eigen::Vector3d other_com = pose * other.com;
+    const Eigen::Matrix3d other_inertia = pose.linear() * other.inertia * pose.linear().transpose();
+    const Eigen::Vector3d com_total = (mass * com + other.mass * other_com) / total;
+
+    inertia = inertia + steiner(mass, com - com_total) + other_inertia + steiner(other.mass, other_com - com_total);
+    com = com_total;
+    mass = total;
+    return *this;
+  }
+
+  DynamicsModel::DynamicsModel(const std::array<Body, NUM_JOINTS> &bodies,
+                               const std::array<std::string, NUM_JOINTS> &joint_names)
+      : bodies_(bodies), joint_names_(joint_names), tip_inertia_(bodies[NUM_JOINTS - 1].inertia)
+  {
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      const Eigen::Vector3d &a = bodies_[i].axis;
+      Eigen::Matrix3d K;
+      K << 0.0, -a.z(), a.y(),
+          a.z(), 0.0, -a.x(),
+          -a.y(), a.x(), 0.0;
+      terms_[i].R0 = bodies_[i].origin.linear();
+      terms_[i].R0K = terms_[i].R0 * K;
+      terms_[i].R0K2 = terms_[i].R0K * K;
+    }
+  }
+
+  void DynamicsModel::set_gravity(const Eigen::Vector3d &gravity)
+  {
+    gravity_ = gravity;
+  }
+
+  void DynamicsModel::set_payload(double mass, const Eigen::Vector3d &com, const Eigen::Matrix3d &inertia)
+  {
+    Inertia payload;
+    payload.mass = mass;
+    payload.com = com;
+    payload.inertia = inertia;
+    bodies_[NUM_JOINTS - 1].inertia = tip_inertia_;
+    bodies_[NUM_JOINTS - 1].inertia.merge(payload);
+  }
+
+  void DynamicsModel::inverse_dynamics(const JointVector &q, const JointVector &qd, const JointVector &qdd,
+                                       JointVector &tau) const
+  {
+    rnea(q, qd, qdd, gravity_, tau);
+  }
+
+  void DynamicsModel::gravity_torques(const JointVector &q, JointVector &tau) const
+  {
+    rnea(q, JointVector::Zero(), JointVector::Zero(), gravity_, tau);
+  }
+
+  void DynamicsModel::motion_torques(const JointVector &q, const JointVector &qd, const JointVector &qdd,
+                                     JointVector &tau) const
+  {
+    rnea(q, qd, qdd, Eigen::Vector3d::Zero(), tau);
+  }
+
+  void DynamicsModel::mass_matrix(const JointVector &q, MassMatrix &M) const
+  {
+    JointVector column;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      rnea(q, JointVector::Zero(), JointVector::Unit(i), Eigen::Vector3d::Zero(), column);
+      M.col(i) = column;
+    }
+  }
+
+  Eigen::Matrix3d DynamicsModel::joint_rotation(std::size_t i, double q) const
+  {
+    const JointTerms &terms = terms_[i];
+    return terms.R0 + std::sin(q) * terms.R0K + (1.0 - std::cos(q)) * terms.R0K2;
+  }
+
+  Eigen::Isometry3d DynamicsModel::forward_kinematics(const JointVector &q) const
+  {
+    Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      T.translation() += T.linear() * bodies_[i].origin.translation();
+      T.linear() = T.linear() * joint_rotation(i, q[i]);
+    }
+    return T;
+  }
+
+  void DynamicsModel::jacobian(const JointVector &q, Jacobian &J) const
+  {
+    std::array<Eigen::Vector3d, NUM_JOINTS> axes;
+    std::array<Eigen::Vector3d, NUM_JOINTS> origins;
+    Eigen::Matrix3d R = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d p = Eigen::Vector3d::Zero();
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      p += R * bodies_[i].origin.translation();
+      R = R * joint_rotation(i, q[i]);
+      origins[i] = p;
+      axes[i] = R * bodies_[i].axis;
+    }
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      J.block<3, 1>(0, i) = axes[i].cross(p - origins[i]);
+      J.block<3, 1>(3, i) = axes[i];
+    }
+  }
+
+  void DynamicsModel::tip_motion(const JointVector &q, const JointVector &qd, const JointVector &qdd,
+                                 TipMotion &motion) const
+  {
+    motion = TipMotion();
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      const Body &body = bodies_[i];
+      const Eigen::Matrix3d R = joint_rotation(i, q[i]);
+      const Eigen::Vector3d &p = body.origin.translation();
+      const Eigen::Vector3d &omega = motion.angular_velocity;
+      const Eigen::Vector3d &omega_dot = motion.angular_acceleration;
+
+      motion.linear_acceleration =
+          R.transpose() * (motion.linear_acceleration + omega_dot.cross(p) + omega.cross(omega.cross(p)));
+      const Eigen::Vector3d omega_parent = R.transpose() * omega;
+      motion.angular_acceleration =
+          R.transpose() * omega_dot + omega_parent.cross(body.axis * qd[i]) + body.axis * qdd[i];
+      motion.angular_velocity = omega_parent + body.axis * qd[i];
+      motion.rotation = motion.rotation * R;
+    }
+  }
+
+  void DynamicsModel::rnea(const JointVector &q, const JointVector &qd, const JointVector &qdd,
+                           const Eigen::Vector3d &gravity, JointVector &tau) const
+  {
+    // Quantities of body i are expressed in its own frame. R[i] rotates body i
+    // vectors into its parent, p[i] is the joint origin in the parent.
+    std::array<Eigen::Matrix3d, NUM_JOINTS> R;
+    std::array<Eigen::Vector3d, NUM_JOINTS> forces;
+    std::array<Eigen::Vector3d, NUM_JOINTS> moments;
+
+    // gravity enters as an upward acceleration of the base
+    Eigen::Vector3d omega = Eigen::Vector3d::Zero();
+    Eigen::Vector3d omega_dot = Eigen::Vector3d::Zero();
+    Eigen::Vector3d acceleration = -gravity;
+
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      const Body &body = bodies_[i];
+      R[i] = joint_rotation(i, q[i]);
+      const auto Rt = R[i].transpose();
+      const Eigen::Vector3d &p = body.origin.translation();
+
+      acceleration = Rt * (acceleration + omega_dot.cross(p) + omega.cross(omega.cross(p)));
+      const Eigen::Vector3d omega_parent = Rt * omega;
+      omega = omega_parent + body.axis * qd[i];
+      omega_dot = Rt * omega_dot + omega_parent.cross(body.axis * qd[i]) + body.axis * qdd[i];
+
+      const Inertia &inertia = body.inertia;
+      const Eigen::Vector3d com_acceleration =
+          acceleration + omega_dot.cross(inertia.com) + omega.cross(omega.cross(inertia.com));
+      forces[i] = inertia.mass * com_acceleration;
+      moments[i] = inertia.inertia * omega_dot + omega.cross(inertia.inertia * omega);
+    }
+
+    Eigen::Vector3d f = Eigen::Vector3d::Zero();
+    Eigen::Vector3d n = Eigen::Vector3d::Zero();
+    for (std::size_t k = NUM_JOINTS; k-- > 0;)
+    {
+      // f, n are the wrench body k + 1 takes from body k, in frame k + 1
+      Eigen::Vector3d f_child = Eigen::Vector3d::Zero();
+      Eigen::Vector3d n_child = Eigen::Vector3d::Zero();
+      if (k + 1 < NUM_JOINTS)
+      {
+        f_child = R[k + 1] * f;
+        n_child = R[k + 1] * n + bodies_[k + 1].origin.translation().cross(f_child);
+      }
+      n = moments[k] + n_child + bodies_[k].inertia.com.cross(forces[k]);
+      f = forces[k] + f_child;
+      tau[k] = n.dot(bodies_[k].axis);
+    }
+  }
+
+} // namespace robot_dynamics
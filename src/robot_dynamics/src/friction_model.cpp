@@ -0,0 +1,33 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_dynamics/friction_model.hpp"
+
+#include <cmath>
+
+namespace robot_dynamics
+{
+  bool FrictionParameters::valid() const
+  {
+    return coulomb >= 0.0 && stribeck >= 0.0 && viscous >= 0.0 && stribeck_velocity > 0.0 && smoothing_velocity > 0.0;
+  }
+
+  double FrictionParameters::torque(double velocity) const
+  {
+    const double ratio = velocity / stribeck_velocity;
+    const double static_part = (stribeck - coulomb) * std::exp(-ratio * ratio);
+    return (coulomb + static_part) * std::tanh(velocity / smoothing_velocity) + viscous * velocity;
+  }
+
+} // namespace robot_dynamics
@@ -0,0 +1,143 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_dynamics/dynamics_model.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <urdf/model.h>
+
+namespace robot_dynamics
+{
+  namespace
+  {
+    Eigen::Isometry3d to_isometry(const urdf::Pose &pose)
+    {
+      Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+      T.linear() = Eigen::Quaterniond(pose.rotation.w, pose.rotation.x, pose.rotation.y, pose.rotation.z)
+                       .toRotationMatrix();
+      T.translation() << pose.position.x, pose.position.y, pose.position.z;
+      return T;
+    }
+
+    // Inertia of the link in the link frame
+    Inertia link_inertia(const urdf::Link &link)
+    {
+      Inertia result;
+      if (!link.inertial)
+      {
+        return result;
+      }
+      const urdf::Inertial &inertial = *link.inertial;
+      const Eigen::Isometry3d origin = to_isometry(inertial.origin);
+      Eigen::Matrix3d I;
+      I << inertial.ixx, inertial.ixy, inertial.ixz,
+          inertial.ixy, inertial.iyy, inertial.iyz,
+          inertial.ixz, inertial.iyz, inertial.izz;
+      result.mass = inertial.mass;
+      result.com = origin.translation();
+      result.inertia = origin.linear() * I * origin.linear().transpose();
+      return result;
+    }
+
+    // Links rigidly attached below the tip (flange, tool frames) move with it
+    void merge_fixed_children(const urdf::Model &model, const urdf::Link &link, const Eigen::Isometry3d &pose,
+                              Inertia &inertia)
+    {
+      for (const auto &joint : link.child_joints)
+      {
+        if (joint->type != urdf::Joint::FIXED)
+        {
+          continue;
+        }
+        const auto child = model.getLink(joint->child_link_name);
+        const Eigen::Isometry3d child_pose = pose * to_isometry(joint->parent_to_joint_origin_transform);
+        inertia.merge(link_inertia(*child), child_pose);
+        merge_fixed_children(model, *child, child_pose, inertia);
+      }
+    }
+  } // namespace
+
+  DynamicsModel DynamicsModel::from_urdf(const std::string &urdf_xml, const std::string &root_link,
+                                         const std::string &tip_link)
+  {
+    urdf::Model model;
+    if (!model.initString(urdf_xml))
+    {
+      throw std::runtime_error("Failed to parse the URDF.");
+    }
+    const auto root = model.getLink(root_link);
+    const auto tip = model.getLink(tip_link);
+    if (!root || !tip)
+    {
+      throw std::runtime_error("URDF has no link '" + (root ? tip_link : root_link) + "'.");
+    }
+
+    std::vector<urdf::JointConstSharedPtr> chain;
+    for (auto link = tip; link != root; link = model.getLink(link->parent_joint->parent_link_name))
+    {
+      if (!link->parent_joint)
+      {
+        throw std::runtime_error("'" + tip_link + "' is not below '" + root_link + "'.");
+      }
+      chain.push_back(link->parent_joint);
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    std::array<Body, NUM_JOINTS> bodies;
+    std::array<std::string, NUM_JOINTS> joint_names;
+    std::size_t count = 0;
+    // fixed joints since the last moving body, in that body's frame
+    Eigen::Isometry3d pending = Eigen::Isometry3d::Identity();
+    for (const auto &joint : chain)
+    {
+      const Eigen::Isometry3d origin = to_isometry(joint->parent_to_joint_origin_transform);
+      const auto child = model.getLink(joint->child_link_name);
+      if (joint->type == urdf::Joint::FIXED)
+      {
+        pending = pending * origin;
+        if (count > 0)
+        {
+          bodies[count - 1].inertia.merge(link_inertia(*child), pending);
+        }
+        continue;
+      }
+      if (joint->type != urdf::Joint::REVOLUTE && joint->type != urdf::Joint::CONTINUOUS)
+      {
+        throw std::runtime_error("Joint '" + joint->name + "' is not revolute.");
+      }
+      if (count == NUM_JOINTS)
+      {
+        throw std::runtime_error("Chain to '" + tip_link + "' has more than 6 joints.");
+      }
+
+      joint_names[count] = joint->name;
+      Body &body = bodies[count++];
+      body.origin = pending * origin;
+      body.axis = Eigen::Vector3d(joint->axis.x, joint->axis.y, joint->axis.z).normalized();
+      body.inertia = link_inertia(*child);
+      pending = Eigen::Isometry3d::Identity();
+    }
+    if (count != NUM_JOINTS)
+    {
+      throw std::runtime_error("Chain to '" + tip_link + "' has fewer than 6 joints.");
+    }
+
+    merge_fixed_children(model, *tip, pending, bodies[NUM_JOINTS - 1].inertia);
+    return DynamicsModel(bodies, joint_names);
+  }
+
+} // namespace robot_dynamics
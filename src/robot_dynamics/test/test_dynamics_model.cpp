@@ -0,0 +1,223 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cmath>
+
+#include <Eigen/Cholesky>
+#include <gtest/gtest.h>
+
+#include "robot_dynamics/dynamics_model.hpp"
+
+namespace
+{
+  using robot_dynamics::Body;
+  using robot_dynamics::DynamicsModel;
+  using robot_dynamics::JointVector;
+  using robot_dynamics::MassMatrix;
+  using robot_dynamics::NUM_JOINTS;
+
+  // an arm shaped chain with tilted axes and off axis centres of mass, so no term of
+  // the dynamics vanishes by symmetry
+  std::array<Body, NUM_JOINTS> test_bodies()
+  {
+    const std::array<Eigen::Vector3d, NUM_JOINTS> offsets = {
+        Eigen::Vector3d(0.0, 0.0, 0.1), Eigen::Vector3d(0.02, 0.0, 0.15), Eigen::Vector3d(0.0, 0.03, 0.3),
+        Eigen::Vector3d(0.25, 0.0, 0.02), Eigen::Vector3d(0.0, 0.0, 0.08), Eigen::Vector3d(0.05, 0.01, 0.0)};
+    const std::array<Eigen::Vector3d, NUM_JOINTS> axes = {
+        Eigen::Vector3d(0.0, 0.0, 1.0), Eigen::Vector3d(0.0, 1.0, 0.1), Eigen::Vector3d(0.0, 1.0, 0.0),
+        Eigen::Vector3d(1.0, 0.0, 0.2), Eigen::Vector3d(0.1, 1.0, 0.0), Eigen::Vector3d(1.0, 0.0, 0.0)};
+    std::array<Body, NUM_JOINTS> bodies;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      Body &body = bodies[i];
+      body.origin.translation() = offsets[i];
+      body.origin.linear() = Eigen::AngleAxisd(0.1 * i, Eigen::Vector3d(1.0, 0.5, 0.2).normalized()).toRotationMatrix();
+      body.axis = axes[i].normalized();
+      body.inertia.mass = 2.0 - 0.25 * i;
+      body.inertia.com = Eigen::Vector3d(0.03, -0.01 * i, 0.05);
+      Eigen::Matrix3d inertia;
+      inertia << 0.02, 0.001, -0.002,
+          0.001, 0.015, 0.0015,
+          -0.002, 0.0015, 0.01;
+      body.inertia.inertia = inertia / (1.0 + i);
+    }
+    return bodies;
+  }
+
+  JointVector test_position()
+  {
+    return (JointVector() << 0.3, -0.7, 1.1, 0.4, -0.9, 0.6).finished();
+  }
+
+  JointVector test_velocity()
+  {
+    return (JointVector() << 0.8, -0.5, 1.2, -1.5, 0.9, 2.0).finished();
+  }
+
+  JointVector test_acceleration()
+  {
+    return (JointVector() << -1.0, 2.5, 0.7, 3.0, -2.0, 1.5).finished();
+  }
+
+  // centres of mass in the root frame, chained with Eigen apart from the model
+  std::array<Eigen::Vector3d, NUM_JOINTS> centres_of_mass(const std::array<Body, NUM_JOINTS> &bodies,
+                                                          const JointVector &q)
+  {
+    std::array<Eigen::Vector3d, NUM_JOINTS> centres;
+    Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      pose = pose * bodies[i].origin * Eigen::AngleAxisd(q[i], bodies[i].axis);
+      centres[i] = pose * bodies[i].inertia.com;
+    }
+    return centres;
+  }
+
+  double kinetic_energy(const DynamicsModel &model, const JointVector &q, const JointVector &qd)
+  {
+    MassMatrix M;
+    model.mass_matrix(q, M);
+    return 0.5 * qd.dot(M * qd);
+  }
+} // namespace
+
+TEST(DynamicsModel, InverseDynamicsIsMassMatrixTimesAccelerationPlusBias)
+{
+  const DynamicsModel model(test_bodies());
+  const JointVector q = test_position();
+  const JointVector qd = test_velocity();
+  const JointVector qdd = test_acceleration();
+
+  JointVector tau;
+  JointVector bias;
+  MassMatrix M;
+  model.inverse_dynamics(q, qd, qdd, tau);
+  model.inverse_dynamics(q, qd, JointVector::Zero(), bias);
+  model.mass_matrix(q, M);
+  EXPECT_LT((tau - (M * qdd + bias)).lpNorm<Eigen::Infinity>(), 1e-10);
+
+  JointVector gravity;
+  JointVector motion;
+  model.gravity_torques(q, gravity);
+  model.motion_torques(q, qd, qdd, motion);
+  EXPECT_LT((tau - (gravity + motion)).lpNorm<Eigen::Infinity>(), 1e-10);
+}
+
+TEST(DynamicsModel, MassMatrixIsSymmetricPositiveDefinite)
+{
+  const DynamicsModel model(test_bodies());
+  MassMatrix M;
+  model.mass_matrix(test_position(), M);
+  EXPECT_LT((M - M.transpose()).lpNorm<Eigen::Infinity>(), 1e-12);
+  EXPECT_EQ(M.llt().info(), Eigen::Success);
+}
+
+// without gravity the joint power goes into kinetic energy, d/dt (qd^T M qd / 2) = qd^T tau,
+// which holds only with the right Coriolis and centrifugal terms
+TEST(DynamicsModel, TorquesBalanceKineticEnergy)
+{
+  DynamicsModel model(test_bodies());
+  model.set_gravity(Eigen::Vector3d::Zero());
+  const JointVector q = test_position();
+  const JointVector qd = test_velocity();
+  const JointVector qdd = test_acceleration();
+
+  JointVector tau;
+  model.inverse_dynamics(q, qd, qdd, tau);
+  const double h = 1e-5;
+  const double energy_rate =
+      (kinetic_energy(model, q + h * qd + 0.5 * h * h * qdd, qd + h * qdd) -
+       kinetic_energy(model, q - h * qd + 0.5 * h * h * qdd, qd - h * qdd)) /
+      (2.0 * h);
+  EXPECT_NEAR(energy_rate, qd.dot(tau), 1e-6 * std::abs(qd.dot(tau)));
+}
+
+// the holding torque is the gradient of the potential energy -sum m g^T c
+TEST(DynamicsModel, GravityTorquesArePotentialGradient)
+{
+  const std::array<Body, NUM_JOINTS> bodies = test_bodies();
+  const DynamicsModel model(bodies);
+  const JointVector q = test_position();
+  const auto potential = [&](const JointVector &position)
+  {
+    double energy = 0.0;
+    const auto centres = centres_of_mass(bodies, position);
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      energy -= bodies[i].inertia.mass * model.gravity().dot(centres[i]);
+    }
+    return energy;
+  };
+
+  JointVector tau;
+  model.gravity_torques(q, tau);
+  const double h = 1e-6;
+  for (std::size_t i = 0; i < NUM_JOINTS; i++)
+  {
+    const JointVector dq = h * JointVector::Unit(i);
+    EXPECT_NEAR(tau[i], (potential(q + dq) - potential(q - dq)) / (2.0 * h), 1e-6) << "joint " << i;
+  }
+}
+
+TEST(DynamicsModel, JacobianMatchesForwardKinematics)
+{
+  const DynamicsModel model(test_bodies());
+  const JointVector q = test_position();
+  robot_dynamics::Jacobian J;
+  model.jacobian(q, J);
+
+  const double h = 1e-6;
+  for (std::size_t i = 0; i < NUM_JOINTS; i++)
+  {
+    const JointVector dq = h * JointVector::Unit(i);
+    const Eigen::Isometry3d forward = model.forward_kinematics(q + dq);
+    const Eigen::Isometry3d backward = model.forward_kinematics(q - dq);
+    const Eigen::Vector3d linear = (forward.translation() - backward.translation()) / (2.0 * h);
+    const Eigen::AngleAxisd turn(forward.linear() * backward.linear().transpose());
+    const Eigen::Vector3d angular = turn.angle() * turn.axis() / (2.0 * h);
+    EXPECT_LT((J.block<3, 1>(0, i) - linear).norm(), 1e-8) << "joint " << i;
+    EXPECT_LT((J.block<3, 1>(3, i) - angular).norm(), 1e-8) << "joint " << i;
+  }
+}
+
+// a point mass payload adds the Jacobian transpose of its weight at the payload
+TEST(DynamicsModel, PayloadAddsItsWeight)
+{
+  DynamicsModel model(test_bodies());
+  const JointVector q = test_position();
+  JointVector without;
+  model.gravity_torques(q, without);
+
+  const double mass = 1.5;
+  const Eigen::Vector3d com(0.02, -0.03, 0.1);
+  model.set_payload(mass, com);
+  JointVector with;
+  model.gravity_torques(q, with);
+
+  robot_dynamics::Jacobian J;
+  model.jacobian(q, J);
+  const Eigen::Vector3d lever = model.forward_kinematics(q).linear() * com;
+  JointVector expected;
+  for (std::size_t i = 0; i < NUM_JOINTS; i++)
+  {
+    const Eigen::Vector3d point_velocity = J.block<3, 1>(0, i) + J.block<3, 1>(3, i).cross(lever);
+    expected[i] = -mass * point_velocity.dot(model.gravity());
+  }
+  EXPECT_LT((with - without - expected).lpNorm<Eigen::Infinity>(), 1e-10);
+
+  model.set_payload(0.0, Eigen::Vector3d::Zero());
+  model.gravity_torques(q, with);
+  EXPECT_LT((with - without).lpNorm<Eigen::Infinity>(), 1e-12);
+}
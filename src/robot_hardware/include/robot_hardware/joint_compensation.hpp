@@ -0,0 +1,55 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_HARDWARE__JOINT_COMPENSATION_HPP_
+#define ROBOT_HARDWARE__JOINT_COMPENSATION_HPP_
+
+namespace robot_hardware
+{
+  struct JointCompensationParameters
+  {
+    double backlash = 0.0;  // rad, total play of the transmission
+    double takeup = 0.002;  // rad of command travel to cross the play after a reversal
+    double stiffness = 0.0; // Nm/rad of the transmission, 0 treats it as rigid
+
+    bool valid() const;
+  };
+
+  // Maps a joint position command to the motor command that puts the joint there.
+  // Moving up the motor has to lead by half the backlash, moving down it has to
+  // trail by half; a reversal moves the offset across over takeup of command
+  // travel on a smoothstep, so the motor does not jump. The transmission twists
+  // by the holding torque over its stiffness, which is added on top.
+  class JointCompensation
+  {
+  public:
+    explicit JointCompensation(const JointCompensationParameters &parameters = JointCompensationParameters());
+
+    const JointCompensationParameters &parameters() const { return parameters_; }
+    void set_parameters(const JointCompensationParameters &parameters) { parameters_ = parameters; }
+
+    // direction unknown, so no backlash offset until the joint moves
+    void reset(double command);
+    // torque the transmission holds, Nm
+    double motor_command(double command, double torque);
+
+  private:
+    JointCompensationParameters parameters_;
+    double previous_command_ = 0.0;
+    double side_ = 0.0; // -1 trailing to +1 leading, where the motor sits in the play
+  };
+
+} // namespace robot_hardware
+
+#endif // ROBOT_HARDWARE__JOINT_COMPENSATION_HPP_
@@ -0,0 +1,65 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_HARDWARE__JOINT_FILTER_HPP_
+#define ROBOT_HARDWARE__JOINT_FILTER_HPP_
+
+#include <cmath>
+
+#include <Eigen/Core>
+
+namespace robot_hardware
+{
+  struct JointFilterParameters
+  {
+    double jerk_noise = 50.0;                              // rad^2/s^5, spectral density of the jerk
+    double encoder_resolution = 2.0 * M_PI / 4096.0;       // rad per count, 12 bit AS5600
+    double encoder_noise = 1e-3;                           // rad, on top of the quantisation
+    double model_noise = 5e-3;                             // rad, the stepper's error to the motor model
+    double motor_time_constant = 0.02;                     // s, lag of the motor behind its step command
+
+    bool valid() const;
+  };
+
+  // Kalman filter of one joint with position, velocity and acceleration as state
+  // and a constant acceleration (white jerk) process. Each cycle fuses the encoder
+  // reading and the motor model, a first order lag of the commanded step position,
+  // as two position measurements. Both are scalar updates, so a cycle costs the
+  // same fixed handful of 3x3 operations.
+  class JointFilter
+  {
+  public:
+    explicit JointFilter(const JointFilterParameters &parameters = JointFilterParameters());
+
+    // at rest at position, with the uncertainty of one encoder reading
+    void reset(double position);
+    void update(double encoder, double command, double dt);
+
+    double position() const { return x_[0]; }
+    double velocity() const { return x_[1]; }
+    double acceleration() const { return x_[2]; }
+
+  private:
+    void correct(double measurement, double variance);
+
+    JointFilterParameters parameters_;
+    double encoder_variance_;
+    Eigen::Vector3d x_ = Eigen::Vector3d::Zero();
+    Eigen::Matrix3d P_ = Eigen::Matrix3d::Zero();
+    double model_position_ = 0.0;
+  };
+
+} // namespace robot_hardware
+
+#endif // ROBOT_HARDWARE__JOINT_FILTER_HPP_
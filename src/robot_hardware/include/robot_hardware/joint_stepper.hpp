@@ -0,0 +1,71 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROBOT_HARDWARE__JOINT_STEPPER_HPP_
+#define ROBOT_HARDWARE__JOINT_STEPPER_HPP_
+
+#include <cstdint>
+
+namespace robot_hardware
+{
+  struct StepperParameters
+  {
+    double steps_per_rad = 0.0;         // microsteps per rad of motor command, 0 sends it unquantised
+    double max_step_rate = 0.0;         // microsteps/s the motor keeps up with, 0 for no limit
+    double max_step_acceleration = 0.0; // microsteps/s^2 before it stalls, 0 for no limit
+
+    bool enabled() const { return steps_per_rad > 0.0; }
+    bool valid() const;
+  };
+
+  // Turns a motor position command into a whole number of microsteps per cycle.
+  // The command is followed at most at max_step_rate, and speed changes by at
+  // most max_step_acceleration, braking early enough to stop on the command. The
+  // fractional step left over each cycle is carried into the next (error
+  // diffusion), so slow moves are not rounded away and the motor stays within half
+  // a step of the limited motion. stall_risk() is the share of the step rate or
+  // acceleration limit the command's own motion needs, above 1 the motor would
+  // stall following it and falls behind instead.
+  class StepperAxis
+  {
+  public:
+    explicit StepperAxis(const StepperParameters &parameters = StepperParameters());
+
+    const StepperParameters &parameters() const { return parameters_; }
+
+    // at rest on the step nearest command
+    void reset(double command);
+    // microsteps to issue this cycle
+    std::int64_t update(double command, double dt);
+
+    std::int64_t steps() const { return steps_; }
+    // rad, where the issued steps put the motor
+    double position() const;
+    // rad, command minus position(), the rounding plus what the limits held back
+    double error(double command) const { return command - position(); }
+    double stall_risk() const { return stall_risk_; }
+
+  private:
+    StepperParameters parameters_;
+    std::int64_t steps_ = 0;
+    double carry_ = 0.0;    // fraction of a step not yet issued
+    double velocity_ = 0.0; // microsteps/s of the limited motion
+    double previous_command_ = 0.0;
+    double command_velocity_ = 0.0; // microsteps/s
+    double stall_risk_ = 0.0;
+  };
+
+} // namespace robot_hardware
+
+#endif // ROBOT_HARDWARE__JOINT_STEPPER_HPP_
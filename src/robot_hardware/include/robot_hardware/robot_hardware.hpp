@@ -15,6 +15,7 @@
 #ifndef robot_HARDWARE__robot_HARDWARE_HPP_
 #define robot_HARDWARE__robot_HARDWARE_HPP_
 
+#include "array"
 #include "string"
 #include "unordered_map"
 #include "vector"
@@ -24,6 +25,11 @@
 #include "hardware_interface/system_interface.hpp"
 #include "hardware_interface/types/hardware_interface_return_values.hpp"
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "robot_dynamics/dynamics_model.hpp"
+#include "robot_dynamics/friction_model.hpp"
+#include "robot_hardware/joint_compensation.hpp"
+#include "robot_hardware/joint_filter.hpp"
+#include "robot_hardware/joint_stepper.hpp"
 
 using hardware_interface::return_type;
 
@@ -43,6 +49,88 @@ namespace robot_hardware
     return_type write(const rclcpp::Time & /*time*/, const rclcpp::Duration & /*period*/) override;
 
   protected:
+    // Holding torque for the measured configuration plus the inverse dynamics and the
+    // friction of the commanded motion, sent to the drives as feedforward so the
+    // position loops only correct the model error
+    void update_feedforward(double period);
+
+    // Mass, centre of mass and inertia from the payload GPIO, applied when they change
+    void update_payload();
+
+    // Friction per joint from the friction GPIO, applied when it changes
+    void update_friction_parameters();
+
+    // Motor commands for the joint commands with the backlash and the twist of the
+    // transmission under the gravity torque taken out
+    void update_compensation();
+
+    // Backlash and stiffness per joint from the compensation GPIO, applied when they change
+    void update_compensation_parameters();
+
+    // Motor commands turned into whole microsteps within the step rate and
+    // acceleration the steppers follow without stalling
+    void update_steppers(double period);
+
+    // joint position the steps issued for joint i command, the joint command less
+    // what the stepper did not cover (its quantisation and rate limiting)
+    double stepped_command(std::size_t i) const;
+
+    // AS5600 reading of joint i; the mock has no encoders and quantises the stepped command
+    double read_encoder(std::size_t i) const;
+
+    // full interface names of a joint, built in on_init so read() and write() do not
+    // put strings together every cycle
+    struct JointInterfaces
+    {
+      std::string position;
+      std::string velocity;
+      std::string acceleration;
+      std::string effort;
+      std::string current;
+      std::string motor_position;
+      std::string quantisation_error;
+      std::string stall_risk;
+      std::string backlash;  // on the compensation GPIO
+      std::string stiffness; // on the compensation GPIO
+      std::array<std::string, 4> friction; // on the friction GPIO
+    };
+    std::vector<JointInterfaces> interfaces_;
+    std::array<std::string, 10> payload_interfaces_;
+
+    robot_dynamics::DynamicsModel dynamics_;
+    bool feedforward_ = false;
+    bool has_previous_command_ = false;
+    bool has_payload_gpio_ = false;
+    std::array<double, 10> payload_ = {}; // mass, com, inertia as on the payload GPIO
+    robot_dynamics::JointVector previous_position_ = robot_dynamics::JointVector::Zero();
+    robot_dynamics::JointVector previous_velocity_ = robot_dynamics::JointVector::Zero();
+    // Nm/A at the joint, gear included, 0 for joints without a current interface
+    std::vector<double> torque_constants_;
+    // added to the feedforward at the commanded velocity
+    std::vector<robot_dynamics::FrictionParameters> friction_parameters_; // from the joint params
+    std::vector<robot_dynamics::FrictionParameters> frictions_;
+    bool has_friction_gpio_ = false;
+
+    // position, velocity and acceleration states from a Kalman filter per joint
+    bool filter_ = false;
+    bool filters_reset_ = false;
+    std::vector<JointFilter> filters_;
+    std::vector<double> encoder_resolutions_; // rad per count
+    std::vector<bool> has_acceleration_state_;
+
+    std::vector<JointCompensationParameters> compensation_parameters_; // from the joint params
+    std::vector<JointCompensation> compensations_;
+    bool has_compensation_gpio_ = false;
+    bool has_compensation_command_ = false;
+    std::vector<double> gravity_torques_; // Nm at the measured pose, 0 without feedforward
+    std::vector<double> motor_commands_;  // rad, what the drives are sent
+    std::vector<bool> has_motor_position_state_;
+
+    std::vector<StepperAxis> steppers_;
+    bool steppers_reset_ = false;
+    std::vector<double> stepper_errors_; // rad, motor command minus where the steps put the motor
+    std::vector<bool> has_quantisation_error_state_;
+    std::vector<bool> has_stall_risk_state_;
   };
 
 } // namespace robot_hardware
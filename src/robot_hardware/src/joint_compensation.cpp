@@ -0,0 +1,60 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_hardware/joint_compensation.hpp"
+
+#include <algorithm>
+
+namespace robot_hardware
+{
+  bool JointCompensationParameters::valid() const
+  {
+    return backlash >= 0.0 && takeup >= 0.0 && stiffness >= 0.0;
+  }
+
+  JointCompensation::JointCompensation(const JointCompensationParameters &parameters)
+      : parameters_(parameters)
+  {
+  }
+
+  void JointCompensation::reset(double command)
+  {
+    previous_command_ = command;
+    side_ = 0.0;
+  }
+
+  double JointCompensation::motor_command(double command, double torque)
+  {
+    const double step = command - previous_command_;
+    previous_command_ = command;
+    if (parameters_.takeup > 0.0)
+    {
+      side_ = std::clamp(side_ + 2.0 * step / parameters_.takeup, -1.0, 1.0);
+    }
+    else if (step != 0.0)
+    {
+      side_ = step > 0.0 ? 1.0 : -1.0;
+    }
+
+    // smoothstep from -1 to 1, flat at both ends
+    const double shape = 0.5 * side_ * (3.0 - side_ * side_);
+    double motor = command + 0.5 * parameters_.backlash * shape;
+    if (parameters_.stiffness > 0.0)
+    {
+      motor += torque / parameters_.stiffness;
+    }
+    return motor;
+  }
+
+} // namespace robot_hardware
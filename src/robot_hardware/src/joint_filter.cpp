@@ -0,0 +1,81 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_hardware/joint_filter.hpp"
+
+namespace robot_hardware
+{
+  bool JointFilterParameters::valid() const
+  {
+    return jerk_noise > 0.0 && encoder_resolution > 0.0 && encoder_noise >= 0.0 && model_noise > 0.0 &&
+           motor_time_constant >= 0.0;
+  }
+
+  JointFilter::JointFilter(const JointFilterParameters &parameters)
+      : parameters_(parameters),
+        // uniform quantisation error plus the sensor noise
+        encoder_variance_(parameters.encoder_resolution * parameters.encoder_resolution / 12.0 +
+                          parameters.encoder_noise * parameters.encoder_noise)
+  {
+  }
+
+  void JointFilter::reset(double position)
+  {
+    x_ << position, 0.0, 0.0;
+    P_ = Eigen::Vector3d(encoder_variance_, 1e-2, 1.0).asDiagonal();
+    model_position_ = position;
+  }
+
+  void JointFilter::update(double encoder, double command, double dt)
+  {
+    if (dt <= 0.0)
+    {
+      return;
+    }
+
+    // predict
+    const double dt2 = dt * dt;
+    const double dt3 = dt2 * dt;
+    Eigen::Matrix3d F;
+    F << 1.0, dt, 0.5 * dt2,
+        0.0, 1.0, dt,
+        0.0, 0.0, 1.0;
+    Eigen::Matrix3d Q;
+    Q << dt3 * dt2 / 20.0, dt2 * dt2 / 8.0, dt3 / 6.0,
+        dt2 * dt2 / 8.0, dt3 / 3.0, dt2 / 2.0,
+        dt3 / 6.0, dt2 / 2.0, dt;
+    x_ = F * x_;
+    P_ = F * P_ * F.transpose() + parameters_.jerk_noise * Q;
+
+    // the motor follows its step command with a first order lag
+    const double alpha = parameters_.motor_time_constant > 0.0
+                             ? 1.0 - std::exp(-dt / parameters_.motor_time_constant)
+                             : 1.0;
+    model_position_ += alpha * (command - model_position_);
+
+    correct(encoder, encoder_variance_);
+    correct(model_position_, parameters_.model_noise * parameters_.model_noise);
+  }
+
+  void JointFilter::correct(double measurement, double variance)
+  {
+    // H = [1 0 0], so the gain is the first column of P over the innovation variance
+    const double innovation_variance = P_(0, 0) + variance;
+    const Eigen::Vector3d gain = P_.col(0) / innovation_variance;
+    x_ += gain * (measurement - x_[0]);
+    P_ -= gain * P_.row(0);
+    P_ = 0.5 * (P_ + P_.transpose()).eval(); // keeps rounding from breaking the symmetry
+  }
+
+} // namespace robot_hardware
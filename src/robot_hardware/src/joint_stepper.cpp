@@ -0,0 +1,92 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "robot_hardware/joint_stepper.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robot_hardware
+{
+  bool StepperParameters::valid() const
+  {
+    return steps_per_rad >= 0.0 && max_step_rate >= 0.0 && max_step_acceleration >= 0.0;
+  }
+
+  StepperAxis::StepperAxis(const StepperParameters &parameters)
+      : parameters_(parameters)
+  {
+  }
+
+  void StepperAxis::reset(double command)
+  {
+    steps_ = static_cast<std::int64_t>(std::llround(command * parameters_.steps_per_rad));
+    carry_ = 0.0;
+    velocity_ = 0.0;
+    previous_command_ = command;
+    command_velocity_ = 0.0;
+    stall_risk_ = 0.0;
+  }
+
+  std::int64_t StepperAxis::update(double command, double dt)
+  {
+    if (dt <= 0.0)
+    {
+      return 0;
+    }
+
+    // where the limited motion stands, the issued steps plus the carried fraction
+    const double position = static_cast<double>(steps_) + carry_;
+    const double distance = command * parameters_.steps_per_rad - position;
+    double velocity = distance / dt;
+    const double rate = parameters_.max_step_rate;
+    const double acceleration = parameters_.max_step_acceleration;
+
+    // what the command itself asks of the motor, not what catching up with it would
+    const double command_velocity = (command - previous_command_) * parameters_.steps_per_rad / dt;
+    stall_risk_ = 0.0;
+    if (rate > 0.0)
+    {
+      stall_risk_ = std::abs(command_velocity) / rate;
+      velocity = std::clamp(velocity, -rate, rate);
+    }
+    if (acceleration > 0.0)
+    {
+      stall_risk_ = std::max(stall_risk_, std::abs(command_velocity - command_velocity_) / (acceleration * dt));
+      // no faster than it can still settle on the moving command, then no faster
+      // than it can speed up. The speed holds for a whole cycle, so braking in
+      // steps of acceleration dt covers v^2 / 2a + v dt / 2, not v^2 / 2a
+      const double braking =
+          acceleration * (std::sqrt(0.25 * dt * dt + 2.0 * std::abs(distance) / acceleration) - 0.5 * dt);
+      velocity = std::clamp(velocity, command_velocity - braking, command_velocity + braking);
+      velocity = std::clamp(velocity, velocity_ - acceleration * dt, velocity_ + acceleration * dt);
+    }
+    velocity_ = velocity;
+    previous_command_ = command;
+    command_velocity_ = command_velocity;
+
+    // whole steps of the motion so far, the remainder carries
+    const double travel = carry_ + velocity * dt;
+    const std::int64_t steps = static_cast<std::int64_t>(std::llround(travel));
+    carry_ = travel - static_cast<double>(steps);
+    steps_ += steps;
+    return steps;
+  }
+
+  double StepperAxis::position() const
+  {
+    return parameters_.steps_per_rad > 0.0 ? static_cast<double>(steps_) / parameters_.steps_per_rad : 0.0;
+  }
+
+} // namespace robot_hardware
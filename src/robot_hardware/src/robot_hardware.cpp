@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "robot_hardware/robot_hardware.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -20,12 +23,230 @@
 
 namespace robot_hardware
 {
+  namespace
+  {
+    const std::array<const char *, 10> PAYLOAD_INTERFACES = {
+        "mass", "com.x", "com.y", "com.z",
+        "inertia.xx", "inertia.xy", "inertia.xz", "inertia.yy", "inertia.yz", "inertia.zz"};
+
+    // per joint on the friction GPIO, behind the joint name
+    const std::array<const char *, 4> FRICTION_INTERFACES = {".coulomb", ".stribeck", ".viscous", ".stribeck_velocity"};
+
+    std::string parameter(const std::unordered_map<std::string, std::string> &parameters, const std::string &name,
+                          const std::string &default_value)
+    {
+      const auto it = parameters.find(name);
+      return it != parameters.end() ? it->second : default_value;
+    }
+
+    bool has_interface(const std::vector<hardware_interface::InterfaceInfo> &interfaces, const std::string &name)
+    {
+      for (const auto &interface : interfaces)
+      {
+        if (interface.name == name)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+  } // namespace
+
   CallbackReturn RobotSystem::on_init(const hardware_interface::HardwareInfo &info)
   {
     if (hardware_interface::SystemInterface::on_init(info) != CallbackReturn::SUCCESS)
     {
       return CallbackReturn::ERROR;
     }
+
+    interfaces_.assign(info_.joints.size(), JointInterfaces());
+    for (std::size_t i = 0; i < info_.joints.size(); i++)
+    {
+      const std::string &name = info_.joints[i].name;
+      JointInterfaces &interfaces = interfaces_[i];
+      interfaces.position = name + "/" + hardware_interface::HW_IF_POSITION;
+      interfaces.velocity = name + "/" + hardware_interface::HW_IF_VELOCITY;
+      interfaces.acceleration = name + "/" + hardware_interface::HW_IF_ACCELERATION;
+      interfaces.effort = name + "/" + hardware_interface::HW_IF_EFFORT;
+      interfaces.current = name + "/current";
+      interfaces.motor_position = name + "/motor_position";
+      interfaces.quantisation_error = name + "/quantisation_error";
+      interfaces.stall_risk = name + "/stall_risk";
+      interfaces.backlash = "compensation/" + name + ".backlash";
+      interfaces.stiffness = "compensation/" + name + ".stiffness";
+      for (std::size_t k = 0; k < FRICTION_INTERFACES.size(); k++)
+      {
+        interfaces.friction[k] = "friction/" + name + FRICTION_INTERFACES[k];
+      }
+    }
+    for (std::size_t i = 0; i < PAYLOAD_INTERFACES.size(); i++)
+    {
+      payload_interfaces_[i] = std::string("payload/") + PAYLOAD_INTERFACES[i];
+    }
+
+    torque_constants_.assign(info_.joints.size(), 0.0);
+    for (std::size_t i = 0; i < info_.joints.size(); i++)
+    {
+      if (has_interface(info_.joints[i].state_interfaces, "current"))
+      {
+        torque_constants_[i] = std::stod(parameter(info_.joints[i].parameters, "torque_constant", "0.0"));
+      }
+    }
+
+    filter_ = parameter(info_.hardware_parameters, "filter", "true") == "true";
+    filters_.clear();
+    encoder_resolutions_.assign(info_.joints.size(), 0.0);
+    has_acceleration_state_.assign(info_.joints.size(), false);
+    compensation_parameters_.assign(info_.joints.size(), JointCompensationParameters());
+    gravity_torques_.assign(info_.joints.size(), 0.0);
+    motor_commands_.assign(info_.joints.size(), 0.0);
+    has_motor_position_state_.assign(info_.joints.size(), false);
+    steppers_.clear();
+    stepper_errors_.assign(info_.joints.size(), 0.0);
+    has_quantisation_error_state_.assign(info_.joints.size(), false);
+    has_stall_risk_state_.assign(info_.joints.size(), false);
+    friction_parameters_.assign(info_.joints.size(), robot_dynamics::FrictionParameters());
+    for (std::size_t i = 0; i < info_.joints.size(); i++)
+    {
+      const auto &joint = info_.joints[i];
+      JointFilterParameters filter_parameters;
+      StepperParameters stepper_parameters;
+      try
+      {
+        const int encoder_bits = std::stoi(parameter(joint.parameters, "encoder_bits", "12"));
+        if (encoder_bits < 1 || encoder_bits > 30)
+        {
+          throw std::invalid_argument("encoder_bits");
+        }
+        filter_parameters.encoder_resolution = 2.0 * M_PI / static_cast<double>(1 << encoder_bits);
+        filter_parameters.jerk_noise = std::stod(parameter(joint.parameters, "filter_jerk_noise", "50.0"));
+        filter_parameters.encoder_noise = std::stod(parameter(joint.parameters, "filter_encoder_noise", "0.001"));
+        filter_parameters.model_noise = std::stod(parameter(joint.parameters, "filter_model_noise", "0.005"));
+        filter_parameters.motor_time_constant =
+            std::stod(parameter(joint.parameters, "motor_time_constant", "0.02"));
+        compensation_parameters_[i].backlash = std::stod(parameter(joint.parameters, "backlash", "0.0"));
+        compensation_parameters_[i].takeup = std::stod(parameter(joint.parameters, "backlash_takeup", "0.002"));
+        compensation_parameters_[i].stiffness = std::stod(parameter(joint.parameters, "stiffness", "0.0"));
+        friction_parameters_[i].coulomb = std::stod(parameter(joint.parameters, "coulomb_friction", "0.0"));
+        friction_parameters_[i].stribeck = std::stod(parameter(joint.parameters, "stribeck_friction", "0.0"));
+        friction_parameters_[i].viscous = std::stod(parameter(joint.parameters, "viscous_friction", "0.0"));
+        friction_parameters_[i].stribeck_velocity = std::stod(parameter(joint.parameters, "stribeck_velocity", "0.1"));
+        stepper_parameters.steps_per_rad = std::stod(parameter(joint.parameters, "steps_per_rad", "0.0"));
+        stepper_parameters.max_step_rate = std::stod(parameter(joint.parameters, "max_step_rate", "0.0"));
+        stepper_parameters.max_step_acceleration =
+            std::stod(parameter(joint.parameters, "max_step_acceleration", "0.0"));
+      }
+      catch (const std::exception &)
+      {
+        RCLCPP_ERROR(get_logger(),
+                     "Joint '%s' has an invalid filter, encoder, compensation, friction or stepper parameter.",
+                     joint.name.c_str());
+        return CallbackReturn::ERROR;
+      }
+      if (!stepper_parameters.valid())
+      {
+        RCLCPP_ERROR(get_logger(), "Joint '%s' has a negative steps_per_rad, max_step_rate or max_step_acceleration.",
+                     joint.name.c_str());
+        return CallbackReturn::ERROR;
+      }
+      if (!friction_parameters_[i].valid())
+      {
+        RCLCPP_ERROR(get_logger(), "Joint '%s' has a negative friction or a stribeck_velocity <= 0.",
+                     joint.name.c_str());
+        return CallbackReturn::ERROR;
+      }
+      if (!compensation_parameters_[i].valid())
+      {
+        RCLCPP_ERROR(get_logger(), "Joint '%s' has a negative backlash, takeup or stiffness.", joint.name.c_str());
+        return CallbackReturn::ERROR;
+      }
+      if (!filter_parameters.valid())
+      {
+        RCLCPP_ERROR(get_logger(), "Joint '%s' has invalid filter noise parameters.", joint.name.c_str());
+        return CallbackReturn::ERROR;
+      }
+      if (filter_ && !has_interface(joint.state_interfaces, hardware_interface::HW_IF_VELOCITY))
+      {
+        RCLCPP_ERROR(get_logger(), "Joint '%s' needs a velocity state for the filter.", joint.name.c_str());
+        return CallbackReturn::ERROR;
+      }
+      filters_.emplace_back(filter_parameters);
+      encoder_resolutions_[i] = filter_parameters.encoder_resolution;
+      has_acceleration_state_[i] = has_interface(joint.state_interfaces, hardware_interface::HW_IF_ACCELERATION);
+      has_motor_position_state_[i] = has_interface(joint.state_interfaces, "motor_position");
+      steppers_.emplace_back(stepper_parameters);
+      has_quantisation_error_state_[i] = has_interface(joint.state_interfaces, "quantisation_error");
+      has_stall_risk_state_[i] = has_interface(joint.state_interfaces, "stall_risk");
+    }
+    compensations_ = std::vector<JointCompensation>(compensation_parameters_.begin(), compensation_parameters_.end());
+    frictions_ = friction_parameters_;
+
+    for (const auto &gpio : info_.gpios)
+    {
+      if (gpio.name == "payload")
+      {
+        has_payload_gpio_ = true;
+        for (const char *interface : PAYLOAD_INTERFACES)
+        {
+          has_payload_gpio_ = has_payload_gpio_ && has_interface(gpio.command_interfaces, interface);
+        }
+      }
+      if (gpio.name == "compensation")
+      {
+        has_compensation_gpio_ = true;
+        for (const auto &joint : info_.joints)
+        {
+          has_compensation_gpio_ = has_compensation_gpio_ &&
+                                   has_interface(gpio.command_interfaces, joint.name + ".backlash") &&
+                                   has_interface(gpio.command_interfaces, joint.name + ".stiffness");
+        }
+      }
+      if (gpio.name == "friction")
+      {
+        has_friction_gpio_ = true;
+        for (const auto &joint : info_.joints)
+        {
+          for (const char *interface : FRICTION_INTERFACES)
+          {
+            has_friction_gpio_ = has_friction_gpio_ && has_interface(gpio.command_interfaces, joint.name + interface);
+          }
+        }
+      }
+    }
+
+    feedforward_ = parameter(info_.hardware_parameters, "feedforward", "true") == "true";
+    if (feedforward_)
+    {
+      try
+      {
+        dynamics_ = robot_dynamics::DynamicsModel::from_urdf(
+            info_.original_xml, parameter(info_.hardware_parameters, "root_link", "base_link"),
+            parameter(info_.hardware_parameters, "tip_link", "link_7"));
+        if (info_.joints.size() != robot_dynamics::NUM_JOINTS)
+        {
+          throw std::runtime_error("Expected 6 joints.");
+        }
+        for (std::size_t i = 0; i < info_.joints.size(); i++)
+        {
+          const auto &joint = info_.joints[i];
+          if (joint.name != dynamics_.joint_names()[i])
+          {
+            throw std::runtime_error("Joint '" + joint.name + "' is not joint " + std::to_string(i + 1) +
+                                     " of the chain.");
+          }
+          if (!has_interface(joint.command_interfaces, hardware_interface::HW_IF_EFFORT) ||
+              !has_interface(joint.state_interfaces, hardware_interface::HW_IF_EFFORT))
+          {
+            throw std::runtime_error("Joint '" + joint.name + "' has no effort interfaces.");
+          }
+        }
+      }
+      catch (const std::exception &e)
+      {
+        RCLCPP_WARN(get_logger(), "Dynamics feedforward disabled: %s", e.what());
+        feedforward_ = false;
+      }
+    }
     return hardware_interface::CallbackReturn::SUCCESS;
   }
 
@@ -40,6 +261,41 @@ namespace robot_hardware
     {
       set_command(name, 0.0);
     }
+    for (const auto &gpio : info_.gpios)
+    {
+      for (const auto &interface : gpio.command_interfaces)
+      {
+        set_command(gpio.name + "/" + interface.name,
+                    interface.initial_value.empty() ? 0.0 : std::stod(interface.initial_value));
+      }
+    }
+    // the calibrated values in the joint params win over what was set at runtime
+    for (std::size_t i = 0; i < info_.joints.size(); i++)
+    {
+      compensations_[i].set_parameters(compensation_parameters_[i]);
+      if (has_compensation_gpio_)
+      {
+        set_command(interfaces_[i].backlash, compensation_parameters_[i].backlash);
+        set_command(interfaces_[i].stiffness, compensation_parameters_[i].stiffness);
+      }
+      frictions_[i] = friction_parameters_[i];
+      if (has_friction_gpio_)
+      {
+        const robot_dynamics::FrictionParameters &friction = friction_parameters_[i];
+        const std::array<double, 4> values = {friction.coulomb, friction.stribeck, friction.viscous,
+                                              friction.stribeck_velocity};
+        for (std::size_t k = 0; k < values.size(); k++)
+        {
+          set_command(interfaces_[i].friction[k], values[k]);
+        }
+      }
+    }
+    has_previous_command_ = false;
+    has_compensation_command_ = false;
+    filters_reset_ = false;
+    steppers_reset_ = false;
+    std::fill(stepper_errors_.begin(), stepper_errors_.end(), 0.0);
+    payload_ = {};
     for (const auto &[name, descr] : sensor_state_interfaces_)
     {
       set_state(name, 0.0);
@@ -54,18 +310,252 @@ namespace robot_hardware
 
     for (std::size_t i = 0; i < info_.joints.size(); i++)
     {
-      const auto name_pos = info_.joints[i].name + "/" + hardware_interface::HW_IF_POSITION;
-      // Just reflect the command position as the state position
-      set_state(name_pos, get_command(name_pos));
+      const JointInterfaces &interfaces = interfaces_[i];
+      const double encoder = read_encoder(i);
+      if (!filter_)
+      {
+        set_state(interfaces.position, encoder);
+        continue;
+      }
+
+      // the position the issued steps command drives the motor model, the encoder
+      // corrects it
+      JointFilter &filter = filters_[i];
+      if (!filters_reset_)
+      {
+        filter.reset(encoder);
+      }
+      else
+      {
+        filter.update(encoder, stepped_command(i), period.seconds());
+      }
+      set_state(interfaces.position, filter.position());
+      set_state(interfaces.velocity, filter.velocity());
+      if (has_acceleration_state_[i])
+      {
+        set_state(interfaces.acceleration, filter.acceleration());
+      }
     }
+    filters_reset_ = filter_;
     return return_type::OK;
   }
 
-  return_type RobotSystem::write(const rclcpp::Time &, const rclcpp::Duration &)
+  return_type RobotSystem::write(const rclcpp::Time &, const rclcpp::Duration &period)
   {
+    update_feedforward(period.seconds());
+    update_compensation();
+    update_steppers(period.seconds());
     return return_type::OK;
   }
 
+  void RobotSystem::update_feedforward(double period)
+  {
+    if (!feedforward_ || period <= 0.0)
+    {
+      return;
+    }
+
+    update_payload();
+    update_friction_parameters();
+
+    robot_dynamics::JointVector q;
+    robot_dynamics::JointVector q_measured;
+    for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+    {
+      q[i] = get_command(interfaces_[i].position);
+      q_measured[i] = get_state(interfaces_[i].position);
+    }
+
+    // the trajectory controller only commands positions, so the motion comes from
+    // differencing the setpoints; the first cycle after activation holds still
+    robot_dynamics::JointVector qd = robot_dynamics::JointVector::Zero();
+    robot_dynamics::JointVector qdd = robot_dynamics::JointVector::Zero();
+    if (has_previous_command_)
+    {
+      qd = (q - previous_position_) / period;
+      qdd = (qd - previous_velocity_) / period;
+    }
+    previous_position_ = q;
+    previous_velocity_ = qd;
+    has_previous_command_ = true;
+
+    // gravity at the measured pose holds a sagging joint where it is, the motion
+    // term follows the setpoints
+    robot_dynamics::JointVector tau;
+    robot_dynamics::JointVector tau_motion;
+    dynamics_.gravity_torques(q_measured, tau);
+    for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+    {
+      gravity_torques_[i] = tau[i];
+    }
+    dynamics_.motion_torques(q, qd, qdd, tau_motion);
+    tau += tau_motion;
+    for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+    {
+      tau[i] += frictions_[i].torque(qd[i]);
+    }
+
+    for (std::size_t i = 0; i < robot_dynamics::NUM_JOINTS; i++)
+    {
+      // the effort command is an extra torque from the controllers, on top of the model
+      const double effort = tau[i] + get_command(interfaces_[i].effort);
+      set_state(interfaces_[i].effort, effort);
+      if (torque_constants_[i] > 0.0)
+      {
+        set_state(interfaces_[i].current, effort / torque_constants_[i]);
+      }
+    }
+  }
+
+  void RobotSystem::update_friction_parameters()
+  {
+    if (!has_friction_gpio_)
+    {
+      return;
+    }
+    for (std::size_t i = 0; i < info_.joints.size(); i++)
+    {
+      robot_dynamics::FrictionParameters friction = frictions_[i];
+      friction.coulomb = get_command(interfaces_[i].friction[0]);
+      friction.stribeck = get_command(interfaces_[i].friction[1]);
+      friction.viscous = get_command(interfaces_[i].friction[2]);
+      friction.stribeck_velocity = get_command(interfaces_[i].friction[3]);
+      if (friction.coulomb == frictions_[i].coulomb && friction.stribeck == frictions_[i].stribeck &&
+          friction.viscous == frictions_[i].viscous && friction.stribeck_velocity == frictions_[i].stribeck_velocity)
+      {
+        continue;
+      }
+      if (!friction.valid())
+      {
+        RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 5000, "Ignoring friction of joint '%s'.",
+                             info_.joints[i].name.c_str());
+        continue;
+      }
+      frictions_[i] = friction;
+    }
+  }
+
+  void RobotSystem::update_compensation()
+  {
+    update_compensation_parameters();
+
+    for (std::size_t i = 0; i < info_.joints.size(); i++)
+    {
+      const double command = get_command(interfaces_[i].position);
+      if (!has_compensation_command_)
+      {
+        compensations_[i].reset(command);
+      }
+      motor_commands_[i] = compensations_[i].motor_command(command, gravity_torques_[i]);
+    }
+    has_compensation_command_ = true;
+  }
+
+  void RobotSystem::update_steppers(double period)
+  {
+    for (std::size_t i = 0; i < info_.joints.size(); i++)
+    {
+      StepperAxis &stepper = steppers_[i];
+      if (stepper.parameters().enabled())
+      {
+        if (!steppers_reset_)
+        {
+          stepper.reset(motor_commands_[i]);
+        }
+        else
+        {
+          stepper.update(motor_commands_[i], period);
+        }
+        stepper_errors_[i] = stepper.error(motor_commands_[i]);
+        motor_commands_[i] = stepper.position();
+        if (stepper.stall_risk() > 1.0)
+        {
+          RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 5000,
+                               "Joint '%s' is commanded past its step rate or acceleration, slowing it down.",
+                               info_.joints[i].name.c_str());
+        }
+      }
+      if (has_motor_position_state_[i])
+      {
+        set_state(interfaces_[i].motor_position, motor_commands_[i]);
+      }
+      if (has_quantisation_error_state_[i])
+      {
+        set_state(interfaces_[i].quantisation_error, stepper_errors_[i]);
+      }
+      if (has_stall_risk_state_[i])
+      {
+        set_state(interfaces_[i].stall_risk, stepper.stall_risk());
+      }
+    }
+    steppers_reset_ = true;
+  }
+
+  void RobotSystem::update_compensation_parameters()
+  {
+    if (!has_compensation_gpio_)
+    {
+      return;
+    }
+    for (std::size_t i = 0; i < info_.joints.size(); i++)
+    {
+      JointCompensationParameters parameters = compensations_[i].parameters();
+      parameters.backlash = get_command(interfaces_[i].backlash);
+      parameters.stiffness = get_command(interfaces_[i].stiffness);
+      if (parameters.backlash == compensations_[i].parameters().backlash &&
+          parameters.stiffness == compensations_[i].parameters().stiffness)
+      {
+        continue;
+      }
+      if (!parameters.valid())
+      {
+        RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 5000, "Ignoring compensation of joint '%s'.",
+                             info_.joints[i].name.c_str());
+        continue;
+      }
+      compensations_[i].set_parameters(parameters);
+    }
+  }
+
+  double RobotSystem::stepped_command(std::size_t i) const
+  {
+    return get_command(interfaces_[i].position) - stepper_errors_[i];
+  }
+
+  double RobotSystem::read_encoder(std::size_t i) const
+  {
+    const double command = stepped_command(i);
+    return std::round(command / encoder_resolutions_[i]) * encoder_resolutions_[i];
+  }
+
+  void RobotSystem::update_payload()
+  {
+    if (!has_payload_gpio_)
+    {
+      return;
+    }
+    std::array<double, 10> payload;
+    for (std::size_t i = 0; i < payload.size(); i++)
+    {
+      payload[i] = get_command(payload_interfaces_[i]);
+    }
+    if (payload == payload_)
+    {
+      return;
+    }
+    if (!(payload[0] >= 0.0))
+    {
+      RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 5000, "Ignoring payload mass %f.", payload[0]);
+      return;
+    }
+    payload_ = payload;
+    Eigen::Matrix3d inertia;
+    inertia << payload[4], payload[5], payload[6],
+        payload[5], payload[7], payload[8],
+        payload[6], payload[8], payload[9];
+    dynamics_.set_payload(payload[0], Eigen::Vector3d(payload[1], payload[2], payload[3]), inertia);
+  }
+
 } // namespace robot_hardware
 
 #include "pluginlib/class_list_macros.hpp"
@@ -0,0 +1,116 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "robot_hardware/joint_compensation.hpp"
+
+namespace
+{
+  using robot_hardware::JointCompensation;
+  using robot_hardware::JointCompensationParameters;
+
+  constexpr double BACKLASH = 0.02;
+
+  // the joint is dragged along once the motor reaches either side of the play
+  double dragged(double joint, double motor, double backlash)
+  {
+    return std::clamp(joint, motor - 0.5 * backlash, motor + 0.5 * backlash);
+  }
+
+  double sine_command(int k)
+  {
+    return 0.3 * std::sin(2.0 * M_PI * 0.5 * k * 0.002);
+  }
+
+  // largest joint error over two periods of the sine, after the first reversal
+  // has settled which side of the play the motor is on
+  double largest_error(JointCompensation &compensation, double backlash)
+  {
+    compensation.reset(sine_command(0));
+    double joint = sine_command(0);
+    double error = 0.0;
+    for (int k = 1; k <= 2000; k++)
+    {
+      const double command = sine_command(k);
+      joint = dragged(joint, compensation.motor_command(command, 0.0), backlash);
+      if (k > 500)
+      {
+        error = std::max(error, std::abs(joint - command));
+      }
+    }
+    return error;
+  }
+} // namespace
+
+TEST(JointCompensation, CancelsTheBacklash)
+{
+  JointCompensationParameters parameters;
+  JointCompensation uncompensated(parameters);
+  EXPECT_NEAR(largest_error(uncompensated, BACKLASH), 0.5 * BACKLASH, 1e-3);
+
+  // the joint lags only while the motor crosses the play after a reversal
+  parameters.backlash = BACKLASH;
+  JointCompensation compensation(parameters);
+  EXPECT_LT(largest_error(compensation, BACKLASH), parameters.takeup);
+}
+
+// the offset moves across the play over the takeup travel, not in one cycle
+TEST(JointCompensation, ReversalDoesNotJump)
+{
+  JointCompensationParameters parameters;
+  parameters.backlash = BACKLASH;
+  JointCompensation compensation(parameters);
+  compensation.reset(0.0);
+  const double step = 1e-4;
+  double command = 0.0;
+  double previous = compensation.motor_command(command, 0.0);
+  double largest_move = 0.0;
+  for (int k = 0; k < 200; k++)
+  {
+    command += k < 100 ? step : -step;
+    const double motor = compensation.motor_command(command, 0.0);
+    largest_move = std::max(largest_move, std::abs(motor - previous));
+    previous = motor;
+  }
+  // the smoothstep is at most 3/2 times as steep as a linear crossing
+  EXPECT_LE(largest_move, step * (1.0 + 1.5 * BACKLASH / parameters.takeup) + 1e-12);
+  EXPECT_NEAR(previous, command - 0.5 * BACKLASH, 1e-12);
+}
+
+TEST(JointCompensation, AddsTheTwistUnderLoad)
+{
+  JointCompensationParameters parameters;
+  parameters.stiffness = 500.0;
+  JointCompensation compensation(parameters);
+  compensation.reset(0.4);
+  EXPECT_DOUBLE_EQ(compensation.motor_command(0.4, 10.0), 0.4 + 10.0 / 500.0);
+}
+
+TEST(JointCompensation, NoOffsetBeforeTheFirstMove)
+{
+  JointCompensationParameters parameters;
+  parameters.backlash = BACKLASH;
+  JointCompensation compensation(parameters);
+  compensation.reset(0.4);
+  EXPECT_DOUBLE_EQ(compensation.motor_command(0.4, 0.0), 0.4);
+
+  // without takeup the offset switches as soon as the joint moves
+  parameters.takeup = 0.0;
+  compensation.set_parameters(parameters);
+  EXPECT_DOUBLE_EQ(compensation.motor_command(0.39, 0.0), 0.39 - 0.5 * BACKLASH);
+}
@@ -0,0 +1,146 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "robot_hardware/joint_filter.hpp"
+
+namespace
+{
+  using robot_hardware::JointFilter;
+  using robot_hardware::JointFilterParameters;
+
+  constexpr double DT = 0.002;
+
+  // a joint following its step command with the motor lag, read by the encoder
+  struct SimulatedJoint
+  {
+    explicit SimulatedJoint(const JointFilterParameters &parameters, double offset = 0.0)
+        : parameters(parameters), offset(offset), noise(0.0, 0.3 * parameters.encoder_noise)
+    {
+    }
+
+    // moves the joint one cycle towards command, returns the encoder reading
+    double step(double command)
+    {
+      const double previous_position = position;
+      const double previous_velocity = velocity;
+      position += (1.0 - std::exp(-DT / parameters.motor_time_constant)) * (command + offset - position);
+      velocity = (position - previous_position) / DT;
+      acceleration = (velocity - previous_velocity) / DT;
+      return std::round((position + noise(rng)) / parameters.encoder_resolution) * parameters.encoder_resolution;
+    }
+
+    JointFilterParameters parameters;
+    double offset; // rad the joint sits off the motor model, lost steps or slack
+    double position = 0.0;
+    double velocity = 0.0;
+    double acceleration = 0.0;
+    std::mt19937 rng{3};
+    std::normal_distribution<double> noise;
+  };
+
+  double sine_command(int k)
+  {
+    return 0.8 * std::sin(M_PI * k * DT);
+  }
+} // namespace
+
+// on a smooth move the estimate beats the encoder it reads and its difference quotient
+TEST(JointFilter, SmoothsEncoderAndDifference)
+{
+  const JointFilterParameters parameters;
+  SimulatedJoint joint(parameters);
+  JointFilter filter(parameters);
+  filter.reset(0.0);
+
+  double previous_encoder = 0.0;
+  double position_error = 0.0;
+  double encoder_error = 0.0;
+  double velocity_error = 0.0;
+  double difference_error = 0.0;
+  int samples = 0;
+  for (int k = 1; k <= 5000; k++)
+  {
+    const double command = sine_command(k);
+    const double encoder = joint.step(command);
+    filter.update(encoder, command, DT);
+    if (k > 500)
+    {
+      position_error += std::pow(filter.position() - joint.position, 2);
+      encoder_error += std::pow(encoder - joint.position, 2);
+      velocity_error += std::pow(filter.velocity() - joint.velocity, 2);
+      difference_error += std::pow((encoder - previous_encoder) / DT - joint.velocity, 2);
+      samples++;
+    }
+    previous_encoder = encoder;
+  }
+  EXPECT_LT(std::sqrt(position_error / samples), 0.6 * std::sqrt(encoder_error / samples));
+  EXPECT_LT(std::sqrt(velocity_error / samples), 0.1 * std::sqrt(difference_error / samples));
+  EXPECT_LT(std::sqrt(velocity_error / samples), 0.03); // rad/s, of 2.5 rad/s peak
+}
+
+TEST(JointFilter, EstimatesConstantAcceleration)
+{
+  // a motor without lag, so the command is where the joint is
+  JointFilterParameters parameters;
+  parameters.motor_time_constant = 0.0;
+  JointFilter filter(parameters);
+  filter.reset(0.0);
+  const double acceleration = 2.0;
+  for (int k = 1; k <= 1000; k++)
+  {
+    const double t = k * DT;
+    const double position = 0.5 * acceleration * t * t;
+    filter.update(std::round(position / parameters.encoder_resolution) * parameters.encoder_resolution,
+                  position, DT);
+  }
+  const double t = 1000 * DT;
+  EXPECT_NEAR(filter.position(), 0.5 * acceleration * t * t, parameters.encoder_resolution);
+  EXPECT_NEAR(filter.velocity(), acceleration * t, 0.02);
+  EXPECT_NEAR(filter.acceleration(), acceleration, 0.2);
+}
+
+// the encoder is the far tighter measurement, so the joint sitting off the motor
+// model moves the estimate only a little off the encoder
+TEST(JointFilter, FollowsTheEncoderOverTheModel)
+{
+  const JointFilterParameters parameters;
+  const double offset = 0.05;
+  SimulatedJoint joint(parameters, offset);
+  JointFilter filter(parameters);
+  filter.reset(0.0);
+  for (int k = 1; k <= 2000; k++)
+  {
+    filter.update(joint.step(0.3), 0.3, DT);
+  }
+  EXPECT_NEAR(filter.position(), 0.3 + offset, 0.1 * offset);
+  EXPECT_NEAR(filter.velocity(), 0.0, 0.02);
+}
+
+TEST(JointFilter, ResetsAtRest)
+{
+  JointFilter filter;
+  filter.reset(0.7);
+  EXPECT_DOUBLE_EQ(filter.position(), 0.7);
+  EXPECT_DOUBLE_EQ(filter.velocity(), 0.0);
+  EXPECT_DOUBLE_EQ(filter.acceleration(), 0.0);
+
+  // no time passed, nothing to predict or fuse
+  filter.update(1.0, 1.0, 0.0);
+  EXPECT_DOUBLE_EQ(filter.position(), 0.7);
+}
@@ -0,0 +1,134 @@
+// Copyright 2026 Andrin Winzap
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+#include "robot_hardware/joint_stepper.hpp"
+
+namespace
+{
+  using robot_hardware::StepperAxis;
+  using robot_hardware::StepperParameters;
+
+  // 1/16 microstepping, 200 steps per turn and a 16:1 gear
+  StepperParameters test_parameters()
+  {
+    StepperParameters parameters;
+    parameters.steps_per_rad = 509.3;
+    parameters.max_step_rate = 2000.0;
+    parameters.max_step_acceleration = 8000.0;
+    return parameters;
+  }
+
+  // half a step, with room for the rounding of a fraction that lands exactly on it
+  constexpr double HALF_STEP = 0.5 + 1e-9;
+
+  // microsteps between the command and where the steps put the motor
+  double step_error(const StepperAxis &axis, double command)
+  {
+    return axis.error(command) * axis.parameters().steps_per_rad;
+  }
+} // namespace
+
+// a cosine move whose peak speed and acceleration are exactly the limits is
+// followed to within the rounding
+TEST(StepperAxis, FollowsMotionAtTheLimitsWithinHalfAStep)
+{
+  const StepperParameters parameters = test_parameters();
+  const double duration = M_PI * parameters.max_step_rate / parameters.max_step_acceleration;
+  const double distance = 2.0 * duration * parameters.max_step_rate / (M_PI * parameters.steps_per_rad);
+  for (const double dt : {0.001, 0.002, 0.01})
+  {
+    StepperAxis axis(parameters);
+    axis.reset(0.0);
+    for (int k = 1; k * dt <= duration + 0.5; k++)
+    {
+      const double t = std::min(k * dt, duration);
+      const double command = 0.5 * distance * (1.0 - std::cos(M_PI * t / duration));
+      axis.update(command, dt);
+      ASSERT_LE(std::abs(step_error(axis, command)), HALF_STEP) << "dt " << dt << " t " << k * dt;
+      ASSERT_LE(axis.stall_risk(), 1.0 + 1e-9) << "dt " << dt << " t " << k * dt;
+    }
+  }
+}
+
+// a quarter step per cycle is carried over instead of rounded away
+TEST(StepperAxis, SlowMotionIsNotRoundedAway)
+{
+  StepperAxis axis(test_parameters());
+  axis.reset(0.0);
+  const double dt = 0.01;
+  const double velocity = 0.25 / (test_parameters().steps_per_rad * dt);
+  for (int k = 1; k <= 400; k++)
+  {
+    const double command = velocity * k * dt;
+    axis.update(command, dt);
+    ASSERT_LE(std::abs(step_error(axis, command)), HALF_STEP) << "cycle " << k;
+  }
+  EXPECT_EQ(axis.steps(), 100);
+}
+
+// a jump the motor cannot follow is flagged, run at the limits and stopped on the
+// command without overshooting it
+TEST(StepperAxis, JumpIsRateAndAccelerationLimited)
+{
+  const StepperParameters parameters = test_parameters();
+  for (const double dt : {0.001, 0.002, 0.01})
+  {
+    for (const double target : {1.5, -1.5})
+    {
+      StepperAxis axis(parameters);
+      axis.reset(0.0);
+      std::int64_t previous = 0;
+      double stall_risk = 0.0;
+      for (int k = 0; k * dt < 3.0; k++)
+      {
+        const std::int64_t steps = axis.update(target, dt);
+        EXPECT_LE(std::abs(steps), parameters.max_step_rate * dt + 1.0) << "dt " << dt;
+        EXPECT_LE(std::abs(steps - previous), parameters.max_step_acceleration * dt * dt + 2.0) << "dt " << dt;
+        // the motion approaches from one side, so past the target means overshoot
+        EXPECT_GE(step_error(axis, target) * (target > 0.0 ? 1.0 : -1.0), -HALF_STEP) << "dt " << dt;
+        stall_risk = std::max(stall_risk, axis.stall_risk());
+        previous = steps;
+      }
+      EXPECT_GT(stall_risk, 1.0);
+      EXPECT_LE(std::abs(step_error(axis, target)), HALF_STEP) << "dt " << dt;
+    }
+  }
+}
+
+TEST(StepperAxis, UnlimitedAxisOnlyRounds)
+{
+  StepperParameters parameters = test_parameters();
+  parameters.max_step_rate = 0.0;
+  parameters.max_step_acceleration = 0.0;
+  StepperAxis axis(parameters);
+  axis.reset(0.0);
+  axis.update(1.5, 0.002);
+  EXPECT_LE(std::abs(step_error(axis, 1.5)), HALF_STEP);
+  EXPECT_DOUBLE_EQ(axis.stall_risk(), 0.0);
+}
+
+TEST(StepperAxis, ResetRestsOnTheNearestStep)
+{
+  StepperAxis axis(test_parameters());
+  axis.reset(0.1);
+  EXPECT_EQ(axis.steps(), std::llround(0.1 * test_parameters().steps_per_rad));
+  EXPECT_LE(std::abs(step_error(axis, 0.1)), HALF_STEP);
+  EXPECT_EQ(axis.update(0.1, 0.002), 0);
+}
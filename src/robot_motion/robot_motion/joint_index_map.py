@@ -0,0 +1,30 @@
+# joint_index_map.py
+
+from operator import itemgetter
+
+class JointIndexMap:
+    # Resolves where each of `joint_names` sits in a message's name list and
+    # caches that permutation. Publishers keep their name order, so later
+    # messages only need a list compare and a fixed gather.
+
+    def __init__(self, joint_names):
+        self.joint_names = list(joint_names)
+        self.names = None  # name order the cached gather was resolved for
+        self.gather = None
+
+    def resolve(self, names):
+        index = {name: i for i, name in enumerate(names)}
+        missing = [name for name in self.joint_names if name not in index]
+        if missing:
+            raise KeyError(", ".join(missing))
+        self.gather = itemgetter(*[index[name] for name in self.joint_names])
+        self.names = list(names)
+
+    def __call__(self, names, positions):
+        # Positions in `joint_names` order. Raises KeyError for missing joints and
+        # IndexError if there are fewer positions than names.
+        if names != self.names:
+            self.resolve(names)
+        if len(positions) < len(self.names):
+            raise IndexError(f"{len(positions)} positions for {len(self.names)} joint names")
+        return list(self.gather(positions))
@@ -0,0 +1,29 @@
+# kinematic_state.py
+
+import numpy as np
+from scipy.spatial.transform import Rotation as R
+from .robot_motion import link_frames, jacobian
+
+class KinematicState:
+    # Kinematics of the robot at one /joint_states message. The subscriber builds
+    # a new snapshot per message and swaps node.state; everything else only reads.
+    # Callbacks grab node.state once and work on that reference, so they see a
+    # consistent state without locking (the attribute swap is atomic).
+
+    def __init__(self, version, stamp, joint_positions):
+        self.version = version
+        self.stamp = stamp
+        self.joint_positions = np.array(joint_positions, dtype=float)
+        self.link_frames = link_frames(self.joint_positions)
+        self.tcp = self.link_frames[-1]
+        self.tcp_quaternion = R.from_matrix(self.tcp[:3, :3]).as_quat()  # x, y, z, w
+        self.jacobian = jacobian(self.joint_positions)
+
+        for array in (self.joint_positions, self.tcp_quaternion, self.jacobian, *self.link_frames):
+            array.flags.writeable = False
+
+    def update(self, stamp, joint_positions):
+        # A robot at rest keeps publishing the same positions, reuse the kinematics then.
+        if np.array_equal(self.joint_positions, joint_positions):
+            return self
+        return KinematicState(self.version + 1, stamp, joint_positions)
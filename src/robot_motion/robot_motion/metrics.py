@@ -0,0 +1,83 @@
+# metrics.py
+
+import threading
+import time
+
+import numpy as np
+from diagnostic_msgs.msg import DiagnosticArray, DiagnosticStatus, KeyValue
+
+
+def make_status(name, hardware_id, values):
+    status = DiagnosticStatus()
+    status.level = DiagnosticStatus.OK
+    status.name = name
+    status.hardware_id = hardware_id
+    status.values = [KeyValue(key=key, value=f"{value:.6g}" if isinstance(value, float) else str(value))
+                     for key, value in values.items()]
+    return status
+
+
+class MetricsPublisher:
+    # Periodically publishes named groups of values on /diagnostics. Each source is a
+    # callable returning a dict, evaluated at publish time.
+
+    def __init__(self, node, period=1.0, callback_group=None):
+        self.node = node
+        self.sources = {}
+        self.pub = node.create_publisher(DiagnosticArray, '/diagnostics', 10)
+        self.timer = node.create_timer(period, self.publish, callback_group=callback_group)
+
+    def add_source(self, name, source):
+        self.sources[name] = source
+
+    def publish(self):
+        msg = DiagnosticArray()
+        msg.header.stamp = self.node.get_clock().now().to_msg()
+        msg.status = [make_status(f"{self.node.get_name()}: {name}", self.node.get_name(), source())
+                      for name, source in self.sources.items()]
+        self.pub.publish(msg)
+
+
+class LatencyStats:
+    # Latency samples in seconds from any thread, reported and cleared on each publish.
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.samples = []
+
+    def add(self, value):
+        with self.lock:
+            self.samples.append(value)
+
+    def report(self):
+        with self.lock:
+            samples, self.samples = self.samples, []
+        if not samples:
+            return {"samples": 0}
+        samples = np.array(samples) * 1e3
+        return {
+            "samples": len(samples),
+            "mean_ms": float(np.mean(samples)),
+            "p99_ms": float(np.percentile(samples, 99)),
+            "max_ms": float(np.max(samples)),
+        }
+
+
+class QueueDelayProbe:
+    # Timer in a callback group that records how late it gets to run. Long callbacks
+    # in the group, or an executor without a free thread, show up as queueing delay.
+
+    def __init__(self, node, callback_group, period=0.1):
+        self.period = period
+        self.expected = None
+        self.stats = LatencyStats()
+        self.timer = node.create_timer(period, self.callback, callback_group=callback_group)
+
+    def callback(self):
+        now = time.monotonic()
+        if self.expected is None:
+            self.expected = now
+        delay = max(now - self.expected, 0.0)
+        self.stats.add(delay)
+        # the timer stays on its period grid and skips the periods it missed
+        self.expected += self.period * (1 + int(delay // self.period))
@@ -0,0 +1,116 @@
+# plan_cache.py
+
+import json
+import os
+from collections import OrderedDict
+
+import numpy as np
+
+
+class CachedPlan:
+    def __init__(self, positions, velocities, accelerations, times, compute_time):
+        self.positions = positions
+        self.velocities = velocities
+        self.accelerations = accelerations
+        self.times = times
+        self.compute_time = compute_time  # seconds it took to produce the trajectory
+
+
+class PlanCache:
+    # LRU cache of validated, time parameterised trajectories. Keys hold the start and
+    # goal quantised to `resolution` (rad), the environment hash robot_planning
+    # publishes and every setting that changes the resulting trajectory. The hash is
+    # taken over the obstacles and the robot parameters, so entries saved to `path`
+    # are only hit again in the same environment after a restart. The file is plain
+    # JSON, a corrupt or foreign one is ignored and the cache starts empty.
+
+    FILE_VERSION = 2  # 1 keyed on a per process counter and is not loaded
+
+    def __init__(self, capacity=256, resolution=1e-3, path=""):
+        self.capacity = capacity
+        self.resolution = resolution
+        self.path = path
+        self.entries = OrderedDict()
+
+        self.hits = 0
+        self.misses = 0
+        self.saved_time = 0.0
+        self.load_error = None  # why the file could not be loaded, None if it was or there was none
+
+        if self.path:
+            self.load()
+
+    def quantise(self, joints):
+        return tuple(int(v) for v in np.round(np.asarray(joints, dtype=float) / self.resolution))
+
+    def make_key(self, start, goal, environment_version, settings):
+        return (self.quantise(start), self.quantise(goal), int(environment_version), tuple(settings))
+
+    def get(self, key):
+        entry = self.entries.get(key)
+        if entry is None:
+            self.misses += 1
+            return None
+        self.entries.move_to_end(key)
+        self.hits += 1
+        self.saved_time += entry.compute_time
+        return entry
+
+    def put(self, key, trajectory, compute_time):
+        self.entries[key] = CachedPlan(
+            [list(p.positions) for p in trajectory.points],
+            [list(p.velocities) for p in trajectory.points],
+            [list(p.accelerations) for p in trajectory.points],
+            [(p.time_from_start.sec, p.time_from_start.nanosec) for p in trajectory.points],
+            compute_time,
+        )
+        self.entries.move_to_end(key)
+        while len(self.entries) > self.capacity:
+            self.entries.popitem(last=False)
+
+    def hit_rate(self):
+        lookups = self.hits + self.misses
+        return self.hits / lookups if lookups else 0.0
+
+    def load(self):
+        if not os.path.exists(self.path):
+            return
+        try:
+            with open(self.path, "r") as f:
+                data = json.load(f)
+            if data.get("version") != self.FILE_VERSION or data.get("resolution") != self.resolution:
+                self.load_error = "written with a different version or resolution"
+                return
+            entries = OrderedDict()
+            for (start, goal, environment, settings), entry in data["entries"]:
+                key = (tuple(int(v) for v in start), tuple(int(v) for v in goal), int(environment), tuple(settings))
+                entries[key] = CachedPlan(entry["positions"], entry["velocities"], entry["accelerations"],
+                                          [tuple(t) for t in entry["times"]], float(entry["compute_time"]))
+        except (OSError, ValueError, KeyError, TypeError, AttributeError) as e:
+            self.load_error = f"{type(e).__name__}: {e}"
+            return
+        self.entries = entries
+        while len(self.entries) > self.capacity:
+            self.entries.popitem(last=False)
+
+    def save(self):
+        if not self.path:
+            return
+        data = {
+            "version": self.FILE_VERSION,
+            "resolution": self.resolution,
+            "entries": [
+                [list(key), {
+                    "positions": entry.positions,
+                    "velocities": entry.velocities,
+                    "accelerations": entry.accelerations,
+                    "times": entry.times,
+                    "compute_time": entry.compute_time,
+                }]
+                for key, entry in self.entries.items()
+            ],
+        }
+        tmp_path = self.path + ".tmp"
+        with open(tmp_path, "w") as f:
+            json.dump(data, f)
+        os.replace(tmp_path, self.path)
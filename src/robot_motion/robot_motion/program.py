@@ -0,0 +1,111 @@
+# program.py
+
+import numpy as np
+
+# Compiles a motion program into one timed joint trajectory, so the whole program
+# is a single controller goal. Segments are cubic Hermite splines: a waypoint that
+# blends keeps the robot moving with a monotone (non overshooting) via velocity,
+# every other waypoint comes to rest.
+
+class Waypoint:
+    def __init__(self, q, blend=False, step=None):
+        self.q = np.array(q, dtype=float)
+        self.blend = blend
+        self.step = step  # program step that moves here, None for the start and planner via points
+        self.actions = []  # ("wait", duration, step) / ("output", (name, value), step) on arrival
+
+    def dwell(self):
+        return sum(value for kind, value, _ in self.actions if kind == "wait")
+
+
+class ProgramPlan:
+    def __init__(self):
+        self.times = []
+        self.positions = []
+        self.velocities = []
+        self.accelerations = []
+        self.step_times = {}  # step index -> time the step is done
+        self.events = []  # (time, name, value)
+
+    def duration(self):
+        return self.times[-1]
+
+    def steps_done(self, t):
+        return sum(1 for step_time in self.step_times.values() if step_time <= t)
+
+
+def segment_duration(q0, q1, max_velocity, min_duration):
+    # a cubic from rest peaks at 1.5 times the mean velocity
+    return max(1.5 * np.max(np.abs(q1 - q0)) / max_velocity, min_duration)
+
+
+def via_velocity(q_prev, q, q_next, T_prev, T_next):
+    s_prev = (q - q_prev) / T_prev
+    s_next = (q_next - q) / T_next
+    v = 0.5 * (s_prev + s_next)
+    # Fritsch-Carlson: no overshoot if the velocity is zero at extrema and below
+    # three times the neighbouring slopes
+    limit = 3.0 * np.minimum(np.abs(s_prev), np.abs(s_next))
+    v = np.sign(v) * np.minimum(np.abs(v), limit)
+    v[s_prev * s_next <= 0.0] = 0.0
+    return v
+
+
+def hermite(q0, q1, v0, v1, T, t):
+    s = t / T
+    h00 = 2 * s**3 - 3 * s**2 + 1
+    h10 = s**3 - 2 * s**2 + s
+    h01 = -2 * s**3 + 3 * s**2
+    h11 = s**3 - s**2
+    pos = h00 * q0 + h10 * T * v0 + h01 * q1 + h11 * T * v1
+    vel = ((6 * s**2 - 6 * s) * q0 + (3 * s**2 - 4 * s + 1) * T * v0 +
+           (-6 * s**2 + 6 * s) * q1 + (3 * s**2 - 2 * s) * T * v1) / T
+    acc = ((12 * s - 6) * q0 + (6 * s - 4) * T * v0 + (-12 * s + 6) * q1 + (6 * s - 2) * T * v1) / T**2
+    return pos, vel, acc
+
+
+def compile_program(waypoints, max_velocity, sample_period, min_duration=0.1):
+    n = len(waypoints)
+    durations = [segment_duration(waypoints[i].q, waypoints[i + 1].q, max_velocity, min_duration)
+                 for i in range(n - 1)]
+
+    velocities = [np.zeros_like(waypoints[0].q) for _ in range(n)]
+    for i in range(1, n - 1):
+        if waypoints[i].blend and waypoints[i].dwell() == 0.0:
+            velocities[i] = via_velocity(waypoints[i - 1].q, waypoints[i].q, waypoints[i + 1].q,
+                                         durations[i - 1], durations[i])
+
+    plan = ProgramPlan()
+
+    def add(t, pos, vel, acc):
+        plan.times.append(t)
+        plan.positions.append(pos)
+        plan.velocities.append(vel)
+        plan.accelerations.append(acc)
+
+    zeros = np.zeros_like(waypoints[0].q)
+    t = 0.0
+    add(t, waypoints[0].q, zeros, zeros)
+    for i, waypoint in enumerate(waypoints):
+        if i > 0:
+            T = durations[i - 1]
+            q0, q1 = waypoints[i - 1].q, waypoint.q
+            samples = max(int(np.ceil(T / sample_period)), 1)
+            for k in range(1, samples + 1):
+                pos, vel, acc = hermite(q0, q1, velocities[i - 1], velocities[i], T, T * k / samples)
+                add(t + T * k / samples, pos, vel, acc)
+            t += T
+            if waypoint.step is not None:
+                plan.step_times[waypoint.step] = t
+
+        for kind, value, step in waypoint.actions:
+            if kind == "wait":
+                t += value
+                add(t, waypoint.q, zeros, zeros)
+            else:
+                plan.events.append((t, *value))
+            plan.step_times[step] = t
+
+    plan.velocities[-1] = zeros
+    plan.accelerations[-1] = zeros
+    return plan
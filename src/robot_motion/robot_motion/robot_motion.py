@@ -1,13 +1,21 @@
 # robot_motion.py
 
 import numpy as np
-from .symbolic_kinematics import T_06_func, T_01_func, R_03_func
+from .symbolic_kinematics import T_06_func, T_01_func, R_03_func, link_frames_func, J_func
 from .utills import check_limits, normalize_angle
 from .config import EPSILON, JOINT_OFFSETS, LINK_LENGTHS
 
 def forward_kinematics(thetas):
     return T_06_func(*thetas)
 
+def link_frames(thetas):
+    # T_01 ... T_06, the last one is the flange
+    return [np.asarray(T, dtype=float) for T in link_frames_func(*thetas)]
+
+def jacobian(thetas):
+    # Geometric Jacobian of the flange, linear part in mm/rad
+    return np.asarray(J_func(*thetas), dtype=float)
+
 def inverse_kinematics(T_06):
     R_06 = T_06[:3, :3] # Extract rotation part
     P_06 = T_06[:3, 3] # Extract position part
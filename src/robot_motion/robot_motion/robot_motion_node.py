@@ -1,16 +1,35 @@
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+
 import rclpy
+from rclpy.action import ActionServer, CancelResponse
+from rclpy.callback_groups import MutuallyExclusiveCallbackGroup, ReentrantCallbackGroup
+from rclpy.executors import MultiThreadedExecutor
 from rclpy.node import Node
+from rclpy.qos import QoSProfile, DurabilityPolicy
+from rclpy.task import Future
 from rclpy.time import Duration
 
 from sensor_msgs.msg import JointState
+from std_msgs.msg import UInt64
+from std_srvs.srv import Trigger
 from geometry_msgs.msg import PoseStamped
 from trajectory_msgs.msg import JointTrajectory, JointTrajectoryPoint
 
-from robot_motion_interfaces.srv import GetCartesianSpacePose, GetJointSpacePose
+from robot_motion_interfaces.srv import ArmGuard, GetCartesianSpacePose, GetJointSpacePose, PlanJointPath
+from robot_motion_interfaces.msg import ContactEvent, DigitalOutput, ProgramStep
+from robot_motion_interfaces.action import GuardedMove, MoveJoint, MoveCartesian, ExecuteProgram
 
-from robot_motion.robot_motion import forward_kinematics, inverse_kinematics
+from robot_motion.robot_motion import inverse_kinematics
+from robot_motion.kinematic_state import KinematicState
+from robot_motion.joint_index_map import JointIndexMap
+from robot_motion.state_shm import StateWriter
+from robot_motion.program import Waypoint, compile_program
 
 from robot_motion.utills import check_limits
+from robot_motion.plan_cache import PlanCache
+from robot_motion.metrics import MetricsPublisher, LatencyStats, QueueDelayProbe
 
 import numpy as np
 from scipy.spatial.transform import Rotation as R, Slerp
@@ -22,99 +41,211 @@ def choose_min_movement_solution(current_joints, ik_solutions):
     best_idx = np.argmin(diffs)
     return ik_solutions[best_idx]
 
+class ActiveMotion:
+    # Action goal being executed. `future` resolves to (status, message) once the
+    # robot reached the target, the goal was canceled or it had to be aborted.
+
+    SUCCEEDED = "succeeded"
+    CANCELED = "canceled"
+    ABORTED = "aborted"
+    CONTACT = "contact"  # guarded moves only
+
+    def __init__(self, goal_handle, target, make_feedback):
+        self.goal_handle = goal_handle
+        self.target = np.array(target, dtype=float)
+        self.make_feedback = make_feedback
+        self.future = Future()
+        self.start_time = None  # set once the trajectory is published
+        self.end_time = None
+        self.settled_since = None  # first time within goal tolerance after the trajectory end
+        self.timers = []  # pending program outputs, dropped when the motion ends
+        self.guarded = False  # finished by a /guard_controller/contact
+        self.contact_event = None
+
+
 class KinematicsNode(Node):
     def __init__(self):
         super().__init__('robot_motion_node')
 
         self.joint_names = [f"joint_{i+1}" for i in range(6)]
-        self.current_joint_positions = None
+        self.state = None  # KinematicState of the latest /joint_states
+        self.joint_states_map = JointIndexMap(self.joint_names)
+        self.joint_goal_map = JointIndexMap(self.joint_names)
+
+        self.declare_parameter("state_shm_name", "robot_motion_state")  # "" disables the shared memory state
+        self.state_shm = None
+        if self.get_parameter("state_shm_name").value:
+            self.state_shm = StateWriter(self.get_parameter("state_shm_name").value)
+
+        # State ingestion, pose queries and motion handling run in separate groups so a
+        # busy motion callback never holds up /joint_states or the getter services. Heavy
+        # work (IK, trajectory generation) goes to the planning pool. Motion state is
+        # also touched by action tasks and pool threads, so it is guarded by motion_lock.
+        self.state_group = MutuallyExclusiveCallbackGroup()
+        self.query_group = ReentrantCallbackGroup()
+        self.motion_group = MutuallyExclusiveCallbackGroup()
+        self.motion_lock = threading.RLock()
+
+        self.declare_parameter("executor_threads", 4)  # read by main()
+        self.declare_parameter("planning_threads", 2)
+        self.planning_pool = ThreadPoolExecutor(max_workers=self.get_parameter("planning_threads").value,
+                                                thread_name_prefix="planning")
+        self.planning_pool_delay = LatencyStats()
 
         self.traj_pub = self.create_publisher(JointTrajectory, '/joint_trajectory_controller/joint_trajectory', 10)
-        self.create_subscription(JointState, '/joint_states', self.joint_states_callback, 10)
+        self.create_subscription(JointState, '/joint_states', self.joint_states_callback, 10,
+                                 callback_group=self.state_group)
         
-        self.create_service(GetCartesianSpacePose, '/robot_motion/cartesian_space/get_pose', self.cartesian_space_pose_getter_callback)
-        self.create_service(GetJointSpacePose, '/robot_motion/joint_space/get_pose', self.joint_space_pose_getter_callback)
+        self.create_service(GetCartesianSpacePose, '/robot_motion/cartesian_space/get_pose', self.cartesian_space_pose_getter_callback,
+                            callback_group=self.query_group)
+        self.create_service(GetJointSpacePose, '/robot_motion/joint_space/get_pose', self.joint_space_pose_getter_callback,
+                            callback_group=self.query_group)
         
-        self.create_subscription(PoseStamped, '/robot_motion/cartesian_space/set_goal_pose', self.cartesian_space_goal_pose_setter_callback, 10)
-        self.create_subscription(JointState, '/robot_motion/joint_space/set_goal_pose', self.joint_space_goal_pose_setter_callback, 10)
+        self.create_subscription(PoseStamped, '/robot_motion/cartesian_space/set_goal_pose', self.cartesian_space_goal_pose_setter_callback, 10,
+                                 callback_group=self.motion_group)
+        self.create_subscription(JointState, '/robot_motion/joint_space/set_goal_pose', self.joint_space_goal_pose_setter_callback, 10,
+                                 callback_group=self.motion_group)
 
         self.declare_parameter("interpolation_type", "cubic")
         self.declare_parameter("total_time", 5.0)
         self.declare_parameter("num_waypoints", 50)
+        self.declare_parameter("planner", "none")  # "none" (straight joint interpolation) or "rrt_connect"
+        self.declare_parameter("max_planning_time", 0.05)
+
+        self.plan_client = self.create_client(PlanJointPath, '/robot_planning/plan_joint_path',
+                                              callback_group=self.motion_group)
+        self.environment_version = None  # environment hash from robot_planning, None until it is received
+        self.create_subscription(UInt64, '/robot_planning/environment_version', self.environment_version_callback,
+                                 QoSProfile(depth=1, durability=DurabilityPolicy.TRANSIENT_LOCAL),
+                                 callback_group=self.state_group)
+
+        self.declare_parameter("plan_cache_size", 256)  # 0 disables the cache
+        self.declare_parameter("plan_cache_resolution", 1e-3)
+        self.declare_parameter("plan_cache_file", "")
+        self.plan_cache = None
+        if self.get_parameter("plan_cache_size").value > 0:
+            self.plan_cache = PlanCache(self.get_parameter("plan_cache_size").value,
+                                        self.get_parameter("plan_cache_resolution").value,
+                                        self.get_parameter("plan_cache_file").value)
+            if self.plan_cache.load_error is not None:
+                self.get_logger().warn(f"Plan cache file not loaded, starting empty: {self.plan_cache.load_error}")
+
+        self.metrics = MetricsPublisher(self)
+        if self.plan_cache is not None:
+            self.metrics.add_source("plan_cache", lambda: {
+                "hits": self.plan_cache.hits,
+                "misses": self.plan_cache.misses,
+                "hit_rate": self.plan_cache.hit_rate(),
+                "latency_saved_s": self.plan_cache.saved_time,
+                "entries": len(self.plan_cache.entries),
+            })
+        self.queue_delay_probes = {
+            "state": QueueDelayProbe(self, self.state_group),
+            "query": QueueDelayProbe(self, self.query_group),
+            "motion": QueueDelayProbe(self, self.motion_group),
+        }
+        for name, probe in self.queue_delay_probes.items():
+            self.metrics.add_source(f"queue_delay/{name}", probe.stats.report)
+        self.metrics.add_source("queue_delay/planning_pool", self.planning_pool_delay.report)
+
+        self.declare_parameter("feedback_rate", 10.0)  # Hz
+        self.declare_parameter("goal_tolerance", 0.01)  # rad, largest joint error at the target
+        self.declare_parameter("goal_time_tolerance", 1.0)  # s past the trajectory end before aborting
+        self.declare_parameter("settle_time", 0.05)  # s the robot has to stay within goal_tolerance
+        self.declare_parameter("stop_time", 0.3)  # s to come to rest on cancel
+        self.active_motion = None
+        self.motion_sequence = 0
+        self.create_timer(1.0 / self.get_parameter("feedback_rate").value, self.motion_monitor_callback,
+                          callback_group=self.motion_group)
+
+        self.move_joint_server = ActionServer(
+            self, MoveJoint, '/robot_motion/joint_space/move', self.execute_move_joint,
+            cancel_callback=lambda goal_handle: CancelResponse.ACCEPT, callback_group=self.motion_group)
+        self.move_cartesian_server = ActionServer(
+            self, MoveCartesian, '/robot_motion/cartesian_space/move', self.execute_move_cartesian,
+            cancel_callback=lambda goal_handle: CancelResponse.ACCEPT, callback_group=self.motion_group)
+
+        self.declare_parameter("program_max_velocity", 0.5)  # rad/s
+        self.declare_parameter("program_sample_period", 0.02)  # s between trajectory points
+        self.output_pub = self.create_publisher(DigitalOutput, '/robot_motion/digital_outputs', 10)
+        self.execute_program_server = ActionServer(
+            self, ExecuteProgram, '/robot_motion/program/execute', self.execute_program,
+            cancel_callback=lambda goal_handle: CancelResponse.ACCEPT, callback_group=self.motion_group)
+
+        # Guarded moves arm guard_controller, which stops the robot in the control cycle
+        # it detects contact. The node then only has to bring the trajectory controller
+        # to the held pose before the guard is released.
+        self.arm_guard_client = self.create_client(ArmGuard, '/guard_controller/arm',
+                                                   callback_group=self.motion_group)
+        self.create_subscription(ContactEvent, '/guard_controller/contact', self.contact_callback, 10,
+                                 callback_group=self.state_group)
+        self.guarded_move_server = ActionServer(
+            self, GuardedMove, '/robot_motion/guarded_move', self.execute_guarded_move,
+            cancel_callback=lambda goal_handle: CancelResponse.ACCEPT, callback_group=self.motion_group)
+
+        # A collision found by guard_controller's momentum observer stays latched, the
+        # controller keeps reacting and motions are refused until it is reset.
+        self.collision_latched = False
+        self.create_service(Trigger, '/robot_motion/reset_collision', self.reset_collision_callback,
+                            callback_group=self.motion_group)
 
         self.get_logger().info("Robot kinematics node ready.")
 
     def joint_states_callback(self, msg: JointState):
-        joint_map = dict(zip(msg.name, msg.position))
         try:
-            self.current_joint_positions = [joint_map[name] for name in self.joint_names]
-        except KeyError as e:
+            positions = self.joint_states_map(msg.name, msg.position)
+        except (KeyError, IndexError) as e:
             self.get_logger().warn(f"Missing joint in /joint_states input: {e}")
             return
 
+        if self.state is None:
+            self.state = KinematicState(0, msg.header.stamp, positions)
+        else:
+            self.state = self.state.update(msg.header.stamp, positions)
+        if self.state_shm is not None:
+            self.state_shm.write(self.state, self.active_motion is not None)
+
+        # completion is judged on every joint state so clients hear about it right away
+        if self.active_motion is not None:
+            with self.motion_lock:
+                self.check_completion(self.get_clock().now())
+
+    def environment_version_callback(self, msg: UInt64):
+        self.environment_version = msg.data
+
     def cartesian_space_goal_pose_setter_callback(self, msg: PoseStamped):
-        if self.current_joint_positions is None:
+        state = self.state
+        if state is None:
             self.get_logger().warn("No joint state received yet.")
             return
 
-        start_T = forward_kinematics(self.current_joint_positions)
-        start_pos = start_T[:3, 3]
-        start_ori = R.from_matrix(start_T[:3, :3])
+        sequence = self.motion_sequence
+        self.offload(self.solve_cartesian_goal, state, msg).add_done_callback(
+            lambda f: self.topic_goal_solved_callback(state.joint_positions, f.result(), sequence))
+
+    def topic_goal_solved_callback(self, start, solution, sequence):
+        end_joints, message = solution if solution is not None else (None, "IK failed.")
+        if end_joints is None:
+            self.get_logger().warn(message)
+            return
+
+        with self.motion_lock:
+            if sequence != self.motion_sequence:
+                self.get_logger().info("Dropping topic goal superseded while solving IK.")
+                return
+            self.finish_motion(ActiveMotion.ABORTED, "Preempted by a topic goal.")
+            self.send_joint_motion(start, end_joints)
 
+    def solve_cartesian_goal(self, state, msg: PoseStamped):
         end_T = self.pose_to_transform(msg.pose)
         if end_T is None:
-            self.get_logger().warn("Invalid target pose received. Skipping trajectory generation.")
-            return
-        end_pos = end_T[:3, 3]
-        end_ori = R.from_matrix(end_T[:3, :3])
+            return None, "Invalid target pose received. Skipping trajectory generation."
 
         ik_solutions = inverse_kinematics(end_T)
         if not ik_solutions:
-            self.get_logger().warn("No IK solution for target pose.")
-            return
-
-        end_joints = choose_min_movement_solution(self.current_joint_positions, ik_solutions)
-
-
-        total_time = self.get_parameter("total_time").value
-        num_points = self.get_parameter("num_waypoints").value
-        interpolation = self.get_parameter("interpolation_type").value
-
-        trajectory = JointTrajectory()
-        trajectory.header.stamp = self.get_clock().now().to_msg()
-        trajectory.joint_names = self.joint_names
+            return None, "No IK solution for target pose."
 
-        # Setup slerp for orientation interpolation
-        key_times = [0, 1]
-        key_rots = R.from_quat([start_ori.as_quat(), end_ori.as_quat()])
-        slerp = Slerp(key_times, key_rots)
-
-        for i in range(num_points):
-            t_norm = i / (num_points - 1)
-
-            # Interpolate joint positions with the existing interpolation method
-            pos, vel, acc = self.interpolate_joint_trajectory(
-                np.array(self.current_joint_positions),
-                np.array(end_joints),
-                t_norm,
-                total_time,
-                interpolation
-            )
-
-            point = JointTrajectoryPoint()
-            point.positions = pos.tolist()
-            point.velocities = vel.tolist()
-            point.accelerations = acc.tolist()
-            point.time_from_start = Duration(seconds=(total_time * t_norm)).to_msg()
-
-            trajectory.points.append(point)
-
-        # zero final velocity & acceleration
-        trajectory.points[-1].velocities = [0.0] * 6
-        trajectory.points[-1].accelerations = [0.0] * 6
-
-        self.traj_pub.publish(trajectory)
-        self.get_logger().info(f"Published trajectory with {num_points} points.")
+        return choose_min_movement_solution(state.joint_positions, ik_solutions), ""
 
     def pose_to_transform(self, pose):
         quat = [pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w]
@@ -128,14 +259,18 @@ class KinematicsNode(Node):
         T[:3, 3] = [pose.position.x, pose.position.y, pose.position.z]
         return T
 
-    def transform_to_pose(self, T):
+    def state_to_pose(self, state):
+        return self.transform_to_pose(state.tcp, state.tcp_quaternion)
+
+    def transform_to_pose(self, T, quat=None):
         pose = PoseStamped()
         pose.header.stamp = self.get_clock().now().to_msg()
         pose.header.frame_id = "base_link"
         pose.pose.position.x = T[0, 3]
         pose.pose.position.y = T[1, 3]
         pose.pose.position.z = T[2, 3]
-        quat = R.from_matrix(T[:3, :3]).as_quat()
+        if quat is None:
+            quat = R.from_matrix(T[:3, :3]).as_quat()
         pose.pose.orientation.x = quat[0]
         pose.pose.orientation.y = quat[1]
         pose.pose.orientation.z = quat[2]
@@ -183,46 +318,169 @@ class KinematicsNode(Node):
         return pos, vel, acc
     
     def cartesian_space_pose_getter_callback(self, request, response):
-        if self.current_joint_positions is None:
+        state = self.state
+        if state is None:
             self.get_logger().warn("No joint states available to compute pose.")
             empty_pose = PoseStamped()
             empty_pose.header.stamp = self.get_clock().now().to_msg()
             empty_pose.header.frame_id = "base_link"
             response.pose = empty_pose
         else:
-            T = forward_kinematics(self.current_joint_positions)
-            pose_stamped = self.transform_to_pose(T)  # this returns a PoseStamped
-            response.pose = pose_stamped  # Assign full PoseStamped, not just Pose
+            response.pose = self.state_to_pose(state)  # Assign full PoseStamped, not just Pose
         return response
     
     def joint_space_pose_getter_callback(self, request, response):
-        if self.current_joint_positions is None:
+        state = self.state
+        if state is None:
             self.get_logger().warn("No joint state available to respond.")
             response.joint_names = []
             response.joint_positions = []
         else:
             response.joint_names = self.joint_names
-            response.joint_positions = self.current_joint_positions
+            response.joint_positions = state.joint_positions.tolist()
         return response
 
     def joint_space_goal_pose_setter_callback(self, msg: JointState):
-        if self.current_joint_positions is None:
+        state = self.state
+        if state is None:
             self.get_logger().warn("No joint state received yet to plan from.")
             return
 
-        joint_map = dict(zip(msg.name, msg.position))
-        try:
-            target_positions = [joint_map[name] for name in self.joint_names]
-        except KeyError as e:
-            self.get_logger().warn(f"Missing joint in joint_goal input: {e}")
+        target_positions, message = self.solve_joint_goal(msg.name, msg.position)
+        if target_positions is None:
+            self.get_logger().warn(message)
             return
 
+        with self.motion_lock:
+            self.finish_motion(ActiveMotion.ABORTED, "Preempted by a topic goal.")
+            self.send_joint_motion(state.joint_positions, target_positions)
+
+    def solve_joint_goal(self, names, positions):
+        try:
+            target_positions = self.joint_goal_map(names, positions)
+        except (KeyError, IndexError) as e:
+            return None, f"Missing joint in joint_goal input: {e}"
+
         # Check joint limits using your utility function
         if not check_limits(target_positions):
-            self.get_logger().warn("Requested joint positions exceed joint limits. Ignoring command.")
+            return None, "Requested joint positions exceed joint limits. Ignoring command."
+
+        return target_positions, ""
+
+    def offload(self, fn, *args):
+        # Runs fn(*args) on the planning pool. The returned Future resolves to the
+        # result (None if fn raised); done callbacks run on the pool thread.
+        future = Future()
+        submitted = time.perf_counter()
+
+        def job():
+            self.planning_pool_delay.add(time.perf_counter() - submitted)
+            try:
+                result = fn(*args)
+            except Exception as e:
+                self.get_logger().error(f"{fn.__name__} failed: {e}")
+                result = None
+            future.set_result(result)
+            executor = self.executor
+            if executor is not None:
+                executor.wake()  # resume coroutines awaiting the future
+
+        self.planning_pool.submit(job)
+        return future
+
+    def send_joint_motion(self, start, target):
+        planner = self.get_parameter("planner").value
+        with self.motion_lock:
+            self.motion_sequence += 1  # outstanding plans for older goals are dropped
+            sequence = self.motion_sequence
+
+            cache_key = None
+            # planned paths are only cached once the environment they were checked in is known
+            if self.plan_cache is not None and (planner == "none" or self.environment_version is not None):
+                settings = (
+                    planner,
+                    self.get_parameter("interpolation_type").value,
+                    self.get_parameter("total_time").value,
+                    self.get_parameter("num_waypoints").value,
+                )
+                environment_version = self.environment_version if planner != "none" else 0
+                cache_key = self.plan_cache.make_key(start, target, environment_version, settings)
+                cached = self.plan_cache.get(cache_key)
+                if cached is not None:
+                    self.get_logger().info("Plan cache hit.")
+                    self.publish_trajectory(self.trajectory_from_cache(cached))
+                    return
+
+        t0 = time.perf_counter()
+        if planner != "none" and not self.plan_client.service_is_ready():
+            self.get_logger().warn("Planning service not available. Falling back to joint interpolation.")
+            planner = "none"
+            cache_key = None
+
+        if planner == "none":
+            self.offload(self.build_trajectory, [start, target]).add_done_callback(
+                lambda f: self.trajectory_done_callback(f.result(), cache_key, t0, sequence))
+            return
+
+        request = PlanJointPath.Request()
+        request.start = [float(q) for q in start]
+        request.goal = [float(q) for q in target]
+        request.max_planning_time = self.get_parameter("max_planning_time").value
+        future = self.plan_client.call_async(request)
+        future.add_done_callback(lambda f: self.plan_done_callback(f, cache_key, t0, sequence))
+
+    def plan_done_callback(self, future, cache_key, t0, sequence):
+        if sequence != self.motion_sequence:
+            self.get_logger().info("Dropping plan for a superseded goal.")
             return
 
-        # Proceed with trajectory generation as before
+        response = future.result()
+        if response is None or not response.success:
+            message = response.message if response is not None else "no response"
+            self.get_logger().warn(f"Planning failed: {message}")
+            self.finish_motion(ActiveMotion.ABORTED, f"Planning failed: {message}")
+            return
+
+        path = [list(point.positions) for point in response.path.points]
+        times = [point.time_from_start.sec + point.time_from_start.nanosec * 1e-9 for point in response.path.points]
+        self.get_logger().info(f"Planned path with {len(path)} waypoints in {response.planning_time * 1e3:.1f} ms.")
+        if times[-1] > 0.0:
+            # optimised paths come time scaled to the joint limits
+            trajectory = self.offload(self.build_timed_trajectory, path, times)
+        else:
+            trajectory = self.offload(self.build_trajectory, path)
+        trajectory.add_done_callback(lambda f: self.trajectory_done_callback(f.result(), cache_key, t0, sequence))
+
+    def trajectory_done_callback(self, trajectory, cache_key, t0, sequence):
+        with self.motion_lock:
+            if sequence != self.motion_sequence:
+                self.get_logger().info("Dropping trajectory for a superseded goal.")
+                return
+            if trajectory is None:
+                self.finish_motion(ActiveMotion.ABORTED, "Trajectory generation failed.")
+                return
+            self.store_plan(cache_key, trajectory, t0)
+            self.publish_trajectory(trajectory)
+
+    def store_plan(self, cache_key, trajectory, t0):
+        if cache_key is not None:
+            self.plan_cache.put(cache_key, trajectory, time.perf_counter() - t0)
+
+    def trajectory_from_cache(self, cached):
+        trajectory = JointTrajectory()
+        trajectory.header.stamp = self.get_clock().now().to_msg()
+        trajectory.joint_names = self.joint_names
+        for pos, vel, acc, (sec, nanosec) in zip(cached.positions, cached.velocities, cached.accelerations, cached.times):
+            point = JointTrajectoryPoint()
+            point.positions = pos
+            point.velocities = vel
+            point.accelerations = acc
+            point.time_from_start.sec = sec
+            point.time_from_start.nanosec = nanosec
+            trajectory.points.append(point)
+        return trajectory
+
+    def build_trajectory(self, path):
         total_time = self.get_parameter("total_time").value
         num_points = self.get_parameter("num_waypoints").value
         interpolation = self.get_parameter("interpolation_type").value
@@ -233,13 +491,7 @@ class KinematicsNode(Node):
 
         for i in range(num_points):
             t_norm = i / (num_points - 1)
-            pos, vel, acc = self.interpolate_joint_trajectory(
-                np.array(self.current_joint_positions),
-                np.array(target_positions),
-                t_norm,
-                total_time,
-                interpolation
-            )
+            pos, vel, acc = self.interpolate_path(np.array(path, dtype=float), t_norm, total_time, interpolation)
             point = JointTrajectoryPoint()
             point.positions = pos.tolist()
             point.velocities = vel.tolist()
@@ -247,14 +499,482 @@ class KinematicsNode(Node):
             point.time_from_start = Duration(seconds=(total_time * t_norm)).to_msg()
             trajectory.points.append(point)
 
+        # zero final velocity & acceleration
         trajectory.points[-1].velocities = [0.0] * len(self.joint_names)
         trajectory.points[-1].accelerations = [0.0] * len(self.joint_names)
+        return trajectory
+
+    def build_timed_trajectory(self, path, times):
+        positions = np.array(path, dtype=float)
+        times = np.array(times)
+        velocities = np.gradient(positions, times, axis=0)
+        accelerations = np.gradient(velocities, times, axis=0)
+        velocities[[0, -1]] = 0.0
+        accelerations[[0, -1]] = 0.0
+
+        trajectory = JointTrajectory()
+        trajectory.header.stamp = self.get_clock().now().to_msg()
+        trajectory.joint_names = self.joint_names
+        for pos, vel, acc, t in zip(positions, velocities, accelerations, times):
+            point = JointTrajectoryPoint()
+            point.positions = pos.tolist()
+            point.velocities = vel.tolist()
+            point.accelerations = acc.tolist()
+            point.time_from_start = Duration(seconds=float(t)).to_msg()
+            trajectory.points.append(point)
+        return trajectory
+
+    def publish_trajectory(self, trajectory):
+        self.traj_pub.publish(trajectory)
+        self.get_logger().info(f"Published trajectory with {len(trajectory.points)} points.")
 
+        motion = self.active_motion
+        if motion is not None and motion.start_time is None:
+            motion.start_time = self.get_clock().now()
+            motion.end_time = motion.start_time + Duration.from_msg(trajectory.points[-1].time_from_start)
+
+    def stop_motion(self, positions=None):
+        # Brings the trajectory controller to rest at positions, the current ones by default
+        trajectory = JointTrajectory()
+        trajectory.header.stamp = self.get_clock().now().to_msg()
+        trajectory.joint_names = self.joint_names
+        point = JointTrajectoryPoint()
+        point.positions = self.state.joint_positions.tolist() if positions is None else [float(q) for q in positions]
+        point.velocities = [0.0] * len(self.joint_names)
+        point.time_from_start = Duration(seconds=self.get_parameter("stop_time").value).to_msg()
+        trajectory.points.append(point)
         self.traj_pub.publish(trajectory)
-        self.get_logger().info(f"Published trajectory to joint goal with {num_points} points.")
+
+    def start_motion(self, goal_handle, target, make_feedback, trajectory=None, events=()):
+        # Plans a motion to target, or runs a prebuilt trajectory with timed outputs.
+        with self.motion_lock:
+            if self.collision_latched:
+                refused = Future()
+                refused.set_result((ActiveMotion.ABORTED, "Collision latched, call reset_collision first."))
+                return refused
+            self.finish_motion(ActiveMotion.ABORTED, "Preempted by a new goal.")
+            motion = ActiveMotion(goal_handle, target, make_feedback)
+            motion.goal_tolerance = self.get_parameter("goal_tolerance").value
+            motion.goal_time_tolerance = self.get_parameter("goal_time_tolerance").value
+            motion.settle_time = self.get_parameter("settle_time").value
+            self.active_motion = motion
+            if trajectory is None:
+                self.send_joint_motion(self.state.joint_positions, target)
+            else:
+                self.motion_sequence += 1  # drop plans still outstanding for earlier goals
+                self.publish_trajectory(trajectory)
+                for t, name, value in events:
+                    self.schedule_output(motion, t, name, value)
+            return motion.future
+
+    def schedule_output(self, motion, delay, name, value):
+        def fire():
+            timer.cancel()
+            self.output_pub.publish(DigitalOutput(name=name, value=value))
+            self.get_logger().info(f"Set output {name} to {value}.")
+
+        timer = self.create_timer(max(delay, 1e-3), fire, callback_group=self.motion_group)
+        motion.timers.append(timer)
+
+    def finish_motion(self, status, message):
+        with self.motion_lock:
+            motion = self.active_motion
+            if motion is None:
+                return
+            self.active_motion = None
+        for timer in motion.timers:
+            timer.cancel()
+            self.destroy_timer(timer)
+        motion.future.set_result((status, message))
+        executor = self.executor
+        if executor is not None:
+            executor.wake()  # resume execute_motion now rather than on the next event
+
+    def motion_monitor_callback(self):
+        with self.motion_lock:
+            self.monitor_motion()
+
+    def monitor_motion(self):
+        motion = self.active_motion
+        state = self.state
+        if motion is None or state is None:
+            return
+
+        if motion.goal_handle.is_cancel_requested:
+            self.stop_motion()
+            self.finish_motion(ActiveMotion.CANCELED, "Motion canceled.")
+            return
+
+        if motion.start_time is None:
+            return  # still planning
+
+        now = self.get_clock().now()
+        duration = (motion.end_time - motion.start_time).nanoseconds * 1e-9
+        remaining = (motion.end_time - now).nanoseconds * 1e-9
+        progress = 1.0 if duration <= 0.0 else float(np.clip(1.0 - remaining / duration, 0.0, 1.0))
+        motion.goal_handle.publish_feedback(motion.make_feedback(progress, max(remaining, 0.0)))
+        self.check_completion(now)
+
+    def check_completion(self, now):
+        # Succeeds once the trajectory has ended and the robot stayed within
+        # goal_tolerance of the target for settle_time.
+        motion = self.active_motion
+        state = self.state
+        if motion is None or state is None or motion.start_time is None:
+            return
+
+        remaining = (motion.end_time - now).nanoseconds * 1e-9
+        error = np.max(np.abs(state.joint_positions - motion.target))
+        if remaining > 0.0 or error > motion.goal_tolerance:
+            motion.settled_since = None
+        elif motion.settled_since is None:
+            motion.settled_since = now
+
+        if motion.settled_since is not None and (now - motion.settled_since).nanoseconds * 1e-9 >= motion.settle_time:
+            self.finish_motion(ActiveMotion.SUCCEEDED, "Target reached.")
+        elif remaining < -motion.goal_time_tolerance:
+            self.finish_motion(ActiveMotion.ABORTED, f"Target not reached, joint error {error:.4f} rad.")
+
+    async def execute_motion(self, goal_handle, target, make_feedback, trajectory=None, events=()):
+        t0 = self.get_clock().now()
+        status, message = await self.start_motion(goal_handle, target, make_feedback, trajectory, events)
+        if status == ActiveMotion.SUCCEEDED:
+            goal_handle.succeed()
+        elif status == ActiveMotion.CANCELED:
+            goal_handle.canceled()
+        else:
+            goal_handle.abort()
+        self.get_logger().info(f"Motion {status}: {message}")
+        return status == ActiveMotion.SUCCEEDED, message, (self.get_clock().now() - t0).nanoseconds * 1e-9
+
+    async def execute_move_joint(self, goal_handle):
+        result = MoveJoint.Result()
+        target = None
+        if self.state is None:
+            result.message = "No joint state received yet to plan from."
+        else:
+            target, result.message = self.solve_joint_goal(goal_handle.request.joint_names,
+                                                           goal_handle.request.joint_positions)
+        if target is None:
+            goal_handle.abort()
+            return result
+
+        def make_feedback(progress, time_remaining):
+            feedback = MoveJoint.Feedback()
+            feedback.joint_positions = self.state.joint_positions.tolist()
+            feedback.progress = progress
+            feedback.time_remaining = time_remaining
+            return feedback
+
+        result.success, result.message, result.duration = await self.execute_motion(goal_handle, target, make_feedback)
+        result.joint_positions = self.state.joint_positions.tolist()
+        return result
+
+    async def execute_move_cartesian(self, goal_handle):
+        result = MoveCartesian.Result()
+        target = None
+        if self.state is None:
+            result.message = "No joint state received yet."
+        else:
+            solution = await self.offload(self.solve_cartesian_goal, self.state, goal_handle.request.pose)
+            target, result.message = solution if solution is not None else (None, "IK failed.")
+        if target is None:
+            goal_handle.abort()
+            return result
+
+        def make_feedback(progress, time_remaining):
+            feedback = MoveCartesian.Feedback()
+            feedback.pose = self.state_to_pose(self.state)
+            feedback.progress = progress
+            feedback.time_remaining = time_remaining
+            return feedback
+
+        result.success, result.message, result.duration = await self.execute_motion(goal_handle, target, make_feedback)
+        result.pose = self.state_to_pose(self.state)
+        return result
+
+    def resolve_program(self, state, steps):
+        # Waypoints of the program, Cartesian targets take the IK solution closest to
+        # the previous target so the branch choice follows the program, not the robot.
+        waypoints = [Waypoint(state.joint_positions)]
+        for i, step in enumerate(steps):
+            if step.type == ProgramStep.MOVE_JOINT:
+                if len(step.joint_positions) != len(self.joint_names):
+                    return None, f"Step {i}: expected {len(self.joint_names)} joint positions."
+                if not check_limits(step.joint_positions):
+                    return None, f"Step {i}: joint positions exceed joint limits."
+                waypoints.append(Waypoint(step.joint_positions, step.blend, i))
+            elif step.type == ProgramStep.MOVE_CARTESIAN:
+                end_T = self.pose_to_transform(step.pose.pose)
+                ik_solutions = inverse_kinematics(end_T) if end_T is not None else None
+                if not ik_solutions:
+                    return None, f"Step {i}: no IK solution for target pose."
+                waypoints.append(Waypoint(choose_min_movement_solution(waypoints[-1].q, ik_solutions), step.blend, i))
+            elif step.type == ProgramStep.WAIT:
+                waypoints[-1].actions.append(("wait", max(step.duration, 0.0), i))
+            elif step.type == ProgramStep.SET_OUTPUT:
+                waypoints[-1].actions.append(("output", (step.output, step.value), i))
+            else:
+                return None, f"Step {i}: unknown step type {step.type}."
+        return waypoints, ""
+
+    async def plan_program(self, waypoints):
+        # With a planner configured all segments are planned at once (they only depend
+        # on the resolved targets) and the planner's via points are blended through.
+        if self.get_parameter("planner").value == "none" or len(waypoints) < 2:
+            return waypoints, ""
+        if not self.plan_client.service_is_ready():
+            self.get_logger().warn("Planning service not available. Falling back to joint interpolation.")
+            return waypoints, ""
+
+        futures = []
+        for start, goal in zip(waypoints[:-1], waypoints[1:]):
+            request = PlanJointPath.Request()
+            request.start = start.q.tolist()
+            request.goal = goal.q.tolist()
+            request.max_planning_time = self.get_parameter("max_planning_time").value
+            futures.append(self.plan_client.call_async(request))
+
+        planned = [waypoints[0]]
+        for i, future in enumerate(futures):
+            response = await future
+            if response is None or not response.success:
+                message = response.message if response is not None else "no response"
+                return None, f"Planning segment {i} failed: {message}"
+            for point in response.path.points[1:-1]:
+                planned.append(Waypoint(point.positions, blend=True))
+            planned.append(waypoints[i + 1])
+        return planned, ""
+
+    def trajectory_from_plan(self, plan):
+        trajectory = JointTrajectory()
+        trajectory.header.stamp = self.get_clock().now().to_msg()
+        trajectory.joint_names = self.joint_names
+        for t, pos, vel, acc in zip(plan.times, plan.positions, plan.velocities, plan.accelerations):
+            point = JointTrajectoryPoint()
+            point.positions = pos.tolist()
+            point.velocities = vel.tolist()
+            point.accelerations = acc.tolist()
+            point.time_from_start = Duration(seconds=float(t)).to_msg()
+            trajectory.points.append(point)
+        return trajectory
+
+    async def execute_program(self, goal_handle):
+        result = ExecuteProgram.Result()
+        steps = goal_handle.request.steps
+        state = self.state
+        if state is None:
+            result.message = "No joint state received yet to plan from."
+            goal_handle.abort()
+            return result
+
+        waypoints, result.message = self.resolve_program(state, steps)
+        if waypoints is not None:
+            waypoints, result.message = await self.plan_program(waypoints)
+        if waypoints is None:
+            self.get_logger().warn(result.message)
+            goal_handle.abort()
+            return result
+
+        plan = await self.offload(compile_program, waypoints,
+                                  self.get_parameter("program_max_velocity").value,
+                                  self.get_parameter("program_sample_period").value)
+        if plan is None:
+            result.message = "Program compilation failed."
+            goal_handle.abort()
+            return result
+        self.get_logger().info(f"Program with {len(steps)} steps compiled to {len(plan.times)} points, "
+                               f"{plan.duration():.2f} s.")
+
+        def make_feedback(progress, time_remaining):
+            feedback = ExecuteProgram.Feedback()
+            feedback.current_step = min(plan.steps_done(plan.duration() - time_remaining), max(len(steps) - 1, 0))
+            feedback.joint_positions = self.state.joint_positions.tolist()
+            feedback.progress = progress
+            feedback.time_remaining = time_remaining
+            return feedback
+
+        result.success, result.message, result.duration = await self.execute_motion(
+            goal_handle, plan.positions[-1], make_feedback, self.trajectory_from_plan(plan), plan.events)
+        result.steps_completed = len(steps) if result.success else plan.steps_done(result.duration)
+        return result
+
+    def contact_callback(self, msg: ContactEvent):
+        with self.motion_lock:
+            motion = self.active_motion
+            if msg.source == ContactEvent.COLLISION:
+                self.collision_latched = True
+                torques = ", ".join(f"{t:.2f}" for t in msg.external_torques)
+                self.get_logger().error(f"Collision detected, external torques [{torques}] Nm.")
+                self.stop_motion(msg.joint_positions)
+                self.finish_motion(ActiveMotion.ABORTED, "Collision detected.")
+                return
+            if motion is None or not motion.guarded:
+                self.get_logger().warn("Contact reported outside of a guarded move.")
+                return
+            motion.contact_event = msg
+            self.stop_motion(msg.joint_positions)
+            sources = {ContactEvent.FORCE: "force", ContactEvent.TORQUE: "torque",
+                       ContactEvent.TRACKING_ERROR: "tracking error"}
+            self.finish_motion(ActiveMotion.CONTACT, f"Contact ({sources.get(msg.source, 'unknown')}).")
+
+    async def arm_guard(self, arm, force=0.0, torque=0.0, tracking_error=0.0):
+        if not self.arm_guard_client.service_is_ready():
+            return False, "Service '/guard_controller/arm' not available."
+        request = ArmGuard.Request(arm=arm, force_threshold=float(force), torque_threshold=float(torque),
+                                   tracking_error_threshold=float(tracking_error))
+        response = await self.arm_guard_client.call_async(request)
+        if response is None:
+            return False, "No response from '/guard_controller/arm'."
+        return response.success, response.message
+
+    def reset_collision_callback(self, request, response):
+        # Brings the trajectory controller to the pose the collision reaction left the
+        # robot in, then releases the guard once it is there.
+        if not self.collision_latched:
+            response.success = True
+            response.message = "No collision latched."
+            return response
+        if not self.arm_guard_client.service_is_ready():
+            response.message = "Service '/guard_controller/arm' not available."
+            return response
+
+        with self.motion_lock:
+            self.stop_motion()
+
+        def release():
+            timer.cancel()
+            self.destroy_timer(timer)
+            future = self.arm_guard_client.call_async(ArmGuard.Request(arm=False))
+            future.add_done_callback(released)
+
+        def released(future):
+            result = future.result()
+            if result is not None and result.success:
+                self.collision_latched = False
+                self.get_logger().info("Collision reset.")
+            else:
+                self.get_logger().error("Cannot release the guard after a collision.")
+
+        timer = self.create_timer(self.get_parameter("stop_time").value, release, callback_group=self.motion_group)
+        response.success = True
+        response.message = "Collision reset, motions resume once the guard is released."
+        return response
+
+    def delay(self, seconds):
+        # Future resolving after seconds, to await in action callbacks
+        future = Future()
+
+        def fire():
+            timer.cancel()
+            self.destroy_timer(timer)
+            future.set_result(None)
+
+        timer = self.create_timer(max(seconds, 1e-3), fire, callback_group=self.motion_group)
+        return future
+
+    async def execute_guarded_move(self, goal_handle):
+        request = goal_handle.request
+        result = GuardedMove.Result()
+        target = None
+        if self.state is None:
+            result.message = "No joint state received yet to plan from."
+        elif len(request.joint_positions) > 0:
+            target, result.message = self.solve_joint_goal(self.joint_names, request.joint_positions)
+        else:
+            solution = await self.offload(self.solve_cartesian_goal, self.state, request.pose)
+            target, result.message = solution if solution is not None else (None, "IK failed.")
+        if target is not None and self.collision_latched:
+            target, result.message = None, "Collision latched, call reset_collision first."
+        if target is not None:
+            armed, message = await self.arm_guard(True, request.force_threshold, request.torque_threshold,
+                                                  request.tracking_error_threshold)
+            if not armed:
+                target, result.message = None, f"Cannot arm the guard: {message}"
+        if target is None:
+            self.get_logger().warn(result.message)
+            goal_handle.abort()
+            return result
+
+        def make_feedback(progress, time_remaining):
+            feedback = GuardedMove.Feedback()
+            feedback.joint_positions = self.state.joint_positions.tolist()
+            feedback.progress = progress
+            feedback.time_remaining = time_remaining
+            return feedback
+
+        t0 = self.get_clock().now()
+        with self.motion_lock:
+            future = self.start_motion(goal_handle, target, make_feedback)
+            # a collision latched while the guard was armed refuses the start
+            motion = self.active_motion if self.active_motion is not None and self.active_motion.future is future else None
+            if motion is not None:
+                motion.guarded = True
+        status, result.message = await future
+
+        # The guard holds the robot until released, so give the trajectory controller
+        # time to come to rest at the held pose first. Queued moves start after that.
+        if status in (ActiveMotion.CONTACT, ActiveMotion.CANCELED):
+            await self.delay(self.get_parameter("stop_time").value)
+        with self.motion_lock:
+            rearmed = self.active_motion is not None and self.active_motion.guarded  # preempted by another guarded move
+        # a latched collision keeps the guard holding the robot, reset_collision releases it
+        if not rearmed and not self.collision_latched:
+            released, message = await self.arm_guard(False)
+            if not released:
+                self.get_logger().error(f"Cannot release the guard: {message}")
+
+        result.contact = status == ActiveMotion.CONTACT
+        result.success = result.contact
+        result.duration = (self.get_clock().now() - t0).nanoseconds * 1e-9
+        if result.contact and motion is not None:
+            result.contact_event = motion.contact_event
+            goal_handle.succeed()
+        elif status == ActiveMotion.CANCELED:
+            goal_handle.canceled()
+        else:
+            if status == ActiveMotion.SUCCEEDED:
+                result.message = "Target reached without contact."
+            goal_handle.abort()
+        self.get_logger().info(f"Guarded move {status}: {result.message}")
+        return result
+
+    def interpolate_path(self, path, t, T, mode):
+        # Time scale along the arc length of the path, so a multi waypoint path
+        # gets the same velocity profile as a single straight segment.
+        if len(path) == 2:
+            return self.interpolate_joint_trajectory(path[0], path[1], t, T, mode)
+
+        seg_lengths = np.linalg.norm(np.diff(path, axis=0), axis=1)
+        total_length = np.sum(seg_lengths)
+        if total_length < 1e-9:
+            zeros = np.zeros_like(path[0])
+            return path[-1].copy(), zeros, zeros
+
+        s, s_dot, s_ddot = self.interpolate_joint_trajectory(np.zeros(1), np.array([total_length]), t, T, mode)
+        s, s_dot, s_ddot = s[0], s_dot[0], s_ddot[0]
+
+        cumulative = np.concatenate(([0.0], np.cumsum(seg_lengths)))
+        k = min(np.searchsorted(cumulative, s, side="right") - 1, len(seg_lengths) - 1)
+        k = max(k, 0)
+        direction = (path[k + 1] - path[k]) / max(seg_lengths[k], 1e-12)
+
+        pos = path[k] + direction * (s - cumulative[k])
+        vel = direction * s_dot
+        acc = direction * s_ddot
+        return pos, vel, acc
 
 def main(args=None):
     rclpy.init(args=args)
     node = KinematicsNode()
-    rclpy.spin(node)
-    rclpy.shutdown()
+    executor = MultiThreadedExecutor(num_threads=node.get_parameter("executor_threads").value)
+    executor.add_node(node)
+    try:
+        executor.spin()
+    finally:
+        node.planning_pool.shutdown(wait=False, cancel_futures=True)
+        if node.state_shm is not None:
+            node.state_shm.close()
+        if node.plan_cache is not None:
+            node.plan_cache.save()
+        rclpy.shutdown()
@@ -0,0 +1,106 @@
+# state_shm.py
+
+import struct
+import time
+from collections import namedtuple
+from multiprocessing import resource_tracker
+from multiprocessing.shared_memory import SharedMemory
+
+# Latest robot state in a shared memory segment, for clients on the same host that
+# poll faster than a service round trip allows. One writer (robot_motion_node),
+# any number of readers, synchronised with a seqlock: the writer makes the sequence
+# odd while it writes, readers retry if it was odd or changed during their copy.
+
+MAGIC = 0x524D5348  # "RMSH"
+LAYOUT_VERSION = 1
+
+HEADER = struct.Struct("<II")  # magic, layout version
+SEQUENCE = struct.Struct("<Q")
+PAYLOAD = struct.Struct("<Qdd6d3d4dI4x")  # version, stamp, write time, joints, position, quaternion, flags
+SEQUENCE_OFFSET = HEADER.size
+PAYLOAD_OFFSET = SEQUENCE_OFFSET + SEQUENCE.size
+SIZE = PAYLOAD_OFFSET + PAYLOAD.size
+
+FLAG_MOTION_ACTIVE = 1
+
+RobotState = namedtuple("RobotState", [
+    "version",          # KinematicState version
+    "stamp",            # /joint_states stamp in s
+    "write_time",       # time.time() of the write
+    "joint_positions",  # rad
+    "tcp_position",     # mm
+    "tcp_quaternion",   # x, y, z, w
+    "motion_active",
+])
+
+
+class StateWriter:
+    def __init__(self, name):
+        try:
+            self.shm = SharedMemory(name=name, create=True, size=SIZE)
+        except FileExistsError:
+            # left over from a previous run, readers of the old one go stale and reattach
+            old = SharedMemory(name=name)
+            old.close()
+            old.unlink()
+            self.shm = SharedMemory(name=name, create=True, size=SIZE)
+        self.sequence = 0
+        HEADER.pack_into(self.shm.buf, 0, MAGIC, LAYOUT_VERSION)
+        SEQUENCE.pack_into(self.shm.buf, SEQUENCE_OFFSET, self.sequence)
+
+    def write(self, state, motion_active):
+        buf = self.shm.buf
+        self.sequence += 1
+        SEQUENCE.pack_into(buf, SEQUENCE_OFFSET, self.sequence)
+        PAYLOAD.pack_into(buf, PAYLOAD_OFFSET,
+                          state.version,
+                          state.stamp.sec + state.stamp.nanosec * 1e-9,
+                          time.time(),
+                          *state.joint_positions,
+                          *state.tcp[:3, 3],
+                          *state.tcp_quaternion,
+                          FLAG_MOTION_ACTIVE if motion_active else 0)
+        self.sequence += 1
+        SEQUENCE.pack_into(buf, SEQUENCE_OFFSET, self.sequence)
+
+    def close(self):
+        self.shm.close()
+        self.shm.unlink()
+
+
+class StateReader:
+    # Raises FileNotFoundError if there is no segment, i.e. the motion node runs on
+    # another host or is not up yet.
+
+    def __init__(self, name):
+        try:
+            self.shm = SharedMemory(name=name, track=False)
+        except TypeError:
+            # before Python 3.13 the resource tracker would unlink the writer's segment
+            # when this process exits
+            self.shm = SharedMemory(name=name)
+            resource_tracker.unregister(self.shm._name, "shared_memory")
+
+        magic, layout_version = HEADER.unpack_from(self.shm.buf, 0)
+        if magic != MAGIC or layout_version != LAYOUT_VERSION or self.shm.size < SIZE:
+            self.shm.close()
+            raise ValueError(f"Shared memory segment '{name}' has an unknown layout.")
+
+    def read(self, retries=100):
+        # None if no consistent copy could be taken or nothing was written yet
+        buf = self.shm.buf
+        for _ in range(retries):
+            sequence = SEQUENCE.unpack_from(buf, SEQUENCE_OFFSET)[0]
+            if sequence & 1:
+                continue
+            values = PAYLOAD.unpack_from(buf, PAYLOAD_OFFSET)
+            if SEQUENCE.unpack_from(buf, SEQUENCE_OFFSET)[0] != sequence:
+                continue
+            if sequence == 0:
+                return None
+            return RobotState(values[0], values[1], values[2], values[3:9], values[9:12], values[12:16],
+                              bool(values[16] & FLAG_MOTION_ACTIVE))
+        return None
+
+    def close(self):
+        self.shm.close()
@@ -69,6 +69,7 @@ J_symbolic = simplify(Matrix.hstack(*cols))
 
 # Numerical funcions
 T_06_func = lambdify(thetas, T_06_symbolic, modules='numpy')
+link_frames_func = lambdify(thetas, [T_01_symbolic, T_02_symbolic, T_03_symbolic, T_04_symbolic, T_05_symbolic, T_06_symbolic], modules='numpy')
 T_01_func = lambdify((theta_1,), T_01_symbolic, modules="numpy")
 R_03_func = lambdify((theta_1, theta_2, theta_3), T_03_symbolic[:3, :3], modules="numpy")
 J_func = lambdify(thetas, J_symbolic, modules='numpy')
\ No newline at end of file
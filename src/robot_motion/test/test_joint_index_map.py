@@ -0,0 +1,32 @@
+import pytest
+
+from robot_motion.joint_index_map import JointIndexMap
+
+JOINTS = ["joint_1", "joint_2", "joint_3"]
+
+
+def test_reorders_positions():
+    joint_map = JointIndexMap(JOINTS)
+    names = ["joint_3", "joint_1", "gripper", "joint_2"]
+    assert joint_map(names, [3.0, 1.0, 9.0, 2.0]) == [1.0, 2.0, 3.0]
+
+
+def test_resolves_again_when_the_name_order_changes():
+    joint_map = JointIndexMap(JOINTS)
+    assert joint_map(JOINTS, [1.0, 2.0, 3.0]) == [1.0, 2.0, 3.0]
+    assert joint_map(["joint_2", "joint_3", "joint_1"], [2.0, 3.0, 1.0]) == [1.0, 2.0, 3.0]
+    assert joint_map.names == ["joint_2", "joint_3", "joint_1"]
+
+
+def test_missing_joints_raise_key_error():
+    joint_map = JointIndexMap(JOINTS)
+    with pytest.raises(KeyError, match="joint_2, joint_3"):
+        joint_map(["joint_1"], [1.0])
+
+
+def test_short_positions_raise_index_error():
+    joint_map = JointIndexMap(JOINTS)
+    with pytest.raises(IndexError):
+        joint_map(JOINTS, [1.0, 2.0])
+    # the cached order is kept for the next complete message
+    assert joint_map(JOINTS, [1.0, 2.0, 3.0]) == [1.0, 2.0, 3.0]
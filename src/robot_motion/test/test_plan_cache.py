@@ -0,0 +1,97 @@
+from types import SimpleNamespace
+
+from robot_motion.plan_cache import PlanCache
+
+SETTINGS = ("rrt_connect", "cubic", 5.0, 50)
+
+
+def make_trajectory(value):
+    point = SimpleNamespace(
+        positions=[value] * 6,
+        velocities=[0.0] * 6,
+        accelerations=[0.0] * 6,
+        time_from_start=SimpleNamespace(sec=2, nanosec=250),
+    )
+    return SimpleNamespace(points=[point])
+
+
+def test_quantised_starts_and_goals_hit():
+    cache = PlanCache(capacity=4, resolution=1e-3)
+    cache.put(cache.make_key([0.1] * 6, [0.5] * 6, 42, SETTINGS), make_trajectory(1.0), 0.2)
+
+    hit = cache.get(cache.make_key([0.1 + 2e-4] * 6, [0.5 - 2e-4] * 6, 42, SETTINGS))
+    assert hit is not None
+    assert hit.positions == [[1.0] * 6]
+    assert cache.get(cache.make_key([0.102] * 6, [0.5] * 6, 42, SETTINGS)) is None
+    assert cache.get(cache.make_key([0.1] * 6, [0.5] * 6, 43, SETTINGS)) is None
+    assert cache.get(cache.make_key([0.1] * 6, [0.5] * 6, 42, ("none", "cubic", 5.0, 50))) is None
+    assert (cache.hits, cache.misses) == (1, 3)
+    assert cache.saved_time == 0.2
+    assert cache.hit_rate() == 0.25
+
+
+def test_least_recently_used_entry_is_evicted():
+    cache = PlanCache(capacity=2)
+    keys = [cache.make_key([i] * 6, [0.0] * 6, 0, SETTINGS) for i in range(3)]
+    cache.put(keys[0], make_trajectory(0.0), 0.1)
+    cache.put(keys[1], make_trajectory(1.0), 0.1)
+    cache.get(keys[0])
+    cache.put(keys[2], make_trajectory(2.0), 0.1)
+
+    assert list(cache.entries) == [keys[0], keys[2]]
+    assert cache.get(keys[1]) is None
+
+
+def test_save_load_round_trip(tmp_path):
+    path = str(tmp_path / "plans.json")
+    cache = PlanCache(capacity=4, resolution=1e-3, path=path)
+    keys = [cache.make_key([i] * 6, [0.5] * 6, 2**63 + i, SETTINGS) for i in range(3)]
+    for i, key in enumerate(keys):
+        cache.put(key, make_trajectory(float(i)), 0.1 * i)
+    cache.get(keys[0])
+    cache.save()
+
+    loaded = PlanCache(capacity=4, resolution=1e-3, path=path)
+    assert loaded.load_error is None
+    assert list(loaded.entries) == [keys[1], keys[2], keys[0]]
+    entry = loaded.get(keys[2])
+    assert entry.positions == [[2.0] * 6]
+    assert entry.times == [(2, 250)]
+    assert entry.compute_time == 0.2
+
+    # a smaller capacity keeps the most recently used entries
+    assert list(PlanCache(capacity=2, resolution=1e-3, path=path).entries) == [keys[2], keys[0]]
+
+
+def test_resolution_mismatch_starts_empty(tmp_path):
+    path = str(tmp_path / "plans.json")
+    cache = PlanCache(capacity=4, resolution=1e-3, path=path)
+    cache.put(cache.make_key([0.0] * 6, [0.5] * 6, 1, SETTINGS), make_trajectory(1.0), 0.1)
+    cache.save()
+
+    loaded = PlanCache(capacity=4, resolution=1e-2, path=path)
+    assert not loaded.entries
+    assert loaded.load_error is not None
+
+
+def test_version_mismatch_starts_empty(tmp_path):
+    path = tmp_path / "plans.json"
+    path.write_text('{"version": 1, "resolution": 0.001, "entries": []}')
+    loaded = PlanCache(capacity=4, resolution=1e-3, path=str(path))
+    assert not loaded.entries
+    assert loaded.load_error is not None
+
+
+def test_corrupt_file_starts_empty(tmp_path):
+    path = tmp_path / "plans.json"
+    for content in ["{not json", '{"version": 2, "resolution": 0.001, "entries": [[1, 2]]}', "[]"]:
+        path.write_text(content)
+        loaded = PlanCache(capacity=4, resolution=1e-3, path=str(path))
+        assert not loaded.entries
+        assert loaded.load_error is not None
+
+
+def test_missing_file_starts_empty(tmp_path):
+    loaded = PlanCache(capacity=4, resolution=1e-3, path=str(tmp_path / "missing.json"))
+    assert not loaded.entries
+    assert loaded.load_error is None
@@ -0,0 +1,107 @@
+import os
+import threading
+from multiprocessing import resource_tracker
+from types import SimpleNamespace
+
+import numpy as np
+import pytest
+
+from robot_motion import state_shm
+from robot_motion.state_shm import StateReader, StateWriter
+
+
+def make_state(version):
+    # every field derived from the version, so a torn copy shows up as a mismatch
+    tcp = np.eye(4)
+    tcp[:3, 3] = [version, version + 1.0, version + 2.0]
+    return SimpleNamespace(
+        version=version,
+        stamp=SimpleNamespace(sec=version, nanosec=500000000),
+        joint_positions=[float(version)] * 6,
+        tcp=tcp,
+        tcp_quaternion=[0.0, 0.0, 0.0, float(version)],
+    )
+
+
+def check_consistent(state):
+    assert state.stamp == state.version + 0.5
+    assert state.joint_positions == (float(state.version),) * 6
+    assert state.tcp_position == (state.version, state.version + 1.0, state.version + 2.0)
+    assert state.tcp_quaternion == (0.0, 0.0, 0.0, float(state.version))
+
+
+@pytest.fixture
+def segment():
+    writer = StateWriter(f"robot_motion_test_{os.getpid()}")
+    reader = StateReader(writer.shm.name)
+    # before Python 3.13 the reader unregistered the segment, here that is the
+    # writer's own registration, which its unlink drops again
+    resource_tracker.register(writer.shm._name, "shared_memory")
+    yield writer, reader
+    reader.close()
+    writer.close()
+
+
+def test_nothing_written_reads_none(segment):
+    _, reader = segment
+    assert reader.read() is None
+
+
+def test_round_trip(segment):
+    writer, reader = segment
+    writer.write(make_state(7), motion_active=True)
+    state = reader.read()
+    assert state.version == 7
+    assert state.motion_active
+    check_consistent(state)
+
+    writer.write(make_state(8), motion_active=False)
+    state = reader.read()
+    assert state.version == 8
+    assert not state.motion_active
+
+
+def test_odd_sequence_is_retried(segment):
+    writer, reader = segment
+    writer.write(make_state(3), motion_active=False)
+    # a writer stopped in the middle of a write
+    state_shm.SEQUENCE.pack_into(writer.shm.buf, state_shm.SEQUENCE_OFFSET, writer.sequence + 1)
+    assert reader.read(retries=10) is None
+    state_shm.SEQUENCE.pack_into(writer.shm.buf, state_shm.SEQUENCE_OFFSET, writer.sequence)
+    assert reader.read().version == 3
+
+
+def test_reads_are_never_torn(segment):
+    writer, reader = segment
+    writer.write(make_state(1), motion_active=False)
+    stop = threading.Event()
+
+    def write_loop():
+        version = 1
+        while not stop.is_set():
+            version += 1
+            writer.write(make_state(version), motion_active=False)
+
+    thread = threading.Thread(target=write_loop)
+    thread.start()
+    try:
+        for _ in range(2000):
+            state = reader.read()
+            if state is not None:
+                check_consistent(state)
+    finally:
+        stop.set()
+        thread.join()
+
+
+def test_unknown_layout_is_rejected(segment):
+    writer, _ = segment
+    state_shm.HEADER.pack_into(writer.shm.buf, 0, state_shm.MAGIC, state_shm.LAYOUT_VERSION + 1)
+    with pytest.raises(ValueError):
+        StateReader(writer.shm.name)
+    resource_tracker.register(writer.shm._name, "shared_memory")
+
+
+def test_missing_segment_raises():
+    with pytest.raises(FileNotFoundError):
+        StateReader(f"robot_motion_test_missing_{os.getpid()}")
@@ -0,0 +1,61 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_MOTION_CPP__BATCH_KINEMATICS_HPP_
+#define ROBOT_MOTION_CPP__BATCH_KINEMATICS_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "robot_planning/kinematics.hpp"
+
+namespace robot_motion_cpp
+{
+  // Flat layouts of the BatchForwardKinematics / BatchInverseKinematics services
+  constexpr std::size_t POSE_SIZE = 7; // x, y, z, qx, qy, qz, qw
+
+  // values match the constants in BatchInverseKinematics.srv
+  enum class IKStatus : std::uint8_t
+  {
+    SOLVED = 0,
+    UNREACHABLE = 1,
+    INVALID_POSE = 2,
+  };
+
+  struct BatchIKResult
+  {
+    std::vector<std::uint8_t> status;
+    std::vector<std::uint32_t> solution_offsets;
+    std::vector<double> joint_positions;
+    std::vector<std::uint8_t> branches;
+  };
+
+  // joint_positions holds NUM_JOINTS values per entry, poses is resized to POSE_SIZE per entry
+  void batch_forward_kinematics(const std::vector<double> &joint_positions, std::vector<double> &poses,
+                                std::size_t num_threads);
+
+  // seeds is empty or holds NUM_JOINTS values per entry, see BatchInverseKinematics.srv
+  void batch_inverse_kinematics(const std::vector<double> &poses, const std::vector<double> &seeds,
+                                const robot_planning::JointLimits &limits, std::size_t num_threads,
+                                BatchIKResult &result);
+
+} // namespace robot_motion_cpp
+
+#endif // ROBOT_MOTION_CPP__BATCH_KINEMATICS_HPP_
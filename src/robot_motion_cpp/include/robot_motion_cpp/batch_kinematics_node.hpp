@@ -0,0 +1,70 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_MOTION_CPP__BATCH_KINEMATICS_NODE_HPP_
+#define ROBOT_MOTION_CPP__BATCH_KINEMATICS_NODE_HPP_
+
+#include <mutex>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "robot_motion_interfaces/srv/batch_forward_kinematics.hpp"
+#include "robot_motion_interfaces/srv/batch_inverse_kinematics.hpp"
+#include "std_msgs/msg/string.hpp"
+
+#include "robot_motion_cpp/batch_kinematics.hpp"
+
+namespace robot_motion_cpp
+{
+  // FK/IK for large batches of poses (workspace sweeps, reachability maps). Requests
+  // are flat arrays so a 100k entry batch is a handful of contiguous buffers, and the
+  // entries are split over a thread pool.
+  class BatchKinematicsNode : public rclcpp::Node
+  {
+  public:
+    explicit BatchKinematicsNode(const rclcpp::NodeOptions &options);
+
+  private:
+    using BatchForwardKinematics = robot_motion_interfaces::srv::BatchForwardKinematics;
+    using BatchInverseKinematics = robot_motion_interfaces::srv::BatchInverseKinematics;
+
+    void forward_kinematics_callback(const BatchForwardKinematics::Request &request,
+                                     BatchForwardKinematics::Response &response);
+    void inverse_kinematics_callback(const BatchInverseKinematics::Request &request,
+                                     BatchInverseKinematics::Response &response);
+
+    bool check_batch(std::size_t size, std::size_t stride, const char *field, std::size_t &n,
+                     std::string &message) const;
+    std::size_t num_threads() const;
+
+    // from the URDF on /robot_description, read by the service callbacks on their own group
+    std::mutex limits_mutex_;
+    robot_planning::JointLimits limits_;
+    bool has_limits_ = false;
+
+    rclcpp::CallbackGroup::SharedPtr callback_group_;
+    rclcpp::Subscription<std_msgs::msg::String>::SharedPtr robot_description_sub_;
+    rclcpp::Service<BatchForwardKinematics>::SharedPtr fk_service_;
+    rclcpp::Service<BatchInverseKinematics>::SharedPtr ik_service_;
+  };
+
+} // namespace robot_motion_cpp
+
+#endif // ROBOT_MOTION_CPP__BATCH_KINEMATICS_NODE_HPP_
@@ -0,0 +1,58 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_MOTION_CPP__JOINT_INDEX_MAP_HPP_
+#define ROBOT_MOTION_CPP__JOINT_INDEX_MAP_HPP_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "robot_planning/kinematics.hpp"
+
+namespace robot_motion_cpp
+{
+  using robot_planning::JointVector;
+
+  // Caches where each joint sits in a message's name list. Publishers keep their
+  // name order, so after the first message decoding is a name compare and a
+  // fixed gather. Same as robot_motion/joint_index_map.py.
+  class JointIndexMap
+  {
+  public:
+    explicit JointIndexMap(const std::vector<std::string> &joint_names);
+
+    // Writes the positions in joint name order to q. On failure returns false
+    // and sets `missing` to the first joint without a position.
+    bool gather(const std::vector<std::string> &names, const std::vector<double> &positions, JointVector &q,
+                std::string &missing);
+
+  private:
+    bool resolve(const std::vector<std::string> &names, std::string &missing);
+
+    std::vector<std::string> joint_names_;
+    std::vector<std::string> names_; // name order the indices were resolved for
+    std::array<std::size_t, robot_planning::NUM_JOINTS> indices_{};
+    bool valid_ = false;
+  };
+
+} // namespace robot_motion_cpp
+
+#endif // ROBOT_MOTION_CPP__JOINT_INDEX_MAP_HPP_
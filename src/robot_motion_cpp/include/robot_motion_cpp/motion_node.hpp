@@ -0,0 +1,95 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_MOTION_CPP__MOTION_NODE_HPP_
+#define ROBOT_MOTION_CPP__MOTION_NODE_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "geometry_msgs/msg/pose_stamped.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "robot_motion_interfaces/srv/get_cartesian_space_pose.hpp"
+#include "robot_motion_interfaces/srv/get_joint_space_pose.hpp"
+#include "robot_motion_interfaces/srv/plan_joint_path.hpp"
+#include "sensor_msgs/msg/joint_state.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+
+#include "robot_motion_cpp/joint_index_map.hpp"
+#include "robot_motion_cpp/trajectory.hpp"
+
+namespace robot_motion_cpp
+{
+  // C++ port of robot_motion_node.py as a composable node. Run it in the process of
+  // the controller manager (robot_control_node) with intra-process communication
+  // enabled so trajectories are handed over as unique_ptr instead of serialised.
+  class MotionNode : public rclcpp::Node
+  {
+  public:
+    explicit MotionNode(const rclcpp::NodeOptions &options);
+
+  private:
+    using JointTrajectory = trajectory_msgs::msg::JointTrajectory;
+    using GetCartesianSpacePose = robot_motion_interfaces::srv::GetCartesianSpacePose;
+    using GetJointSpacePose = robot_motion_interfaces::srv::GetJointSpacePose;
+    using PlanJointPath = robot_motion_interfaces::srv::PlanJointPath;
+
+    void robot_description_callback(const std_msgs::msg::String &msg);
+    void joint_states_callback(const sensor_msgs::msg::JointState &msg);
+    void cartesian_space_goal_pose_setter_callback(const geometry_msgs::msg::PoseStamped &msg);
+    void joint_space_goal_pose_setter_callback(const sensor_msgs::msg::JointState &msg);
+    void cartesian_space_pose_getter_callback(const GetCartesianSpacePose::Request &request,
+                                              GetCartesianSpacePose::Response &response);
+    void joint_space_pose_getter_callback(const GetJointSpacePose::Request &request,
+                                          GetJointSpacePose::Response &response);
+
+    bool to_joint_vector(JointIndexMap &map, const std::vector<std::string> &names,
+                         const std::vector<double> &positions, JointVector &q) const;
+
+    void send_joint_motion(const JointVector &start, const JointVector &target);
+    void plan_done_callback(rclcpp::Client<PlanJointPath>::SharedFuture future);
+
+    std::unique_ptr<JointTrajectory> build_trajectory(const Path &path) const;
+    std::unique_ptr<JointTrajectory> build_timed_trajectory(const Path &path, const std::vector<double> &times) const;
+    void publish_trajectory(std::unique_ptr<JointTrajectory> trajectory);
+
+    std::vector<std::string> joint_names_;
+    JointIndexMap joint_states_map_;
+    JointIndexMap joint_goal_map_;
+    robot_planning::JointLimits limits_; // from the URDF on /robot_description
+    bool has_limits_ = false;
+    JointVector current_joint_positions_;
+    bool has_joint_state_ = false;
+
+    rclcpp::Publisher<JointTrajectory>::SharedPtr traj_pub_;
+    rclcpp::Subscription<std_msgs::msg::String>::SharedPtr robot_description_sub_;
+    rclcpp::Subscription<sensor_msgs::msg::JointState>::SharedPtr joint_states_sub_;
+    rclcpp::Subscription<geometry_msgs::msg::PoseStamped>::SharedPtr cartesian_goal_sub_;
+    rclcpp::Subscription<sensor_msgs::msg::JointState>::SharedPtr joint_goal_sub_;
+    rclcpp::Service<GetCartesianSpacePose>::SharedPtr cartesian_pose_service_;
+    rclcpp::Service<GetJointSpacePose>::SharedPtr joint_pose_service_;
+    rclcpp::Client<PlanJointPath>::SharedPtr plan_client_;
+  };
+
+} // namespace robot_motion_cpp
+
+#endif // ROBOT_MOTION_CPP__MOTION_NODE_HPP_
@@ -0,0 +1,62 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_MOTION_CPP__TRAJECTORY_HPP_
+#define ROBOT_MOTION_CPP__TRAJECTORY_HPP_
+
+#include <string>
+
+#include "robot_planning/kinematics.hpp"
+#include "robot_planning/planner.hpp"
+
+namespace robot_motion_cpp
+{
+  using robot_planning::JointVector;
+  using robot_planning::Path;
+
+  // Same profiles as interpolate_joint_trajectory in robot_motion_node.py
+  enum class Interpolation
+  {
+    LINEAR,
+    CUBIC,
+    QUINTIC,
+  };
+
+  // unknown names fall back to linear, like the Python node
+  Interpolation interpolation_from_string(const std::string &name);
+
+  struct TrajectorySample
+  {
+    JointVector position;
+    JointVector velocity;
+    JointVector acceleration;
+  };
+
+  // q0 -> qf at normalised time t in [0, 1] of a motion lasting T seconds
+  TrajectorySample interpolate_segment(const JointVector &q0, const JointVector &qf, double t, double T,
+                                       Interpolation mode);
+
+  // Time scales along the arc length of the path, so a multi waypoint path gets the
+  // same velocity profile as a single straight segment.
+  TrajectorySample interpolate_path(const Path &path, double t, double T, Interpolation mode);
+
+} // namespace robot_motion_cpp
+
+#endif // ROBOT_MOTION_CPP__TRAJECTORY_HPP_
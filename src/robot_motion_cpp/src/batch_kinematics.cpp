@@ -0,0 +1,134 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_motion_cpp/batch_kinematics.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "robot_planning/parallel.hpp"
+
+namespace robot_motion_cpp
+{
+  using robot_planning::NUM_JOINTS;
+
+  void batch_forward_kinematics(const std::vector<double> &joint_positions, std::vector<double> &poses,
+                                std::size_t num_threads)
+  {
+    const std::size_t n = joint_positions.size() / NUM_JOINTS;
+    poses.resize(n * POSE_SIZE);
+    robot_planning::parallel_for(n, num_threads, [&](std::size_t begin, std::size_t end, std::size_t)
+                                 {
+                                   for (std::size_t i = begin; i < end; i++)
+                                   {
+                                     const robot_planning::JointVector q =
+                                         Eigen::Map<const robot_planning::JointVector>(&joint_positions[i * NUM_JOINTS]);
+                                     const Eigen::Isometry3d T = robot_planning::forward_kinematics(q);
+                                     const Eigen::Quaterniond quat(T.linear());
+                                     double *pose = &poses[i * POSE_SIZE];
+                                     pose[0] = T.translation().x();
+                                     pose[1] = T.translation().y();
+                                     pose[2] = T.translation().z();
+                                     pose[3] = quat.x();
+                                     pose[4] = quat.y();
+                                     pose[5] = quat.z();
+                                     pose[6] = quat.w();
+                                   } });
+  }
+
+  void batch_inverse_kinematics(const std::vector<double> &poses, const std::vector<double> &seeds,
+                                const robot_planning::JointLimits &limits, std::size_t num_threads,
+                                BatchIKResult &result)
+  {
+    const std::size_t n = poses.size() / POSE_SIZE;
+    const bool closest_only = !seeds.empty();
+    result.status.resize(n);
+    std::vector<std::uint32_t> counts(n);
+
+    // parallel_for hands out contiguous ranges in worker order, so concatenating the
+    // per worker buffers keeps the solutions in entry order
+    num_threads = std::max<std::size_t>(1, std::min(num_threads, n));
+    std::vector<std::vector<robot_planning::IKSolution>> worker_solutions(num_threads);
+    robot_planning::parallel_for(n, num_threads, [&](std::size_t begin, std::size_t end, std::size_t worker)
+                                 {
+                                   auto &out = worker_solutions[worker];
+                                   out.reserve((end - begin) * (closest_only ? 1 : 4));
+                                   robot_planning::IKSolutions solutions;
+                                   for (std::size_t i = begin; i < end; i++)
+                                   {
+                                     const double *pose = &poses[i * POSE_SIZE];
+                                     Eigen::Quaterniond quat(pose[6], pose[3], pose[4], pose[5]);
+                                     if (!(quat.norm() > 1e-9))
+                                     {
+                                       result.status[i] = static_cast<std::uint8_t>(IKStatus::INVALID_POSE);
+                                       counts[i] = 0;
+                                       continue;
+                                     }
+                                     Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+                                     T.linear() = quat.normalized().toRotationMatrix();
+                                     T.translation() << pose[0], pose[1], pose[2];
+
+                                     std::size_t count = robot_planning::inverse_kinematics(T, limits, solutions);
+                                     result.status[i] = static_cast<std::uint8_t>(count > 0 ? IKStatus::SOLVED : IKStatus::UNREACHABLE);
+                                     if (closest_only && count > 0)
+                                     {
+                                       const robot_planning::JointVector seed =
+                                           Eigen::Map<const robot_planning::JointVector>(&seeds[i * NUM_JOINTS]);
+                                       std::size_t best = 0;
+                                       double best_distance = std::numeric_limits<double>::infinity();
+                                       for (std::size_t k = 0; k < count; k++)
+                                       {
+                                         const double distance = (solutions[k].q - seed).squaredNorm();
+                                         if (distance < best_distance)
+                                         {
+                                           best_distance = distance;
+                                           best = k;
+                                         }
+                                       }
+                                       solutions[0] = solutions[best];
+                                       count = 1;
+                                     }
+                                     counts[i] = static_cast<std::uint32_t>(count);
+                                     out.insert(out.end(), solutions.begin(), solutions.begin() + count);
+                                   } });
+
+    result.solution_offsets.resize(n + 1);
+    result.solution_offsets[0] = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+      result.solution_offsets[i + 1] = result.solution_offsets[i] + counts[i];
+    }
+
+    const std::size_t total = result.solution_offsets[n];
+    result.joint_positions.resize(total * NUM_JOINTS);
+    result.branches.resize(total);
+    std::size_t k = 0;
+    for (const auto &chunk : worker_solutions)
+    {
+      for (const robot_planning::IKSolution &solution : chunk)
+      {
+        Eigen::Map<robot_planning::JointVector>(&result.joint_positions[k * NUM_JOINTS]) = solution.q;
+        result.branches[k] = solution.branch;
+        k++;
+      }
+    }
+  }
+
+} // namespace robot_motion_cpp
@@ -0,0 +1,175 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_motion_cpp/batch_kinematics_node.hpp"
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rclcpp_components/register_node_macro.hpp"
+#include "robot_planning/parallel.hpp"
+
+namespace robot_motion_cpp
+{
+  using robot_planning::NUM_JOINTS;
+
+  BatchKinematicsNode::BatchKinematicsNode(const rclcpp::NodeOptions &options)
+      : Node("batch_kinematics_node", options)
+  {
+    robot_description_sub_ = create_subscription<std_msgs::msg::String>(
+        "/robot_description", rclcpp::QoS(1).transient_local(), [this](const std_msgs::msg::String &msg)
+        {
+          std::vector<std::string> joint_names;
+          for (std::size_t i = 0; i < NUM_JOINTS; i++)
+          {
+            joint_names.push_back("joint_" + std::to_string(i + 1));
+          }
+          try
+          {
+            const auto limits = robot_planning::JointLimits::from_urdf(msg.data, joint_names);
+            std::lock_guard<std::mutex> lock(limits_mutex_);
+            limits_ = limits;
+            has_limits_ = true;
+          }
+          catch (const std::exception &e)
+          {
+            RCLCPP_ERROR(get_logger(), "Cannot read the joint limits: %s", e.what());
+          }
+        });
+    declare_parameter("num_threads", 0); // 0 uses all hardware threads
+    declare_parameter("max_batch_size", 100000);
+
+    // own group so a long batch does not hold up other nodes in a multi-threaded executor
+    callback_group_ = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+
+    fk_service_ = create_service<BatchForwardKinematics>(
+        "/robot_motion/batch_forward_kinematics",
+        [this](const std::shared_ptr<BatchForwardKinematics::Request> request, std::shared_ptr<BatchForwardKinematics::Response> response)
+        { forward_kinematics_callback(*request, *response); },
+        rclcpp::ServicesQoS(), callback_group_);
+    ik_service_ = create_service<BatchInverseKinematics>(
+        "/robot_motion/batch_inverse_kinematics",
+        [this](const std::shared_ptr<BatchInverseKinematics::Request> request, std::shared_ptr<BatchInverseKinematics::Response> response)
+        { inverse_kinematics_callback(*request, *response); },
+        rclcpp::ServicesQoS(), callback_group_);
+
+    RCLCPP_INFO(get_logger(), "Batch kinematics node ready (%zu threads).", num_threads());
+  }
+
+  std::size_t BatchKinematicsNode::num_threads() const
+  {
+    const int64_t threads = get_parameter("num_threads").as_int();
+    return threads > 0 ? static_cast<std::size_t>(threads) : robot_planning::default_thread_count();
+  }
+
+  bool BatchKinematicsNode::check_batch(std::size_t size, std::size_t stride, const char *field, std::size_t &n,
+                                        std::string &message) const
+  {
+    if (size % stride != 0)
+    {
+      message = std::string(field) + " must hold " + std::to_string(stride) + " values per entry.";
+      return false;
+    }
+    n = size / stride;
+    const int64_t max_batch_size = get_parameter("max_batch_size").as_int();
+    if (static_cast<int64_t>(n) > max_batch_size)
+    {
+      message = "Batch of " + std::to_string(n) + " entries exceeds max_batch_size " + std::to_string(max_batch_size) + ".";
+      return false;
+    }
+    return true;
+  }
+
+  void BatchKinematicsNode::forward_kinematics_callback(const BatchForwardKinematics::Request &request,
+                                                        BatchForwardKinematics::Response &response)
+  {
+    std::size_t n;
+    if (!check_batch(request.joint_positions.size(), NUM_JOINTS, "joint_positions", n, response.message))
+    {
+      RCLCPP_WARN(get_logger(), "%s", response.message.c_str());
+      response.success = false;
+      return;
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    batch_forward_kinematics(request.joint_positions, response.poses, num_threads());
+    const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    response.success = true;
+    response.message = "Solved " + std::to_string(n) + " poses.";
+    RCLCPP_DEBUG(get_logger(), "Batch FK of %zu entries took %.2f ms.", n, elapsed);
+  }
+
+  void BatchKinematicsNode::inverse_kinematics_callback(const BatchInverseKinematics::Request &request,
+                                                        BatchInverseKinematics::Response &response)
+  {
+    std::size_t n;
+    if (!check_batch(request.poses.size(), POSE_SIZE, "poses", n, response.message))
+    {
+      RCLCPP_WARN(get_logger(), "%s", response.message.c_str());
+      response.success = false;
+      return;
+    }
+    if (!request.seeds.empty() && request.seeds.size() != n * NUM_JOINTS)
+    {
+      response.message = "seeds must be empty or hold " + std::to_string(NUM_JOINTS) + " values per pose.";
+      RCLCPP_WARN(get_logger(), "%s", response.message.c_str());
+      response.success = false;
+      return;
+    }
+
+    robot_planning::JointLimits limits;
+    {
+      std::lock_guard<std::mutex> lock(limits_mutex_);
+      if (!has_limits_)
+      {
+        response.message = "No robot description received yet, joint limits unknown.";
+        RCLCPP_WARN(get_logger(), "%s", response.message.c_str());
+        response.success = false;
+        return;
+      }
+      limits = limits_;
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    BatchIKResult result;
+    batch_inverse_kinematics(request.poses, request.seeds, limits, num_threads(), result);
+    const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    std::size_t solved = 0;
+    for (std::uint8_t status : result.status)
+    {
+      solved += status == BatchInverseKinematics::Response::SOLVED;
+    }
+
+    response.status = std::move(result.status);
+    response.solution_offsets = std::move(result.solution_offsets);
+    response.joint_positions = std::move(result.joint_positions);
+    response.branches = std::move(result.branches);
+    response.success = true;
+    response.message = "Solved " + std::to_string(solved) + " of " + std::to_string(n) + " poses.";
+    RCLCPP_DEBUG(get_logger(), "Batch IK of %zu entries took %.2f ms.", n, elapsed);
+  }
+
+} // namespace robot_motion_cpp
+
+RCLCPP_COMPONENTS_REGISTER_NODE(robot_motion_cpp::BatchKinematicsNode)
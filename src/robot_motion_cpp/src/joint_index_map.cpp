@@ -0,0 +1,71 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_motion_cpp/joint_index_map.hpp"
+
+namespace robot_motion_cpp
+{
+  JointIndexMap::JointIndexMap(const std::vector<std::string> &joint_names)
+      : joint_names_(joint_names)
+  {
+  }
+
+  bool JointIndexMap::resolve(const std::vector<std::string> &names, std::string &missing)
+  {
+    valid_ = false;
+    for (std::size_t i = 0; i < joint_names_.size(); i++)
+    {
+      std::size_t k = 0;
+      while (k < names.size() && names[k] != joint_names_[i])
+      {
+        k++;
+      }
+      if (k == names.size())
+      {
+        missing = joint_names_[i];
+        return false;
+      }
+      indices_[i] = k;
+    }
+    names_ = names;
+    valid_ = true;
+    return true;
+  }
+
+  bool JointIndexMap::gather(const std::vector<std::string> &names, const std::vector<double> &positions,
+                             JointVector &q, std::string &missing)
+  {
+    if (!(valid_ && names == names_) && !resolve(names, missing))
+    {
+      return false;
+    }
+    for (std::size_t i = 0; i < joint_names_.size(); i++)
+    {
+      if (indices_[i] >= positions.size())
+      {
+        missing = joint_names_[i];
+        return false;
+      }
+      q[i] = positions[indices_[i]];
+    }
+    return true;
+  }
+
+} // namespace robot_motion_cpp
@@ -0,0 +1,382 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_motion_cpp/motion_node.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "rclcpp_components/register_node_macro.hpp"
+
+namespace robot_motion_cpp
+{
+  namespace
+  {
+    std::vector<std::string> default_joint_names()
+    {
+      std::vector<std::string> names;
+      for (std::size_t i = 0; i < robot_planning::NUM_JOINTS; i++)
+      {
+        names.push_back("joint_" + std::to_string(i + 1));
+      }
+      return names;
+    }
+
+    // np.gradient along the path with its default edge_order=1: second order central
+    // differences on the uneven time grid inside, one-sided differences at both ends
+    std::vector<JointVector> gradient(const std::vector<JointVector> &f, const std::vector<double> &t)
+    {
+      const std::size_t n = f.size();
+      std::vector<JointVector> df(n, JointVector::Zero());
+      if (n < 2)
+      {
+        return df;
+      }
+      for (std::size_t i = 1; i + 1 < n; i++)
+      {
+        const double hs = t[i] - t[i - 1];
+        const double hd = t[i + 1] - t[i];
+        df[i] = (hs * hs * f[i + 1] + (hd * hd - hs * hs) * f[i] - hd * hd * f[i - 1]) / (hs * hd * (hd + hs));
+      }
+      df[0] = (f[1] - f[0]) / (t[1] - t[0]);
+      df[n - 1] = (f[n - 1] - f[n - 2]) / (t[n - 1] - t[n - 2]);
+      return df;
+    }
+  } // namespace
+
+  MotionNode::MotionNode(const rclcpp::NodeOptions &options)
+      : Node("robot_motion_node", options),
+        joint_names_(default_joint_names()),
+        joint_states_map_(joint_names_),
+        joint_goal_map_(joint_names_)
+  {
+    robot_description_sub_ = create_subscription<std_msgs::msg::String>(
+        "/robot_description", rclcpp::QoS(1).transient_local(), [this](const std_msgs::msg::String &msg)
+        { robot_description_callback(msg); });
+    traj_pub_ = create_publisher<JointTrajectory>("/joint_trajectory_controller/joint_trajectory", 10);
+    joint_states_sub_ = create_subscription<sensor_msgs::msg::JointState>(
+        "/joint_states", 10, [this](const sensor_msgs::msg::JointState &msg)
+        { joint_states_callback(msg); });
+
+    cartesian_pose_service_ = create_service<GetCartesianSpacePose>(
+        "/robot_motion/cartesian_space/get_pose",
+        [this](const std::shared_ptr<GetCartesianSpacePose::Request> request, std::shared_ptr<GetCartesianSpacePose::Response> response)
+        { cartesian_space_pose_getter_callback(*request, *response); });
+    joint_pose_service_ = create_service<GetJointSpacePose>(
+        "/robot_motion/joint_space/get_pose",
+        [this](const std::shared_ptr<GetJointSpacePose::Request> request, std::shared_ptr<GetJointSpacePose::Response> response)
+        { joint_space_pose_getter_callback(*request, *response); });
+
+    cartesian_goal_sub_ = create_subscription<geometry_msgs::msg::PoseStamped>(
+        "/robot_motion/cartesian_space/set_goal_pose", 10, [this](const geometry_msgs::msg::PoseStamped &msg)
+        { cartesian_space_goal_pose_setter_callback(msg); });
+    joint_goal_sub_ = create_subscription<sensor_msgs::msg::JointState>(
+        "/robot_motion/joint_space/set_goal_pose", 10, [this](const sensor_msgs::msg::JointState &msg)
+        { joint_space_goal_pose_setter_callback(msg); });
+
+    declare_parameter("interpolation_type", std::string("cubic"));
+    declare_parameter("total_time", 5.0);
+    rcl_interfaces::msg::ParameterDescriptor num_waypoints_descriptor;
+    num_waypoints_descriptor.description = "Points of interpolated trajectories, including start and end.";
+    num_waypoints_descriptor.integer_range.resize(1);
+    num_waypoints_descriptor.integer_range[0].from_value = 2; // rejected when declared or set below that
+    num_waypoints_descriptor.integer_range[0].to_value = std::numeric_limits<std::int32_t>::max();
+    declare_parameter("num_waypoints", 50, num_waypoints_descriptor);
+    declare_parameter("planner", std::string("none")); // "none" (straight joint interpolation) or "rrt_connect"
+    declare_parameter("max_planning_time", 0.05);
+
+    plan_client_ = create_client<PlanJointPath>("/robot_planning/plan_joint_path");
+
+    RCLCPP_INFO(get_logger(), "Robot kinematics node ready (intra-process %s).",
+                options.use_intra_process_comms() ? "enabled" : "disabled");
+  }
+
+  bool MotionNode::to_joint_vector(JointIndexMap &map, const std::vector<std::string> &names,
+                                   const std::vector<double> &positions, JointVector &q) const
+  {
+    std::string missing;
+    if (!map.gather(names, positions, q, missing))
+    {
+      RCLCPP_WARN(get_logger(), "Missing joint %s in input.", missing.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  void MotionNode::robot_description_callback(const std_msgs::msg::String &msg)
+  {
+    try
+    {
+      limits_ = robot_planning::JointLimits::from_urdf(msg.data, joint_names_);
+      has_limits_ = true;
+    }
+    catch (const std::exception &e)
+    {
+      RCLCPP_ERROR(get_logger(), "Cannot read the joint limits: %s", e.what());
+    }
+  }
+
+  void MotionNode::joint_states_callback(const sensor_msgs::msg::JointState &msg)
+  {
+    JointVector q;
+    if (to_joint_vector(joint_states_map_, msg.name, msg.position, q))
+    {
+      current_joint_positions_ = q;
+      has_joint_state_ = true;
+    }
+  }
+
+  void MotionNode::cartesian_space_goal_pose_setter_callback(const geometry_msgs::msg::PoseStamped &msg)
+  {
+    if (!has_joint_state_)
+    {
+      RCLCPP_WARN(get_logger(), "No joint state received yet.");
+      return;
+    }
+
+    const auto &o = msg.pose.orientation;
+    Eigen::Quaterniond quat(o.w, o.x, o.y, o.z);
+    if (quat.norm() < 1e-9)
+    {
+      RCLCPP_WARN(get_logger(), "Received pose with zero-norm quaternion. Ignoring pose.");
+      return;
+    }
+    Eigen::Isometry3d end_T = Eigen::Isometry3d::Identity();
+    end_T.linear() = quat.normalized().toRotationMatrix();
+    end_T.translation() << msg.pose.position.x, msg.pose.position.y, msg.pose.position.z;
+
+    if (!has_limits_)
+    {
+      RCLCPP_WARN(get_logger(), "No robot description received yet, joint limits unknown.");
+      return;
+    }
+    robot_planning::IKSolutions solutions;
+    const std::size_t count = robot_planning::inverse_kinematics(end_T, limits_, solutions);
+    if (count == 0)
+    {
+      RCLCPP_WARN(get_logger(), "No IK solution for target pose.");
+      return;
+    }
+
+    // minimum movement solution
+    std::size_t best = 0;
+    double best_distance = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < count; i++)
+    {
+      const double distance = (solutions[i].q - current_joint_positions_).norm();
+      if (distance < best_distance)
+      {
+        best_distance = distance;
+        best = i;
+      }
+    }
+    send_joint_motion(current_joint_positions_, solutions[best].q);
+  }
+
+  void MotionNode::joint_space_goal_pose_setter_callback(const sensor_msgs::msg::JointState &msg)
+  {
+    if (!has_joint_state_)
+    {
+      RCLCPP_WARN(get_logger(), "No joint state received yet to plan from.");
+      return;
+    }
+
+    JointVector target;
+    if (!to_joint_vector(joint_goal_map_, msg.name, msg.position, target))
+    {
+      return;
+    }
+    if (!has_limits_)
+    {
+      RCLCPP_WARN(get_logger(), "No robot description received yet, joint limits unknown.");
+      return;
+    }
+    if (!limits_.contains(target))
+    {
+      RCLCPP_WARN(get_logger(), "Requested joint positions exceed joint limits. Ignoring command.");
+      return;
+    }
+    send_joint_motion(current_joint_positions_, target);
+  }
+
+  void MotionNode::cartesian_space_pose_getter_callback(const GetCartesianSpacePose::Request &,
+                                                        GetCartesianSpacePose::Response &response)
+  {
+    response.pose.header.stamp = now();
+    response.pose.header.frame_id = "base_link";
+    if (!has_joint_state_)
+    {
+      RCLCPP_WARN(get_logger(), "No joint states available to compute pose.");
+      return;
+    }
+
+    const Eigen::Isometry3d T = robot_planning::forward_kinematics(current_joint_positions_);
+    const Eigen::Quaterniond quat(T.linear());
+    response.pose.pose.position.x = T.translation().x();
+    response.pose.pose.position.y = T.translation().y();
+    response.pose.pose.position.z = T.translation().z();
+    response.pose.pose.orientation.x = quat.x();
+    response.pose.pose.orientation.y = quat.y();
+    response.pose.pose.orientation.z = quat.z();
+    response.pose.pose.orientation.w = quat.w();
+  }
+
+  void MotionNode::joint_space_pose_getter_callback(const GetJointSpacePose::Request &,
+                                                    GetJointSpacePose::Response &response)
+  {
+    if (!has_joint_state_)
+    {
+      RCLCPP_WARN(get_logger(), "No joint state available to respond.");
+      return;
+    }
+    response.joint_names = joint_names_;
+    response.joint_positions.assign(current_joint_positions_.data(),
+                                    current_joint_positions_.data() + robot_planning::NUM_JOINTS);
+  }
+
+  void MotionNode::send_joint_motion(const JointVector &start, const JointVector &target)
+  {
+    if (get_parameter("planner").as_string() == "none")
+    {
+      publish_trajectory(build_trajectory({start, target}));
+      return;
+    }
+
+    if (!plan_client_->service_is_ready())
+    {
+      RCLCPP_WARN(get_logger(), "Planning service not available. Falling back to joint interpolation.");
+      publish_trajectory(build_trajectory({start, target}));
+      return;
+    }
+
+    auto request = std::make_shared<PlanJointPath::Request>();
+    request->start.assign(start.data(), start.data() + robot_planning::NUM_JOINTS);
+    request->goal.assign(target.data(), target.data() + robot_planning::NUM_JOINTS);
+    request->max_planning_time = get_parameter("max_planning_time").as_double();
+    plan_client_->async_send_request(request, [this](rclcpp::Client<PlanJointPath>::SharedFuture future)
+                                     { plan_done_callback(future); });
+  }
+
+  void MotionNode::plan_done_callback(rclcpp::Client<PlanJointPath>::SharedFuture future)
+  {
+    const auto response = future.get();
+    if (!response->success)
+    {
+      RCLCPP_WARN(get_logger(), "Planning failed: %s", response->message.c_str());
+      return;
+    }
+
+    Path path;
+    std::vector<double> times;
+    for (const auto &point : response->path.points)
+    {
+      if (point.positions.size() != robot_planning::NUM_JOINTS)
+      {
+        RCLCPP_WARN(get_logger(), "Planned path has a point with %zu instead of %zu joints. Ignoring path.",
+                    point.positions.size(), robot_planning::NUM_JOINTS);
+        return;
+      }
+      JointVector q;
+      for (std::size_t i = 0; i < robot_planning::NUM_JOINTS; i++)
+      {
+        q[i] = point.positions[i];
+      }
+      path.push_back(q);
+      times.push_back(rclcpp::Duration(point.time_from_start).seconds());
+    }
+    if (path.empty())
+    {
+      RCLCPP_WARN(get_logger(), "Planned path is empty. Ignoring path.");
+      return;
+    }
+    RCLCPP_INFO(get_logger(), "Planned path with %zu waypoints in %.1f ms.", path.size(), response->planning_time * 1e3);
+
+    // optimised paths come time scaled to the joint limits
+    publish_trajectory(!times.empty() && times.back() > 0.0 ? build_timed_trajectory(path, times)
+                                                            : build_trajectory(path));
+  }
+
+  std::unique_ptr<MotionNode::JointTrajectory> MotionNode::build_trajectory(const Path &path) const
+  {
+    const double total_time = get_parameter("total_time").as_double();
+    const auto num_points = static_cast<std::size_t>(get_parameter("num_waypoints").as_int());
+    const Interpolation interpolation = interpolation_from_string(get_parameter("interpolation_type").as_string());
+
+    auto trajectory = std::make_unique<JointTrajectory>();
+    trajectory->header.stamp = now();
+    trajectory->joint_names = joint_names_;
+    trajectory->points.resize(num_points);
+
+    for (std::size_t i = 0; i < num_points; i++)
+    {
+      const double t_norm = static_cast<double>(i) / static_cast<double>(num_points - 1);
+      const TrajectorySample sample = interpolate_path(path, t_norm, total_time, interpolation);
+      auto &point = trajectory->points[i];
+      point.positions.assign(sample.position.data(), sample.position.data() + robot_planning::NUM_JOINTS);
+      point.velocities.assign(sample.velocity.data(), sample.velocity.data() + robot_planning::NUM_JOINTS);
+      point.accelerations.assign(sample.acceleration.data(), sample.acceleration.data() + robot_planning::NUM_JOINTS);
+      point.time_from_start = rclcpp::Duration::from_seconds(total_time * t_norm);
+    }
+
+    // zero final velocity & acceleration
+    trajectory->points.back().velocities.assign(robot_planning::NUM_JOINTS, 0.0);
+    trajectory->points.back().accelerations.assign(robot_planning::NUM_JOINTS, 0.0);
+    return trajectory;
+  }
+
+  std::unique_ptr<MotionNode::JointTrajectory> MotionNode::build_timed_trajectory(
+      const Path &path, const std::vector<double> &times) const
+  {
+    auto trajectory = std::make_unique<JointTrajectory>();
+    trajectory->header.stamp = now();
+    trajectory->joint_names = joint_names_;
+    trajectory->points.resize(path.size());
+
+    // same as the Python node: accelerations are taken from the velocities before
+    // the end points are set to rest
+    std::vector<JointVector> velocities = gradient(path, times);
+    std::vector<JointVector> accelerations = gradient(velocities, times);
+    velocities.front().setZero();
+    velocities.back().setZero();
+    accelerations.front().setZero();
+    accelerations.back().setZero();
+    for (std::size_t i = 0; i < path.size(); i++)
+    {
+      auto &point = trajectory->points[i];
+      point.positions.assign(path[i].data(), path[i].data() + robot_planning::NUM_JOINTS);
+      point.velocities.assign(velocities[i].data(), velocities[i].data() + robot_planning::NUM_JOINTS);
+      point.accelerations.assign(accelerations[i].data(), accelerations[i].data() + robot_planning::NUM_JOINTS);
+      point.time_from_start = rclcpp::Duration::from_seconds(times[i]);
+    }
+    return trajectory;
+  }
+
+  void MotionNode::publish_trajectory(std::unique_ptr<JointTrajectory> trajectory)
+  {
+    const std::size_t num_points = trajectory->points.size();
+    // moved into the middleware, intra-process subscribers receive this very message
+    traj_pub_->publish(std::move(trajectory));
+    RCLCPP_INFO(get_logger(), "Published trajectory with %zu points.", num_points);
+  }
+
+} // namespace robot_motion_cpp
+
+RCLCPP_COMPONENTS_REGISTER_NODE(robot_motion_cpp::MotionNode)
@@ -0,0 +1,73 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "controller_manager/controller_manager.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "robot_motion_cpp/motion_node.hpp"
+
+// ros2_control_node with the motion node in the same process. The controller manager
+// keeps its own update thread, both nodes share the executor and the motion node
+// publishes trajectories intra-process.
+int main(int argc, char **argv)
+{
+  rclcpp::init(argc, argv);
+
+  auto executor = std::make_shared<rclcpp::executors::MultiThreadedExecutor>();
+  auto cm = std::make_shared<controller_manager::ControllerManager>(executor, "controller_manager");
+  auto motion = std::make_shared<robot_motion_cpp::MotionNode>(
+      rclcpp::NodeOptions().use_intra_process_comms(true));
+
+  RCLCPP_INFO(cm->get_logger(), "update rate is %d Hz", cm->get_update_rate());
+
+  std::thread cm_thread(
+      [cm]()
+      {
+        const auto period = std::chrono::nanoseconds(1'000'000'000 / cm->get_update_rate());
+        std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> next_iteration_time{
+            std::chrono::nanoseconds(cm->now().nanoseconds())};
+        rclcpp::Time previous_time = cm->now();
+
+        while (rclcpp::ok())
+        {
+          const rclcpp::Time current_time = cm->now();
+          const rclcpp::Duration measured_period = current_time - previous_time;
+          previous_time = current_time;
+
+          cm->read(current_time, measured_period);
+          cm->update(current_time, measured_period);
+          cm->write(current_time, measured_period);
+
+          next_iteration_time += period;
+          std::this_thread::sleep_until(next_iteration_time);
+        }
+      });
+
+  executor->add_node(cm);
+  executor->add_node(motion);
+  executor->spin();
+  cm_thread.join();
+  rclcpp::shutdown();
+  return 0;
+}
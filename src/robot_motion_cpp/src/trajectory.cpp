@@ -0,0 +1,112 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_motion_cpp/trajectory.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace robot_motion_cpp
+{
+  Interpolation interpolation_from_string(const std::string &name)
+  {
+    if (name == "cubic")
+    {
+      return Interpolation::CUBIC;
+    }
+    if (name == "quintic")
+    {
+      return Interpolation::QUINTIC;
+    }
+    return Interpolation::LINEAR;
+  }
+
+  TrajectorySample interpolate_segment(const JointVector &q0, const JointVector &qf, double t, double T,
+                                       Interpolation mode)
+  {
+    const JointVector dq = qf - q0;
+    const double ts = t * T;
+    TrajectorySample sample;
+
+    switch (mode)
+    {
+    case Interpolation::CUBIC:
+    {
+      const JointVector a2 = 3.0 * dq / (T * T);
+      const JointVector a3 = -2.0 * dq / (T * T * T);
+      sample.position = q0 + a2 * ts * ts + a3 * ts * ts * ts;
+      sample.velocity = 2.0 * a2 * ts + 3.0 * a3 * ts * ts;
+      sample.acceleration = 2.0 * a2 + 6.0 * a3 * ts;
+      break;
+    }
+    case Interpolation::QUINTIC:
+    {
+      const double T3 = T * T * T;
+      const JointVector a3 = 10.0 * dq / T3;
+      const JointVector a4 = -15.0 * dq / (T3 * T);
+      const JointVector a5 = 6.0 * dq / (T3 * T * T);
+      const double t2 = ts * ts, t3 = t2 * ts, t4 = t3 * ts, t5 = t4 * ts;
+      sample.position = q0 + a3 * t3 + a4 * t4 + a5 * t5;
+      sample.velocity = 3.0 * a3 * t2 + 4.0 * a4 * t3 + 5.0 * a5 * t4;
+      sample.acceleration = 6.0 * a3 * ts + 12.0 * a4 * t2 + 20.0 * a5 * t3;
+      break;
+    }
+    case Interpolation::LINEAR:
+    default:
+      sample.position = q0 + dq * t;
+      sample.velocity = dq / T;
+      sample.acceleration.setZero();
+      break;
+    }
+    return sample;
+  }
+
+  TrajectorySample interpolate_path(const Path &path, double t, double T, Interpolation mode)
+  {
+    if (path.size() == 2)
+    {
+      return interpolate_segment(path[0], path[1], t, T, mode);
+    }
+
+    std::vector<double> cumulative(path.size(), 0.0);
+    for (std::size_t i = 1; i < path.size(); i++)
+    {
+      cumulative[i] = cumulative[i - 1] + (path[i] - path[i - 1]).norm();
+    }
+    const double total_length = cumulative.back();
+    if (total_length < 1e-9)
+    {
+      return {path.back(), JointVector::Zero(), JointVector::Zero()};
+    }
+
+    JointVector s0 = JointVector::Zero(), sf = JointVector::Zero();
+    sf[0] = total_length;
+    const TrajectorySample arc = interpolate_segment(s0, sf, t, T, mode);
+    const double s = arc.position[0];
+
+    const std::size_t k = std::min<std::size_t>(
+        std::upper_bound(cumulative.begin(), cumulative.end(), s) - cumulative.begin(), path.size() - 1) - 1;
+    const double segment_length = std::max(cumulative[k + 1] - cumulative[k], 1e-12);
+    const JointVector direction = (path[k + 1] - path[k]) / segment_length;
+
+    return {path[k] + direction * (s - cumulative[k]), direction * arc.velocity[0], direction * arc.acceleration[0]};
+  }
+
+} // namespace robot_motion_cpp
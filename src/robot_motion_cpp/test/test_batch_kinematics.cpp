@@ -0,0 +1,177 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "robot_motion_cpp/batch_kinematics.hpp"
+
+namespace
+{
+  using robot_motion_cpp::BatchIKResult;
+  using robot_motion_cpp::IKStatus;
+  using robot_motion_cpp::POSE_SIZE;
+  using robot_planning::JointLimits;
+  using robot_planning::JointVector;
+  using robot_planning::NUM_JOINTS;
+
+  constexpr std::size_t NUM_ENTRIES = 1000;
+  constexpr std::size_t NUM_THREADS = 7; // chunks of uneven size
+
+  // the ranges of robot_description/urdf/robot.urdf
+  JointLimits urdf_limits()
+  {
+    JointLimits limits;
+    limits.lower.setConstant(-M_PI);
+    limits.upper.setConstant(M_PI);
+    limits.lower[4] = -M_PI / 2;
+    limits.upper[4] = M_PI / 2;
+    return limits;
+  }
+
+  // random positions away from the wrist singularity, where q4 and q6 are not unique
+  std::vector<double> random_positions(const JointLimits &limits, std::size_t n)
+  {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double> positions;
+    while (positions.size() < n * NUM_JOINTS)
+    {
+      JointVector q;
+      for (std::size_t i = 0; i < NUM_JOINTS; i++)
+      {
+        q[i] = limits.lower[i] + unit(rng) * (limits.upper[i] - limits.lower[i]);
+      }
+      if (std::abs(std::sin(q[4])) > 1e-3)
+      {
+        positions.insert(positions.end(), q.data(), q.data() + NUM_JOINTS);
+      }
+    }
+    return positions;
+  }
+
+  JointVector entry(const std::vector<double> &values, std::size_t i)
+  {
+    return Eigen::Map<const JointVector>(&values[i * NUM_JOINTS]);
+  }
+
+  double joint_distance(const JointVector &a, const JointVector &b)
+  {
+    double distance = 0.0;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      distance = std::max(distance, std::abs(robot_planning::normalize_angle(a[i] - b[i])));
+    }
+    return distance;
+  }
+
+  void expect_pose(const std::vector<double> &poses, std::size_t i, const JointVector &q)
+  {
+    std::vector<double> pose;
+    robot_motion_cpp::batch_forward_kinematics(std::vector<double>(q.data(), q.data() + NUM_JOINTS), pose, 1);
+    for (std::size_t k = 0; k < POSE_SIZE; k++)
+    {
+      // the quaternion sign is not unique
+      const double expected = k >= 3 && pose[6] * poses[i * POSE_SIZE + 6] < 0.0 ? -poses[i * POSE_SIZE + k]
+                                                                                   : poses[i * POSE_SIZE + k];
+      EXPECT_NEAR(pose[k], expected, k < 3 ? 1e-5 : 1e-6) << "entry " << i;
+    }
+  }
+} // namespace
+
+TEST(BatchKinematics, RoundTripsAcrossThreadsInEntryOrder)
+{
+  const JointLimits limits = urdf_limits();
+  const std::vector<double> positions = random_positions(limits, NUM_ENTRIES);
+
+  std::vector<double> poses, serial_poses;
+  robot_motion_cpp::batch_forward_kinematics(positions, poses, NUM_THREADS);
+  robot_motion_cpp::batch_forward_kinematics(positions, serial_poses, 1);
+  ASSERT_EQ(poses.size(), NUM_ENTRIES * POSE_SIZE);
+  EXPECT_EQ(poses, serial_poses);
+
+  BatchIKResult result, serial;
+  robot_motion_cpp::batch_inverse_kinematics(poses, {}, limits, NUM_THREADS, result);
+  robot_motion_cpp::batch_inverse_kinematics(poses, {}, limits, 1, serial);
+  EXPECT_EQ(result.status, serial.status);
+  EXPECT_EQ(result.solution_offsets, serial.solution_offsets);
+  EXPECT_EQ(result.joint_positions, serial.joint_positions);
+  EXPECT_EQ(result.branches, serial.branches);
+
+  ASSERT_EQ(result.solution_offsets.size(), NUM_ENTRIES + 1);
+  EXPECT_EQ(result.solution_offsets.front(), 0u);
+  EXPECT_EQ(result.solution_offsets.back() * NUM_JOINTS, result.joint_positions.size());
+  EXPECT_EQ(result.solution_offsets.back(), result.branches.size());
+  for (std::size_t i = 0; i < NUM_ENTRIES; i++)
+  {
+    ASSERT_EQ(result.status[i], static_cast<std::uint8_t>(IKStatus::SOLVED));
+    // every solution in the range of entry i reaches pose i, one of them is the input
+    bool found = false;
+    for (std::size_t k = result.solution_offsets[i]; k < result.solution_offsets[i + 1]; k++)
+    {
+      const JointVector q = entry(result.joint_positions, k);
+      expect_pose(poses, i, q);
+      found = found || joint_distance(q, entry(positions, i)) < 1e-6;
+    }
+    EXPECT_TRUE(found) << "entry " << i;
+  }
+}
+
+TEST(BatchKinematics, SeedsSelectTheClosestSolution)
+{
+  const JointLimits limits = urdf_limits();
+  const std::vector<double> positions = random_positions(limits, NUM_ENTRIES);
+  std::vector<double> poses;
+  robot_motion_cpp::batch_forward_kinematics(positions, poses, NUM_THREADS);
+
+  BatchIKResult result;
+  robot_motion_cpp::batch_inverse_kinematics(poses, positions, limits, NUM_THREADS, result);
+  ASSERT_EQ(result.solution_offsets.size(), NUM_ENTRIES + 1);
+  ASSERT_EQ(result.joint_positions.size(), NUM_ENTRIES * NUM_JOINTS);
+  for (std::size_t i = 0; i < NUM_ENTRIES; i++)
+  {
+    EXPECT_EQ(result.status[i], static_cast<std::uint8_t>(IKStatus::SOLVED));
+    EXPECT_EQ(result.solution_offsets[i], i);
+    EXPECT_LT(joint_distance(entry(result.joint_positions, i), entry(positions, i)), 1e-6) << "entry " << i;
+  }
+}
+
+TEST(BatchKinematics, FlagsInvalidAndUnreachablePoses)
+{
+  const JointLimits limits = urdf_limits();
+  const std::vector<double> positions = random_positions(limits, 3);
+  std::vector<double> poses;
+  robot_motion_cpp::batch_forward_kinematics(positions, poses, 1);
+  poses[POSE_SIZE + 3] = poses[POSE_SIZE + 4] = poses[POSE_SIZE + 5] = poses[POSE_SIZE + 6] = 0.0;
+  poses[2 * POSE_SIZE] = 1e4; // mm, out of reach
+
+  BatchIKResult result;
+  robot_motion_cpp::batch_inverse_kinematics(poses, {}, limits, 3, result);
+  ASSERT_EQ(result.status.size(), 3u);
+  EXPECT_EQ(result.status[0], static_cast<std::uint8_t>(IKStatus::SOLVED));
+  EXPECT_EQ(result.status[1], static_cast<std::uint8_t>(IKStatus::INVALID_POSE));
+  EXPECT_EQ(result.status[2], static_cast<std::uint8_t>(IKStatus::UNREACHABLE));
+  EXPECT_GT(result.solution_offsets[1], 0u);
+  EXPECT_EQ(result.solution_offsets[2], result.solution_offsets[1]);
+  EXPECT_EQ(result.solution_offsets[3], result.solution_offsets[2]);
+}
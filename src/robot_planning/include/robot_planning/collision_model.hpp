@@ -0,0 +1,104 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__COLLISION_MODEL_HPP_
+#define ROBOT_PLANNING__COLLISION_MODEL_HPP_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "robot_planning/kinematics.hpp"
+#include "robot_planning/state_space.hpp"
+
+namespace robot_planning
+{
+  // Axis aligned box in the base frame (mm)
+  struct Box
+  {
+    Eigen::Vector3d min;
+    Eigen::Vector3d max;
+  };
+
+  struct Capsule
+  {
+    Eigen::Vector3d a;
+    Eigen::Vector3d b;
+    double radius;
+  };
+
+  // Robot approximated by capsules along the DH chain:
+  //   0 base column, 1 upper arm, 2 forearm, 3 wrist, 4 tool
+  constexpr std::size_t NUM_CAPSULES = 5;
+  using RobotCapsules = std::array<Capsule, NUM_CAPSULES>;
+
+  class CollisionModel
+  {
+  public:
+    struct Params
+    {
+      std::array<double, NUM_CAPSULES> radii{{45.0, 40.0, 35.0, 30.0, 25.0}};
+      double tool_length = 50.0;
+      double safety_margin = 5.0;
+      double ground_height = 0.0;
+      bool check_ground = true;
+      // max joint step (rad) between states checked along an edge
+      double edge_resolution = 0.02;
+    };
+
+    CollisionModel();
+    explicit CollisionModel(const Params &params);
+
+    const Params &params() const { return params_; }
+
+    void set_obstacles(std::vector<Box> obstacles);
+    const std::vector<Box> &obstacles() const { return obstacles_; }
+
+    // hash of the obstacles and the robot parameters, the same for the same
+    // environment in every process, so cached plans can be keyed on it across restarts
+    std::uint64_t environment_hash() const { return environment_hash_; }
+
+    void capsules(const LinkFrames &frames, RobotCapsules &out) const;
+
+    bool is_valid(const JointVector &q) const;
+
+    // smallest distance (mm) between the robot and the environment or itself,
+    // negative when penetrating
+    double clearance(const JointVector &q) const;
+
+    bool is_motion_valid(const StateSpace &space, const JointVector &a, const JointVector &b) const;
+
+  private:
+    double capsule_clearance(const RobotCapsules &caps, double stop_below) const;
+    void update_environment_hash();
+
+    Params params_;
+    std::vector<Box> obstacles_;
+    std::uint64_t environment_hash_ = 0;
+  };
+
+  double point_box_distance(const Eigen::Vector3d &p, const Box &box);
+
+  double segment_segment_distance(const Eigen::Vector3d &p1, const Eigen::Vector3d &q1,
+                                  const Eigen::Vector3d &p2, const Eigen::Vector3d &q2);
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__COLLISION_MODEL_HPP_
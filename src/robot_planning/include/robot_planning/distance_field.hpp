@@ -0,0 +1,71 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__DISTANCE_FIELD_HPP_
+#define ROBOT_PLANNING__DISTANCE_FIELD_HPP_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "robot_planning/collision_model.hpp"
+#include "robot_planning/parallel.hpp"
+
+namespace robot_planning
+{
+  // Signed distance (mm) to the obstacle boxes and the ground plane, sampled on a
+  // regular grid over the workspace and trilinearly interpolated between voxels.
+  class DistanceField
+  {
+  public:
+    struct Params
+    {
+      double resolution = 20.0;
+      Eigen::Vector3d min{-700.0, -700.0, -200.0};
+      Eigen::Vector3d max{700.0, 700.0, 900.0};
+      // distances are capped here, the optimizer only looks at the near field
+      double max_distance = 500.0;
+      std::size_t num_threads = default_thread_count();
+    };
+
+    DistanceField();
+    explicit DistanceField(const Params &params);
+
+    void build(const std::vector<Box> &obstacles, bool ground, double ground_height);
+
+    // distance at p and its gradient, points outside the grid are clamped to it
+    double distance(const Eigen::Vector3d &p, Eigen::Vector3d &gradient) const;
+
+  private:
+    std::size_t index(std::size_t x, std::size_t y, std::size_t z) const
+    {
+      return (z * size_[1] + y) * size_[0] + x;
+    }
+
+    Params params_;
+    std::array<std::size_t, 3> size_{};
+    std::vector<float> values_;
+  };
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__DISTANCE_FIELD_HPP_
@@ -0,0 +1,96 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__KINEMATICS_HPP_
+#define ROBOT_PLANNING__KINEMATICS_HPP_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+namespace robot_planning
+{
+  constexpr std::size_t NUM_JOINTS = 6;
+
+  using JointVector = Eigen::Matrix<double, NUM_JOINTS, 1>;
+  using Jacobian = Eigen::Matrix<double, 6, NUM_JOINTS>;
+  using PositionJacobian = Eigen::Matrix<double, 3, NUM_JOINTS>;
+
+  // DH parameters in mm, mirrors robot_motion/config.py and symbolic_kinematics.py
+  namespace dh
+  {
+    constexpr double L2 = 200.0;
+    constexpr double D1 = 182.0;
+    constexpr double D2 = 13.5;
+    constexpr double D4 = 188.5;
+    constexpr double D6 = 58.13;
+  } // namespace dh
+
+  struct JointLimits
+  {
+    JointVector lower;
+    JointVector upper;
+    // joints whose range covers the full circle and may be traversed across +-pi
+    std::array<bool, NUM_JOINTS> wraps{};
+
+    // From the <limit> tags of the named joints; continuous joints wrap. Throws
+    // std::runtime_error if a joint is missing or has no limits.
+    static JointLimits from_urdf(const std::string &urdf_xml, const std::vector<std::string> &joint_names);
+
+    bool contains(const JointVector &q) const;
+  };
+
+  // Frames T_00 .. T_06, T_00 being the base frame
+  using LinkFrames = std::array<Eigen::Isometry3d, NUM_JOINTS + 1>;
+
+  void link_frames(const JointVector &q, LinkFrames &frames);
+
+  Eigen::Isometry3d forward_kinematics(const JointVector &q);
+
+  // Geometric Jacobian of the flange (linear part in mm/rad)
+  Jacobian jacobian(const LinkFrames &frames);
+
+  struct IKSolution
+  {
+    JointVector q;
+    // 2 * arm configuration (shoulder and elbow, 0..3) + wrist flip
+    std::uint8_t branch;
+  };
+
+  constexpr std::size_t MAX_IK_SOLUTIONS = 8;
+  using IKSolutions = std::array<IKSolution, MAX_IK_SOLUTIONS>;
+
+  // Analytic IK of the flange pose, mirrors robot_motion/robot_motion.py. Solutions
+  // outside the limits are dropped, returns the number written to `solutions`.
+  std::size_t inverse_kinematics(const Eigen::Isometry3d &T_06, const JointLimits &limits, IKSolutions &solutions);
+
+  // Linear Jacobian (mm/rad) of a point rigidly attached to link `link` (1..6),
+  // joints past that link do not move it
+  PositionJacobian point_jacobian(const LinkFrames &frames, std::size_t link, const Eigen::Vector3d &p);
+
+  double normalize_angle(double angle);
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__KINEMATICS_HPP_
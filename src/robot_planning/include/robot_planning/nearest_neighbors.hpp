@@ -0,0 +1,271 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__NEAREST_NEIGHBORS_HPP_
+#define ROBOT_PLANNING__NEAREST_NEIGHBORS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "robot_planning/kinematics.hpp"
+
+namespace robot_planning
+{
+  // Incrementally built k-d tree over joint vectors. Nodes live in one contiguous
+  // array in insertion order, the tree only stores child indices, so a query walks
+  // a flat buffer instead of chasing heap pointers. Distances are Euclidean with
+  // wrap-around on the axes flagged in `wraps`. Points can be deactivated (lazy
+  // planners drop invalidated subtrees) but never removed.
+  //
+  // Queries may run concurrently with each other, but not with insert or deactivate.
+  class KdTree
+  {
+  public:
+    explicit KdTree(const std::array<bool, NUM_JOINTS> &wraps = {})
+        : wraps_(wraps)
+    {
+    }
+
+    void reserve(std::size_t n) { nodes_.reserve(n); }
+
+    void clear()
+    {
+      nodes_.clear();
+      active_count_ = 0;
+    }
+
+    std::size_t size() const { return nodes_.size(); }
+    std::size_t active_size() const { return active_count_; }
+
+    const JointVector &point(std::size_t index) const { return nodes_[index].point; }
+    bool active(std::size_t index) const { return nodes_[index].active; }
+
+    std::size_t insert(const JointVector &q)
+    {
+      const auto index = static_cast<std::int32_t>(nodes_.size());
+      nodes_.push_back({q, -1, -1, 0, true});
+      active_count_++;
+      if (index == 0)
+      {
+        return 0;
+      }
+
+      std::int32_t current = 0;
+      while (true)
+      {
+        Node &node = nodes_[current];
+        std::int32_t &child = q[node.axis] < node.point[node.axis] ? node.left : node.right;
+        if (child < 0)
+        {
+          child = index;
+          nodes_[index].axis = static_cast<std::uint8_t>((node.axis + 1) % NUM_JOINTS);
+          return static_cast<std::size_t>(index);
+        }
+        current = child;
+      }
+    }
+
+    void deactivate(std::size_t index)
+    {
+      if (nodes_[index].active)
+      {
+        nodes_[index].active = false;
+        active_count_--;
+      }
+    }
+
+    double distance(const JointVector &a, const JointVector &b) const
+    {
+      return std::sqrt(squared_distance(a, b));
+    }
+
+    // index of the nearest active point, -1 if there is none
+    std::int64_t nearest(const JointVector &q) const
+    {
+      std::int64_t best_index = -1;
+      double best = std::numeric_limits<double>::infinity();
+      search(q, [&](std::size_t index, double d2)
+             {
+               if (d2 < best)
+               {
+                 best = d2;
+                 best_index = static_cast<std::int64_t>(index);
+               }
+               return best; });
+      return best_index;
+    }
+
+    // k nearest active points, sorted by distance
+    void nearest_k(const JointVector &q, std::size_t k, std::vector<std::pair<double, std::size_t>> &out) const
+    {
+      out.clear();
+      if (k == 0)
+      {
+        return;
+      }
+      search(q, [&](std::size_t index, double d2)
+             {
+               if (out.size() < k)
+               {
+                 out.emplace_back(d2, index);
+                 std::push_heap(out.begin(), out.end());
+               }
+               else if (d2 < out.front().first)
+               {
+                 std::pop_heap(out.begin(), out.end());
+                 out.back() = {d2, index};
+                 std::push_heap(out.begin(), out.end());
+               }
+               return out.size() < k ? std::numeric_limits<double>::infinity() : out.front().first; });
+      std::sort_heap(out.begin(), out.end());
+      for (auto &entry : out)
+      {
+        entry.first = std::sqrt(entry.first);
+      }
+    }
+
+    // all active points within radius, unsorted
+    void nearest_r(const JointVector &q, double radius, std::vector<std::pair<double, std::size_t>> &out) const
+    {
+      out.clear();
+      const double r2 = radius * radius;
+      search(q, [&](std::size_t index, double d2)
+             {
+               if (d2 <= r2)
+               {
+                 out.emplace_back(std::sqrt(d2), index);
+               }
+               return r2; });
+    }
+
+  private:
+    struct Node
+    {
+      JointVector point;
+      std::int32_t left;
+      std::int32_t right;
+      std::uint8_t axis;
+      bool active;
+    };
+
+    double axis_distance(std::size_t axis, double a, double b) const
+    {
+      double d = std::abs(a - b);
+      if (wraps_[axis] && d > M_PI)
+      {
+        d = 2.0 * M_PI - d;
+      }
+      return d;
+    }
+
+    double squared_distance(const JointVector &a, const JointVector &b) const
+    {
+      double sum = 0.0;
+      for (std::size_t i = 0; i < NUM_JOINTS; i++)
+      {
+        const double d = axis_distance(i, a[i], b[i]);
+        sum += d * d;
+      }
+      return sum;
+    }
+
+    // lower bound on the distance from q to any point on the far side of the split
+    double far_side_bound(std::size_t axis, double q, double split) const
+    {
+      const double direct = std::abs(q - split);
+      if (!wraps_[axis])
+      {
+        return direct;
+      }
+      return q < split ? std::min(direct, M_PI + q) : std::min(direct, M_PI - q);
+    }
+
+    // Lower bound of the distance from q to a subtree cell, tracked per axis so
+    // the bound tightens with every split on the way down (Arya & Mount).
+    struct CellBound
+    {
+      std::int32_t index;
+      double d2;
+      std::array<double, NUM_JOINTS> offsets;
+    };
+
+    // visit(index, squared distance) returns the current squared pruning radius
+    template <typename Visitor>
+    void search(const JointVector &q, Visitor &&visit) const
+    {
+      if (nodes_.empty())
+      {
+        return;
+      }
+
+      // per thread scratch stack, reused across queries to stay allocation free
+      thread_local std::vector<CellBound> stack;
+      double bound = std::numeric_limits<double>::infinity();
+      stack.clear();
+      stack.push_back({0, 0.0, {}});
+      while (!stack.empty())
+      {
+        const CellBound cell = stack.back();
+        stack.pop_back();
+        if (cell.d2 > bound)
+        {
+          continue;
+        }
+
+        const Node &node = nodes_[cell.index];
+        if (node.active)
+        {
+          bound = visit(static_cast<std::size_t>(cell.index), squared_distance(q, node.point));
+        }
+
+        const double split = node.point[node.axis];
+        const bool left_first = q[node.axis] < split;
+        const std::int32_t near = left_first ? node.left : node.right;
+        const std::int32_t far = left_first ? node.right : node.left;
+        if (far >= 0)
+        {
+          const double offset = std::max(cell.offsets[node.axis], far_side_bound(node.axis, q[node.axis], split));
+          const double d2 = cell.d2 - cell.offsets[node.axis] * cell.offsets[node.axis] + offset * offset;
+          if (d2 <= bound)
+          {
+            stack.push_back({far, d2, cell.offsets});
+            stack.back().offsets[node.axis] = offset;
+          }
+        }
+        if (near >= 0)
+        {
+          stack.push_back({near, cell.d2, cell.offsets});
+        }
+      }
+    }
+
+    std::array<bool, NUM_JOINTS> wraps_;
+    std::vector<Node> nodes_;
+    std::size_t active_count_ = 0;
+  };
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__NEAREST_NEIGHBORS_HPP_
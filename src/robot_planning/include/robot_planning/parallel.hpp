@@ -0,0 +1,74 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__PARALLEL_HPP_
+#define ROBOT_PLANNING__PARALLEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace robot_planning
+{
+  inline std::size_t default_thread_count()
+  {
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+
+  // Runs fn(begin, end, worker) on contiguous chunks of [0, n), one chunk per worker.
+  // The calling thread processes the first chunk itself.
+  template <typename Fn>
+  void parallel_for(std::size_t n, std::size_t num_threads, Fn &&fn)
+  {
+    num_threads = std::max<std::size_t>(1, std::min(num_threads, n));
+    if (num_threads == 1)
+    {
+      if (n > 0)
+      {
+        fn(std::size_t{0}, n, std::size_t{0});
+      }
+      return;
+    }
+
+    const std::size_t chunk = (n + num_threads - 1) / num_threads;
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads - 1);
+    for (std::size_t w = 1; w < num_threads; w++)
+    {
+      const std::size_t begin = w * chunk;
+      const std::size_t end = std::min(n, begin + chunk);
+      if (begin >= end)
+      {
+        break;
+      }
+      workers.emplace_back([&fn, begin, end, w]()
+                           { fn(begin, end, w); });
+    }
+    fn(std::size_t{0}, std::min(n, chunk), std::size_t{0});
+    for (auto &worker : workers)
+    {
+      worker.join();
+    }
+  }
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__PARALLEL_HPP_
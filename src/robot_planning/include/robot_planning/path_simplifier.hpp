@@ -0,0 +1,63 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__PATH_SIMPLIFIER_HPP_
+#define ROBOT_PLANNING__PATH_SIMPLIFIER_HPP_
+
+#include <cstdint>
+
+#include "robot_planning/collision_model.hpp"
+#include "robot_planning/parallel.hpp"
+#include "robot_planning/planner.hpp"
+#include "robot_planning/state_space.hpp"
+
+namespace robot_planning
+{
+  // Post-processing for sampled paths. Every worker thread runs its own randomized
+  // shortcutting on a copy of the path and the shortest result wins. The winner is
+  // then smoothed by corner cutting, with all corners of a pass checked in parallel.
+  class PathSimplifier
+  {
+  public:
+    struct Params
+    {
+      std::size_t num_threads = default_thread_count();
+      std::size_t shortcut_attempts = 100;
+      std::size_t smoothing_passes = 3;
+      double corner_fraction = 0.25;
+      std::uint64_t seed = 0;
+    };
+
+    PathSimplifier(const StateSpace &space, const CollisionModel &collision, const Params &params);
+
+    Path simplify(const Path &path, double timeout) const;
+
+  private:
+    Path shortcut(const Path &path, std::uint64_t seed, Clock::time_point deadline) const;
+    Path smooth(const Path &path) const;
+
+    const StateSpace &space_;
+    const CollisionModel &collision_;
+    Params params_;
+  };
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__PATH_SIMPLIFIER_HPP_
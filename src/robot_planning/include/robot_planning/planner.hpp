@@ -0,0 +1,54 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__PLANNER_HPP_
+#define ROBOT_PLANNING__PLANNER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "robot_planning/kinematics.hpp"
+#include "robot_planning/state_space.hpp"
+
+namespace robot_planning
+{
+  using Path = std::vector<JointVector>;
+
+  struct PlanResult
+  {
+    bool success = false;
+    std::string message;
+    Path path;
+    // seconds per waypoint, only filled by planners that time-parameterise the path
+    std::vector<double> time_from_start;
+    double planning_time = 0.0;
+    std::size_t iterations = 0;
+    std::size_t edge_checks = 0;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  double path_length(const StateSpace &space, const Path &path);
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__PLANNER_HPP_
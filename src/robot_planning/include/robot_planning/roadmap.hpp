@@ -0,0 +1,163 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__ROADMAP_HPP_
+#define ROBOT_PLANNING__ROADMAP_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "robot_planning/collision_model.hpp"
+#include "robot_planning/nearest_neighbors.hpp"
+#include "robot_planning/parallel.hpp"
+#include "robot_planning/planner.hpp"
+#include "robot_planning/state_space.hpp"
+
+namespace robot_planning
+{
+  // Workspace bounds of whatever the robot sweeps through at a node or along an
+  // edge. Stored as float so the on-disk tables stay compact.
+  struct Bounds
+  {
+    float min[3];
+    float max[3];
+
+    bool overlaps(const Box &box) const;
+  };
+
+  // In-memory roadmap as produced by the builder
+  struct RoadmapData
+  {
+    std::vector<JointVector> nodes;
+    std::vector<Bounds> node_bounds;
+    // CSR adjacency, both directions of every undirected edge are listed
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::uint32_t> targets;
+    std::vector<float> weights;
+    std::vector<std::uint32_t> edge_ids;
+    std::vector<Bounds> edge_bounds;
+    // environment the roadmap was validated against
+    std::vector<Box> obstacles;
+  };
+
+  struct RoadmapBuildParams
+  {
+    std::size_t num_nodes = 20000;
+    std::size_t k_neighbors = 10;
+    std::size_t num_threads = default_thread_count();
+    std::uint64_t seed = 0;
+  };
+
+  // Samples collision free states and connects each to its k nearest neighbours,
+  // sampling and edge validation are spread across num_threads workers.
+  RoadmapData build_roadmap(const StateSpace &space, const CollisionModel &collision, const RoadmapBuildParams &params);
+
+  bool save_roadmap(const std::string &path, const RoadmapData &data, const CollisionModel::Params &collision_params,
+                    std::string &error);
+
+  // Read-only memory mapped roadmap. Only the per edge and per node validity
+  // state lives on the heap, it is updated incrementally when obstacles change
+  // and resolved lazily while answering queries.
+  class Roadmap
+  {
+  public:
+    struct QueryParams
+    {
+      std::size_t k_connect = 10;
+      std::size_t max_lazy_iterations = 50;
+    };
+
+    // Fails if the file was built for different robot collision parameters.
+    static std::unique_ptr<Roadmap> open(const std::string &path, const StateSpace &space,
+                                         const CollisionModel::Params &collision_params, std::string &error);
+
+    ~Roadmap();
+    Roadmap(const Roadmap &) = delete;
+    Roadmap &operator=(const Roadmap &) = delete;
+
+    std::size_t num_nodes() const { return num_nodes_; }
+    std::size_t num_edges() const { return num_edges_; }
+
+    // Marks everything whose swept bounds touch an added or removed box for
+    // re-validation. Returns the number of edges affected.
+    std::size_t update_obstacles(const std::vector<Box> &obstacles);
+
+    // Not thread safe, queries share the search buffers.
+    PlanResult query(const CollisionModel &collision, const JointVector &start, const JointVector &goal,
+                     const QueryParams &params);
+
+  private:
+    enum State : std::uint8_t
+    {
+      UNKNOWN,
+      VALID,
+      INVALID
+    };
+
+    explicit Roadmap(const StateSpace &space) : space_(space), nn_(space.limits().wraps) {}
+
+    JointVector node(std::size_t index) const;
+
+    bool node_valid(const CollisionModel &collision, std::size_t index);
+    bool connect(const CollisionModel &collision, const JointVector &q, std::size_t k,
+                 std::vector<std::pair<double, std::size_t>> &out);
+    static void drop_link(std::vector<std::pair<double, std::size_t>> &links, std::size_t index);
+    bool astar(std::size_t &last_node);
+
+    const StateSpace &space_;
+    void *mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+
+    std::size_t num_nodes_ = 0;
+    std::size_t num_edges_ = 0;
+    const double *nodes_ = nullptr;
+    const Bounds *node_bounds_ = nullptr;
+    const std::uint64_t *offsets_ = nullptr;
+    const std::uint32_t *targets_ = nullptr;
+    const float *weights_ = nullptr;
+    const std::uint32_t *edge_ids_ = nullptr;
+    const Bounds *edge_bounds_ = nullptr;
+
+    std::vector<Box> obstacles_;
+    std::vector<std::uint8_t> node_state_;
+    std::vector<std::uint8_t> edge_state_;
+    KdTree nn_;
+
+    // search buffers, sized once on open
+    JointVector goal_;
+    std::vector<std::pair<double, std::size_t>> candidates_;
+    std::vector<std::pair<double, std::size_t>> start_links_;
+    std::vector<std::pair<double, std::size_t>> goal_links_;
+    std::vector<double> goal_cost_;
+    std::vector<double> cost_;
+    std::vector<double> heuristic_;
+    std::vector<std::int64_t> parent_;
+    std::vector<std::uint32_t> parent_edge_;
+    std::vector<std::uint32_t> visited_;
+    std::vector<std::uint32_t> closed_;
+    std::uint32_t generation_ = 0;
+    std::vector<std::pair<double, std::uint32_t>> open_;
+  };
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__ROADMAP_HPP_
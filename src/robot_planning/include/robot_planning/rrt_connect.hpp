@@ -0,0 +1,99 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__RRT_CONNECT_HPP_
+#define ROBOT_PLANNING__RRT_CONNECT_HPP_
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "robot_planning/collision_model.hpp"
+#include "robot_planning/nearest_neighbors.hpp"
+#include "robot_planning/planner.hpp"
+#include "robot_planning/state_space.hpp"
+
+namespace robot_planning
+{
+  // Bidirectional RRT-Connect with lazy edge validation. New vertices are state
+  // checked when they are added, but edges are only checked once they are part
+  // of a candidate start-goal connection. Invalid edges cut their subtree off.
+  class RRTConnect
+  {
+  public:
+    struct Params
+    {
+      double max_step = 0.3;
+      std::size_t max_iterations = 50000;
+      std::uint64_t seed = 0;
+    };
+
+    RRTConnect(const StateSpace &space, const CollisionModel &collision, const Params &params);
+
+    PlanResult plan(const JointVector &start, const JointVector &goal, double timeout);
+
+  private:
+    struct Vertex
+    {
+      JointVector q;
+      std::int32_t parent;
+      bool edge_checked;
+      bool valid;
+    };
+
+    struct Tree
+    {
+      explicit Tree(const std::array<bool, NUM_JOINTS> &wraps) : nn(wraps) {}
+
+      std::vector<Vertex> vertices;
+      KdTree nn;
+
+      void reset(const JointVector &root);
+      std::size_t add(const JointVector &q, std::int32_t parent);
+    };
+
+    enum class Status
+    {
+      TRAPPED,
+      ADVANCED,
+      REACHED
+    };
+
+    Status extend(Tree &tree, const JointVector &target, std::size_t &new_index);
+    Status connect(Tree &tree, const JointVector &target, std::size_t &new_index);
+
+    // validates unchecked edges from `index` back to the root, returns false and
+    // drops the offending subtree on the first invalid edge
+    bool validate_branch(Tree &tree, std::size_t index, std::size_t &edge_checks);
+    void invalidate_subtree(Tree &tree, std::size_t index);
+
+    static void trace(const Tree &tree, std::size_t index, Path &out);
+
+    const StateSpace &space_;
+    const CollisionModel &collision_;
+    Params params_;
+    std::mt19937_64 rng_;
+    Tree start_tree_;
+    Tree goal_tree_;
+  };
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__RRT_CONNECT_HPP_
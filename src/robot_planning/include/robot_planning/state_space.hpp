@@ -0,0 +1,59 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__STATE_SPACE_HPP_
+#define ROBOT_PLANNING__STATE_SPACE_HPP_
+
+#include <random>
+
+#include "robot_planning/kinematics.hpp"
+
+namespace robot_planning
+{
+  // Joint space metric. Joints flagged as wrapping are measured and interpolated
+  // along the shorter arc, all others are treated as bounded intervals.
+  class StateSpace
+  {
+  public:
+    explicit StateSpace(const JointLimits &limits);
+
+    const JointLimits &limits() const { return limits_; }
+
+    // b - a, taking the short way around for wrapping joints
+    JointVector difference(const JointVector &a, const JointVector &b) const;
+
+    double distance(const JointVector &a, const JointVector &b) const;
+
+    // largest single joint displacement between a and b
+    double max_joint_distance(const JointVector &a, const JointVector &b) const;
+
+    JointVector interpolate(const JointVector &a, const JointVector &b, double t) const;
+
+    JointVector sample(std::mt19937_64 &rng) const;
+
+    bool satisfies_bounds(const JointVector &q) const { return limits_.contains(q); }
+
+  private:
+    JointLimits limits_;
+  };
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__STATE_SPACE_HPP_
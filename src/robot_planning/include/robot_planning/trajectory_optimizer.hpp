@@ -0,0 +1,116 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__TRAJECTORY_OPTIMIZER_HPP_
+#define ROBOT_PLANNING__TRAJECTORY_OPTIMIZER_HPP_
+
+#include <array>
+#include <cstdint>
+#include <map>
+
+#include <Eigen/Core>
+#include <Eigen/SparseCholesky>
+
+#include "robot_planning/collision_model.hpp"
+#include "robot_planning/distance_field.hpp"
+#include "robot_planning/planner.hpp"
+#include "robot_planning/state_space.hpp"
+
+namespace robot_planning
+{
+  // CHOMP style trajectory optimisation. A fixed number of waypoints between start
+  // and goal is refined by covariant gradient descent on
+  //   acceleration_weight * sum |q''|^2 + velocity_weight * sum |q'|^2 + obstacle_weight * obstacle cost
+  // where the obstacle cost pulls points on the robot capsules out of a clearance band
+  // around the distance field through their Jacobians. Updates are preconditioned by
+  // the sparse smoothness metric and projected back into the joint limits. The result
+  // is time scaled to the velocity and acceleration limits.
+  //
+  // Successful solutions are kept per quantised start/goal and used as the seed the
+  // next time the same task is planned, also after the environment changed.
+  class TrajectoryOptimizer
+  {
+  public:
+    struct Params
+    {
+      std::size_t num_waypoints = 30; // free waypoints between start and goal
+      std::size_t max_iterations = 200;
+      double step_size = 0.2;
+      double acceleration_weight = 1.0;
+      double velocity_weight = 0.1;
+      double obstacle_weight = 1e-3; // per mm of penetration into the clearance band
+      double clearance = 40.0;       // mm beyond the safety margin
+      double max_update = 0.1;       // rad per waypoint and iteration
+      double tolerance = 1e-3;       // relative cost decrease that counts as progress
+      std::size_t patience = 10;     // iterations without progress before stopping
+      double max_velocity = 1.0;     // rad/s
+      double max_acceleration = 2.0; // rad/s^2
+      std::size_t warm_start_capacity = 64;
+      double warm_start_resolution = 1e-3;
+      DistanceField::Params field;
+    };
+
+    TrajectoryOptimizer(const StateSpace &space, const CollisionModel &collision, const Params &params);
+
+    const Params &params() const { return params_; }
+
+    // previous solution for the same start and goal, end points replaced by the exact ones
+    bool warm_start(const JointVector &start, const JointVector &goal, Path &seed);
+
+    // refines a collision free or colliding seed from start to goal, success only if
+    // every segment of the result passes the collision model
+    PlanResult optimize(const Path &seed, double timeout);
+
+  private:
+    using Key = std::array<std::int64_t, 2 * NUM_JOINTS>;
+    using Waypoints = Eigen::Matrix<double, Eigen::Dynamic, NUM_JOINTS>;
+
+    struct WarmStart
+    {
+      Path path;
+      std::uint64_t stamp;
+    };
+
+    Key make_key(const JointVector &start, const JointVector &goal) const;
+    void update_field();
+    double obstacle_cost(const JointVector &q, JointVector &gradient) const;
+    void project_limits(Waypoints &xi) const;
+
+    const StateSpace &space_;
+    const CollisionModel &collision_;
+    Params params_;
+
+    DistanceField field_;
+    std::uint64_t field_hash_ = 0; // environment the field was built for
+    bool has_field_ = false;
+
+    // smoothness metric A = K^T K over the free waypoints, factorised once
+    Eigen::SparseMatrix<double> A_;
+    Eigen::SparseMatrix<double> Ka_, Kv_;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver_;
+    Eigen::MatrixXd A_inv_;
+
+    std::map<Key, WarmStart> warm_starts_;
+    std::uint64_t stamp_ = 0;
+  };
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__TRAJECTORY_OPTIMIZER_HPP_
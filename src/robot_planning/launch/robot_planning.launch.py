@@ -0,0 +1,31 @@
+from launch import LaunchDescription
+from launch.substitutions import Command, FindExecutable, PathJoinSubstitution
+from launch_ros.actions import Node
+from launch_ros.substitutions import FindPackageShare
+
+
+def generate_launch_description():
+    # the joint limits come from the URDF
+    robot_description_content = Command([
+        PathJoinSubstitution([FindExecutable(name="xacro")]),
+        " ",
+        PathJoinSubstitution([
+            FindPackageShare("robot_description"),
+            "urdf",
+            "robot.urdf",
+        ]),
+    ])
+    robot_description = {"robot_description": robot_description_content}
+
+    planning_config = PathJoinSubstitution([
+        FindPackageShare("robot_planning"), "config", "robot_planning.yaml"
+    ])
+
+    planning_node = Node(
+        package="robot_planning",
+        executable="robot_planning_node",
+        parameters=[planning_config, robot_description],
+        output="both",
+    )
+
+    return LaunchDescription([planning_node])
@@ -0,0 +1,258 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_planning/collision_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace robot_planning
+{
+  namespace
+  {
+    // capsule pairs that are not connected by a joint
+    constexpr std::pair<std::size_t, std::size_t> SELF_COLLISION_PAIRS[] = {
+        {0, 2}, {0, 3}, {0, 4}, {1, 3}, {1, 4}};
+
+    // Lower bound of the capsule axis to box distance. The axis is sampled at a
+    // spacing of at most `step`, so no point on it is further than step / 2 from a sample.
+    double segment_box_distance(const Eigen::Vector3d &a, const Eigen::Vector3d &b, const Box &box, double step)
+    {
+      const double length = (b - a).norm();
+      const int samples = std::max(1, static_cast<int>(std::ceil(length / step)));
+      double best = std::numeric_limits<double>::infinity();
+      for (int i = 0; i <= samples; i++)
+      {
+        const Eigen::Vector3d p = a + (b - a) * (static_cast<double>(i) / samples);
+        best = std::min(best, point_box_distance(p, box));
+      }
+      return best - 0.5 * length / samples;
+    }
+  } // namespace
+
+  double point_box_distance(const Eigen::Vector3d &p, const Box &box)
+  {
+    const Eigen::Vector3d outside = (box.min - p).cwiseMax(p - box.max);
+    if ((outside.array() <= 0.0).all())
+    {
+      // inside: negative distance to the nearest face
+      return outside.maxCoeff();
+    }
+    return outside.cwiseMax(0.0).norm();
+  }
+
+  // Closest points between two segments, Ericson "Real-Time Collision Detection" 5.1.9
+  double segment_segment_distance(const Eigen::Vector3d &p1, const Eigen::Vector3d &q1,
+                                  const Eigen::Vector3d &p2, const Eigen::Vector3d &q2)
+  {
+    constexpr double eps = 1e-9;
+    const Eigen::Vector3d d1 = q1 - p1;
+    const Eigen::Vector3d d2 = q2 - p2;
+    const Eigen::Vector3d r = p1 - p2;
+    const double a = d1.squaredNorm();
+    const double e = d2.squaredNorm();
+    const double f = d2.dot(r);
+
+    double s = 0.0, t = 0.0;
+    if (a <= eps && e <= eps)
+    {
+      return r.norm();
+    }
+    if (a <= eps)
+    {
+      t = std::clamp(f / e, 0.0, 1.0);
+    }
+    else
+    {
+      const double c = d1.dot(r);
+      if (e <= eps)
+      {
+        s = std::clamp(-c / a, 0.0, 1.0);
+      }
+      else
+      {
+        const double b = d1.dot(d2);
+        const double denom = a * e - b * b;
+        s = denom > eps ? std::clamp((b * f - c * e) / denom, 0.0, 1.0) : 0.0;
+        t = (b * s + f) / e;
+        if (t < 0.0)
+        {
+          t = 0.0;
+          s = std::clamp(-c / a, 0.0, 1.0);
+        }
+        else if (t > 1.0)
+        {
+          t = 1.0;
+          s = std::clamp((b - c) / a, 0.0, 1.0);
+        }
+      }
+    }
+    return ((p1 + d1 * s) - (p2 + d2 * t)).norm();
+  }
+
+  CollisionModel::CollisionModel()
+      : CollisionModel(Params())
+  {
+  }
+
+  CollisionModel::CollisionModel(const Params &params)
+      : params_(params)
+  {
+    update_environment_hash();
+  }
+
+  void CollisionModel::set_obstacles(std::vector<Box> obstacles)
+  {
+    obstacles_ = std::move(obstacles);
+    update_environment_hash();
+  }
+
+  void CollisionModel::update_environment_hash()
+  {
+    // 64 bit FNV-1a over the values, std::hash is not stable across builds
+    std::uint64_t hash = 14695981039346656037ull;
+    const auto add = [&hash](double value)
+    {
+      value = value == 0.0 ? 0.0 : value; // -0 and 0 describe the same box
+      std::uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      for (int byte = 0; byte < 8; byte++)
+      {
+        hash ^= (bits >> (8 * byte)) & 0xff;
+        hash *= 1099511628211ull;
+      }
+    };
+    for (const double radius : params_.radii)
+    {
+      add(radius);
+    }
+    add(params_.tool_length);
+    add(params_.safety_margin);
+    add(params_.ground_height);
+    add(params_.check_ground ? 1.0 : 0.0);
+    add(params_.edge_resolution);
+    add(static_cast<double>(obstacles_.size()));
+    for (const Box &box : obstacles_)
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        add(box.min[i]);
+        add(box.max[i]);
+      }
+    }
+    environment_hash_ = hash;
+  }
+
+  void CollisionModel::capsules(const LinkFrames &frames, RobotCapsules &out) const
+  {
+    const Eigen::Vector3d flange = frames[6].translation();
+    const Eigen::Vector3d tool_tip = flange + frames[6].linear().col(2) * params_.tool_length;
+
+    out[0] = {frames[0].translation(), frames[1].translation(), params_.radii[0]};
+    out[1] = {frames[1].translation(), frames[2].translation(), params_.radii[1]};
+    out[2] = {frames[3].translation(), frames[4].translation(), params_.radii[2]};
+    out[3] = {frames[5].translation(), flange, params_.radii[3]};
+    out[4] = {flange, tool_tip, params_.radii[4]};
+  }
+
+  double CollisionModel::capsule_clearance(const RobotCapsules &caps, double stop_below) const
+  {
+    double best = std::numeric_limits<double>::infinity();
+
+    for (const auto &[i, j] : SELF_COLLISION_PAIRS)
+    {
+      const double d = segment_segment_distance(caps[i].a, caps[i].b, caps[j].a, caps[j].b) - caps[i].radius - caps[j].radius;
+      best = std::min(best, d);
+      if (best < stop_below)
+      {
+        return best;
+      }
+    }
+
+    for (std::size_t i = 0; i < NUM_CAPSULES; i++)
+    {
+      const Capsule &cap = caps[i];
+      if (params_.check_ground && i > 0)
+      {
+        best = std::min(best, std::min(cap.a.z(), cap.b.z()) - cap.radius - params_.ground_height);
+      }
+      for (const Box &box : obstacles_)
+      {
+        best = std::min(best, segment_box_distance(cap.a, cap.b, box, cap.radius) - cap.radius);
+      }
+      if (best < stop_below)
+      {
+        return best;
+      }
+    }
+    return best;
+  }
+
+  bool CollisionModel::is_valid(const JointVector &q) const
+  {
+    LinkFrames frames;
+    RobotCapsules caps;
+    link_frames(q, frames);
+    capsules(frames, caps);
+    return capsule_clearance(caps, params_.safety_margin) >= params_.safety_margin;
+  }
+
+  double CollisionModel::clearance(const JointVector &q) const
+  {
+    LinkFrames frames;
+    RobotCapsules caps;
+    link_frames(q, frames);
+    capsules(frames, caps);
+    return capsule_clearance(caps, -std::numeric_limits<double>::infinity());
+  }
+
+  bool CollisionModel::is_motion_valid(const StateSpace &space, const JointVector &a, const JointVector &b) const
+  {
+    const int steps = std::max(1, static_cast<int>(std::ceil(space.max_joint_distance(a, b) / params_.edge_resolution)));
+
+    if (!is_valid(b))
+    {
+      return false;
+    }
+
+    // check intermediate states in bisection order so collisions in the middle
+    // of an edge are found early
+    int span = 1;
+    while (span < steps)
+    {
+      span *= 2;
+    }
+    for (int stride = span / 2; stride >= 1; stride /= 2)
+    {
+      for (int k = stride; k < steps; k += 2 * stride)
+      {
+        if (!is_valid(space.interpolate(a, b, static_cast<double>(k) / steps)))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+} // namespace robot_planning
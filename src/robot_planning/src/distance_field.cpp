@@ -0,0 +1,118 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_planning/distance_field.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robot_planning
+{
+  DistanceField::DistanceField()
+      : DistanceField(Params())
+  {
+  }
+
+  DistanceField::DistanceField(const Params &params)
+      : params_(params)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      size_[i] = static_cast<std::size_t>(std::ceil((params_.max[i] - params_.min[i]) / params_.resolution)) + 1;
+    }
+    values_.assign(size_[0] * size_[1] * size_[2], static_cast<float>(params_.max_distance));
+  }
+
+  void DistanceField::build(const std::vector<Box> &obstacles, bool ground, double ground_height)
+  {
+    parallel_for(size_[2], params_.num_threads, [&](std::size_t begin, std::size_t end, std::size_t)
+                 {
+                   for (std::size_t z = begin; z < end; z++)
+                   {
+                     for (std::size_t y = 0; y < size_[1]; y++)
+                     {
+                       for (std::size_t x = 0; x < size_[0]; x++)
+                       {
+                         const Eigen::Vector3d p = params_.min + params_.resolution * Eigen::Vector3d(
+                             static_cast<double>(x), static_cast<double>(y), static_cast<double>(z));
+                         double d = params_.max_distance;
+                         if (ground)
+                         {
+                           d = std::min(d, p.z() - ground_height);
+                         }
+                         for (const Box &box : obstacles)
+                         {
+                           d = std::min(d, point_box_distance(p, box));
+                         }
+                         values_[index(x, y, z)] = static_cast<float>(d);
+                       }
+                     }
+                   } });
+  }
+
+  double DistanceField::distance(const Eigen::Vector3d &p, Eigen::Vector3d &gradient) const
+  {
+    // cell containing p and the fractional position inside it
+    std::array<std::size_t, 3> c;
+    Eigen::Vector3d f;
+    for (int i = 0; i < 3; i++)
+    {
+      const double u = std::clamp((p[i] - params_.min[i]) / params_.resolution, 0.0, static_cast<double>(size_[i] - 1));
+      c[i] = std::min(static_cast<std::size_t>(u), size_[i] - 2);
+      f[i] = u - static_cast<double>(c[i]);
+    }
+
+    double v[2][2][2];
+    for (int dz = 0; dz < 2; dz++)
+    {
+      for (int dy = 0; dy < 2; dy++)
+      {
+        for (int dx = 0; dx < 2; dx++)
+        {
+          v[dz][dy][dx] = values_[index(c[0] + dx, c[1] + dy, c[2] + dz)];
+        }
+      }
+    }
+
+    // interpolate along x, then y, then z, keeping the partial derivatives
+    double vy[2][2], dvy[2][2];
+    for (int dz = 0; dz < 2; dz++)
+    {
+      for (int dy = 0; dy < 2; dy++)
+      {
+        vy[dz][dy] = v[dz][dy][0] + f.x() * (v[dz][dy][1] - v[dz][dy][0]);
+        dvy[dz][dy] = v[dz][dy][1] - v[dz][dy][0];
+      }
+    }
+    double vz[2], dxz[2], dyz[2];
+    for (int dz = 0; dz < 2; dz++)
+    {
+      vz[dz] = vy[dz][0] + f.y() * (vy[dz][1] - vy[dz][0]);
+      dxz[dz] = dvy[dz][0] + f.y() * (dvy[dz][1] - dvy[dz][0]);
+      dyz[dz] = vy[dz][1] - vy[dz][0];
+    }
+
+    gradient.x() = (dxz[0] + f.z() * (dxz[1] - dxz[0])) / params_.resolution;
+    gradient.y() = (dyz[0] + f.z() * (dyz[1] - dyz[0])) / params_.resolution;
+    gradient.z() = (vz[1] - vz[0]) / params_.resolution;
+    return vz[0] + f.z() * (vz[1] - vz[0]);
+  }
+
+} // namespace robot_planning
@@ -0,0 +1,68 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_planning/kinematics.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+#include <urdf/model.h>
+
+namespace robot_planning
+{
+  JointLimits JointLimits::from_urdf(const std::string &urdf_xml, const std::vector<std::string> &joint_names)
+  {
+    if (joint_names.size() != NUM_JOINTS)
+    {
+      throw std::runtime_error("Expected " + std::to_string(NUM_JOINTS) + " joint names.");
+    }
+    urdf::Model model;
+    if (!model.initString(urdf_xml))
+    {
+      throw std::runtime_error("Cannot parse the URDF.");
+    }
+
+    JointLimits limits;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      const auto joint = model.getJoint(joint_names[i]);
+      if (!joint)
+      {
+        throw std::runtime_error("No joint '" + joint_names[i] + "' in the URDF.");
+      }
+      if (joint->type == urdf::Joint::CONTINUOUS)
+      {
+        limits.lower[i] = -M_PI;
+        limits.upper[i] = M_PI;
+        limits.wraps[i] = true;
+        continue;
+      }
+      if (joint->type != urdf::Joint::REVOLUTE || !joint->limits || !(joint->limits->lower < joint->limits->upper))
+      {
+        throw std::runtime_error("Joint '" + joint_names[i] + "' is not a revolute joint with limits.");
+      }
+      limits.lower[i] = joint->limits->lower;
+      limits.upper[i] = joint->limits->upper;
+      limits.wraps[i] = false;
+    }
+    return limits;
+  }
+
+} // namespace robot_planning
@@ -0,0 +1,224 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_planning/kinematics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace robot_planning
+{
+  namespace
+  {
+    struct DHRow
+    {
+      double theta_offset;
+      double d;
+      double alpha;
+      double a;
+    };
+
+    constexpr DHRow DH_PARAMS[NUM_JOINTS] = {
+        {0.0, dh::D1, -M_PI / 2, 0.0},
+        {-M_PI / 2, dh::D2, 0.0, dh::L2},
+        {M_PI / 2, 0.0, M_PI / 2, 0.0},
+        {0.0, dh::D4, -M_PI / 2, 0.0},
+        {0.0, 0.0, M_PI / 2, 0.0},
+        {0.0, dh::D6, 0.0, 0.0},
+    };
+
+    Eigen::Isometry3d dh_transform(const DHRow &row, double q)
+    {
+      const double theta = q + row.theta_offset;
+      const double ct = std::cos(theta), st = std::sin(theta);
+      const double ca = std::cos(row.alpha), sa = std::sin(row.alpha);
+
+      Eigen::Matrix4d m;
+      m << ct, -st * ca, st * sa, row.a * ct,
+          st, ct * ca, -ct * sa, row.a * st,
+          0.0, sa, ca, row.d,
+          0.0, 0.0, 0.0, 1.0;
+      return Eigen::Isometry3d(m);
+    }
+
+    constexpr double IK_EPSILON = 1e-6;
+  } // namespace
+
+  bool JointLimits::contains(const JointVector &q) const
+  {
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      if (wraps[i])
+      {
+        continue;
+      }
+      if (q[i] < lower[i] || q[i] > upper[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void link_frames(const JointVector &q, LinkFrames &frames)
+  {
+    frames[0].setIdentity();
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      frames[i + 1] = frames[i] * dh_transform(DH_PARAMS[i], q[i]);
+    }
+  }
+
+  Eigen::Isometry3d forward_kinematics(const JointVector &q)
+  {
+    LinkFrames frames;
+    link_frames(q, frames);
+    return frames[NUM_JOINTS];
+  }
+
+  Jacobian jacobian(const LinkFrames &frames)
+  {
+    Jacobian J;
+    const Eigen::Vector3d p_e = frames[NUM_JOINTS].translation();
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      const Eigen::Vector3d z = frames[i].linear().col(2);
+      const Eigen::Vector3d p = frames[i].translation();
+      J.block<3, 1>(0, i) = z.cross(p_e - p);
+      J.block<3, 1>(3, i) = z;
+    }
+    return J;
+  }
+
+  std::size_t inverse_kinematics(const Eigen::Isometry3d &T_06, const JointLimits &limits, IKSolutions &solutions)
+  {
+    const Eigen::Matrix3d R_06 = T_06.linear();
+    const Eigen::Vector3d P_04 = T_06.translation() - dh::D6 * R_06.col(2); // wrist center
+
+    // q1, shoulder left / right
+    const double planar_dist = std::hypot(P_04.x(), P_04.y());
+    const double phi = std::asin(std::clamp(dh::D2 / planar_dist, -1.0, 1.0));
+    const double heading = std::atan2(P_04.y(), P_04.x());
+    const double q1[2] = {heading - phi, heading + M_PI + phi};
+
+    // q3, elbow up / down
+    const Eigen::Vector3d P_04_projected = P_04 - dh::D2 * dh_transform(DH_PARAMS[0], q1[0]).linear().col(2);
+    const double r = std::hypot(P_04_projected.x(), P_04_projected.y());
+    const double s = P_04_projected.z() - dh::D1;
+    const double D = std::hypot(r, s);
+    double elbow_cos = (D * D - dh::L2 * dh::L2 - dh::D4 * dh::D4) / (2.0 * dh::L2 * dh::D4);
+    if (elbow_cos < -1.0 - IK_EPSILON || elbow_cos > 1.0 + IK_EPSILON)
+    {
+      return 0;
+    }
+    elbow_cos = std::clamp(elbow_cos, -1.0, 1.0);
+    const double elbow = std::acos(elbow_cos);
+    const double q3[2] = {elbow, -elbow};
+
+    // q2
+    const double alpha = std::atan2(dh::D4 * std::sin(q3[0]), dh::L2 + dh::D4 * std::cos(q3[0]));
+    const double theta_D = M_PI / 2 - std::atan2(s, r);
+    const double q2[2] = {theta_D - alpha, theta_D + alpha};
+
+    const double arm[4][3] = {
+        {q1[0], q2[0], q3[0]},
+        {q1[0], q2[1], q3[1]},
+        {q1[1], -q2[0], -q3[0]},
+        {q1[1], -q2[1], -q3[1]},
+    };
+
+    std::size_t count = 0;
+    for (std::size_t c = 0; c < 4; c++)
+    {
+      Eigen::Isometry3d T_03 = Eigen::Isometry3d::Identity();
+      for (std::size_t i = 0; i < 3; i++)
+      {
+        T_03 = T_03 * dh_transform(DH_PARAMS[i], arm[c][i]);
+      }
+      const Eigen::Matrix3d R_36 = T_03.linear().transpose() * R_06;
+
+      // ZYZ Euler angles of the wrist
+      double wrist[2][3];
+      std::size_t wrist_count = 2;
+      const double q5 = std::acos(std::clamp(R_36(2, 2), -1.0, 1.0));
+      if (std::abs(std::sin(q5)) > IK_EPSILON)
+      {
+        wrist[0][0] = std::atan2(R_36(1, 2), R_36(0, 2));
+        wrist[0][1] = q5;
+        wrist[0][2] = std::atan2(R_36(2, 1), -R_36(2, 0));
+        wrist[1][0] = wrist[0][0] + M_PI;
+        wrist[1][1] = -q5;
+        wrist[1][2] = wrist[0][2] + M_PI;
+      }
+      else
+      {
+        // singularity, only q4 + q6 is defined
+        wrist_count = 1;
+        wrist[0][0] = 0.0;
+        if (R_36(2, 2) > 0.0)
+        {
+          wrist[0][1] = 0.0;
+          wrist[0][2] = -std::atan2(R_36(0, 1), R_36(0, 0));
+        }
+        else
+        {
+          wrist[0][1] = M_PI;
+          wrist[0][2] = std::atan2(R_36(0, 1), R_36(0, 0));
+        }
+      }
+
+      for (std::size_t w = 0; w < wrist_count; w++)
+      {
+        JointVector q;
+        q << arm[c][0], arm[c][1], arm[c][2], wrist[w][0], wrist[w][1], wrist[w][2];
+        for (std::size_t i = 0; i < NUM_JOINTS; i++)
+        {
+          q[i] = normalize_angle(q[i]);
+        }
+        if (limits.contains(q))
+        {
+          solutions[count++] = {q, static_cast<std::uint8_t>(2 * c + w)};
+        }
+      }
+    }
+    return count;
+  }
+
+  PositionJacobian point_jacobian(const LinkFrames &frames, std::size_t link, const Eigen::Vector3d &p)
+  {
+    PositionJacobian J = PositionJacobian::Zero();
+    for (std::size_t i = 0; i < link; i++)
+    {
+      J.col(i) = frames[i].linear().col(2).cross(p - frames[i].translation());
+    }
+    return J;
+  }
+
+  double normalize_angle(double angle)
+  {
+    angle = std::fmod(angle + M_PI, 2.0 * M_PI);
+    if (angle < 0.0)
+    {
+      angle += 2.0 * M_PI;
+    }
+    return angle - M_PI;
+  }
+
+} // namespace robot_planning
@@ -0,0 +1,98 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROBOT_PLANNING__PARAMETERS_HPP_
+#define ROBOT_PLANNING__PARAMETERS_HPP_
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+
+#include "robot_planning/collision_model.hpp"
+
+// Parameter handling shared by the planning node and the roadmap builder, so both
+// see the same robot and environment from config/robot_planning.yaml.
+namespace robot_planning
+{
+  inline CollisionModel::Params declare_collision_params(rclcpp::Node &node)
+  {
+    CollisionModel::Params params;
+    const auto radii = node.declare_parameter<std::vector<double>>(
+        "link_radii", std::vector<double>(params.radii.begin(), params.radii.end()));
+    if (radii.size() == NUM_CAPSULES)
+    {
+      std::copy(radii.begin(), radii.end(), params.radii.begin());
+    }
+    else
+    {
+      RCLCPP_WARN(node.get_logger(), "link_radii needs %zu entries, using defaults.", NUM_CAPSULES);
+    }
+    params.tool_length = node.declare_parameter("tool_length", params.tool_length);
+    params.safety_margin = node.declare_parameter("safety_margin", params.safety_margin);
+    params.ground_height = node.declare_parameter("ground_height", params.ground_height);
+    params.check_ground = node.declare_parameter("check_ground", params.check_ground);
+    params.edge_resolution = node.declare_parameter("edge_resolution", params.edge_resolution);
+    return params;
+  }
+
+  inline std::vector<std::string> joint_names()
+  {
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      names.push_back("joint_" + std::to_string(i + 1));
+    }
+    return names;
+  }
+
+  // joint limits from the URDF in the robot_description parameter, throws if it
+  // has none for the joints
+  inline JointLimits declare_joint_limits(rclcpp::Node &node, const std::vector<std::string> &joint_names)
+  {
+    const std::string description = node.declare_parameter("robot_description", std::string(""));
+    if (description.empty())
+    {
+      throw std::runtime_error("Set robot_description to the URDF, the joint limits come from it.");
+    }
+    return JointLimits::from_urdf(description, joint_names);
+  }
+
+  // boxes as flat [min_x, min_y, min_z, max_x, max_y, max_z, ...] in mm
+  inline bool boxes_from_parameter(const std::vector<double> &values, std::vector<Box> &boxes)
+  {
+    if (values.size() % 6 != 0)
+    {
+      return false;
+    }
+    boxes.clear();
+    for (std::size_t i = 0; i < values.size(); i += 6)
+    {
+      boxes.push_back({Eigen::Vector3d(values[i], values[i + 1], values[i + 2]),
+                       Eigen::Vector3d(values[i + 3], values[i + 4], values[i + 5])});
+    }
+    return true;
+  }
+
+} // namespace robot_planning
+
+#endif // ROBOT_PLANNING__PARAMETERS_HPP_
@@ -0,0 +1,204 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_planning/path_simplifier.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace robot_planning
+{
+  PathSimplifier::PathSimplifier(const StateSpace &space, const CollisionModel &collision, const Params &params)
+      : space_(space),
+        collision_(collision),
+        params_(params)
+  {
+  }
+
+  Path PathSimplifier::simplify(const Path &path, double timeout) const
+  {
+    if (path.size() < 3)
+    {
+      return path;
+    }
+
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeout));
+    const std::size_t workers = std::max<std::size_t>(1, params_.num_threads);
+
+    std::vector<Path> candidates(workers);
+    parallel_for(workers, workers, [&](std::size_t begin, std::size_t end, std::size_t)
+                 {
+                   for (std::size_t k = begin; k < end; k++)
+                   {
+                     candidates[k] = shortcut(path, params_.seed + k, deadline);
+                   } });
+
+    Path best = *std::min_element(candidates.begin(), candidates.end(), [this](const Path &a, const Path &b)
+                                  { return path_length(space_, a) < path_length(space_, b); });
+
+    for (std::size_t pass = 0; pass < params_.smoothing_passes && Clock::now() < deadline; pass++)
+    {
+      best = smooth(best);
+    }
+    return best;
+  }
+
+  Path PathSimplifier::shortcut(const Path &path, std::uint64_t seed, Clock::time_point deadline) const
+  {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> fraction(0.0, 1.0);
+    Path current = path;
+
+    for (std::size_t attempt = 0; attempt < params_.shortcut_attempts && current.size() > 2; attempt++)
+    {
+      if (Clock::now() > deadline)
+      {
+        break;
+      }
+
+      // pick a point on segment i and one on segment j, both segments are collision free
+      std::uniform_int_distribution<std::size_t> segment(0, current.size() - 2);
+      std::size_t i = segment(rng), j = segment(rng);
+      if (i == j)
+      {
+        continue;
+      }
+      if (i > j)
+      {
+        std::swap(i, j);
+      }
+      const bool at_vertices = fraction(rng) < 0.5;
+      const JointVector a = at_vertices ? current[i] : space_.interpolate(current[i], current[i + 1], fraction(rng));
+      const JointVector b = at_vertices ? current[j + 1] : space_.interpolate(current[j], current[j + 1], fraction(rng));
+
+      double old_length = space_.distance(a, current[i + 1]) + space_.distance(current[j], b);
+      for (std::size_t k = i + 1; k < j; k++)
+      {
+        old_length += space_.distance(current[k], current[k + 1]);
+      }
+      if (space_.distance(a, b) >= old_length || !collision_.is_motion_valid(space_, a, b))
+      {
+        continue;
+      }
+      // edges are checked at edge_resolution, so the kept part of a segment is
+      // sampled at other states than the segment was and needs its own check
+      if (!at_vertices &&
+          (!collision_.is_motion_valid(space_, current[i], a) || !collision_.is_motion_valid(space_, b, current[j + 1])))
+      {
+        continue;
+      }
+
+      Path next;
+      next.reserve(current.size());
+      next.insert(next.end(), current.begin(), current.begin() + i + 1);
+      if (!at_vertices)
+      {
+        next.push_back(a);
+        next.push_back(b);
+      }
+      next.insert(next.end(), current.begin() + j + 1, current.end());
+      current = std::move(next);
+    }
+    return current;
+  }
+
+  Path PathSimplifier::smooth(const Path &path) const
+  {
+    if (path.size() < 3)
+    {
+      return path;
+    }
+
+    // Cut every interior corner at `corner_fraction` of its adjacent segments and
+    // check the new chord.
+    const std::size_t corners = path.size() - 2;
+    std::vector<JointVector> cut_in(corners), cut_out(corners);
+    std::vector<char> cut(corners, 0);
+
+    parallel_for(corners, params_.num_threads, [&](std::size_t begin, std::size_t end, std::size_t)
+                 {
+                   for (std::size_t c = begin; c < end; c++)
+                   {
+                     const JointVector &q = path[c + 1];
+                     cut_in[c] = space_.interpolate(q, path[c], params_.corner_fraction);
+                     cut_out[c] = space_.interpolate(q, path[c + 2], params_.corner_fraction);
+                     cut[c] = collision_.is_motion_valid(space_, cut_in[c], cut_out[c]);
+                   } });
+
+    // What is left of a segment between the cuts is checked too, it is sampled at
+    // other states than the whole segment was. A failing piece takes back the cuts
+    // at its ends, until only whole, already checked segments remain.
+    const std::size_t segments = path.size() - 1;
+    const auto piece_start = [&](std::size_t s) -> const JointVector &
+    { return s > 0 && cut[s - 1] ? cut_out[s - 1] : path[s]; };
+    const auto piece_end = [&](std::size_t s) -> const JointVector &
+    { return s < corners && cut[s] ? cut_in[s] : path[s + 1]; };
+    std::vector<char> piece_valid(segments, 1);
+    bool changed = true;
+    while (changed)
+    {
+      parallel_for(segments, params_.num_threads, [&](std::size_t begin, std::size_t end, std::size_t)
+                   {
+                     for (std::size_t s = begin; s < end; s++)
+                     {
+                       const bool whole = !(s > 0 && cut[s - 1]) && !(s < corners && cut[s]);
+                       piece_valid[s] = whole || collision_.is_motion_valid(space_, piece_start(s), piece_end(s));
+                     } });
+      changed = false;
+      for (std::size_t s = 0; s < segments; s++)
+      {
+        if (piece_valid[s])
+        {
+          continue;
+        }
+        if (s > 0 && cut[s - 1])
+        {
+          cut[s - 1] = 0;
+          changed = true;
+        }
+        if (s < corners && cut[s])
+        {
+          cut[s] = 0;
+          changed = true;
+        }
+      }
+    }
+
+    Path smoothed;
+    smoothed.reserve(path.size() + corners);
+    smoothed.push_back(path.front());
+    for (std::size_t c = 0; c < corners; c++)
+    {
+      if (cut[c])
+      {
+        smoothed.push_back(cut_in[c]);
+        smoothed.push_back(cut_out[c]);
+      }
+      else
+      {
+        smoothed.push_back(path[c + 1]);
+      }
+    }
+    smoothed.push_back(path.back());
+    return smoothed;
+  }
+
+} // namespace robot_planning
@@ -0,0 +1,706 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_planning/roadmap.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <random>
+
+namespace robot_planning
+{
+  namespace
+  {
+    constexpr char MAGIC[8] = {'R', 'B', 'T', 'P', 'R', 'M', '\0', '\0'};
+    constexpr std::uint32_t FORMAT_VERSION = 1;
+    constexpr std::size_t NUM_COLLISION_PARAMS = NUM_CAPSULES + 3;
+
+    // All sections start on an 8 byte boundary, offsets are from the file start.
+    struct FileHeader
+    {
+      char magic[8];
+      std::uint32_t format_version;
+      std::uint32_t num_joints;
+      double collision_params[NUM_COLLISION_PARAMS];
+      std::uint64_t num_nodes;
+      std::uint64_t num_adjacency;
+      std::uint64_t num_edges;
+      std::uint64_t num_obstacles;
+      std::uint64_t nodes_offset;
+      std::uint64_t node_bounds_offset;
+      std::uint64_t offsets_offset;
+      std::uint64_t targets_offset;
+      std::uint64_t weights_offset;
+      std::uint64_t edge_ids_offset;
+      std::uint64_t edge_bounds_offset;
+      std::uint64_t obstacles_offset;
+      std::uint64_t file_size;
+    };
+
+    std::array<double, NUM_COLLISION_PARAMS> pack_collision_params(const CollisionModel::Params &params)
+    {
+      std::array<double, NUM_COLLISION_PARAMS> packed{};
+      std::copy(params.radii.begin(), params.radii.end(), packed.begin());
+      packed[NUM_CAPSULES] = params.tool_length;
+      packed[NUM_CAPSULES + 1] = params.safety_margin;
+      packed[NUM_CAPSULES + 2] = params.ground_height;
+      return packed;
+    }
+
+    std::uint64_t align8(std::uint64_t offset)
+    {
+      return (offset + 7) & ~std::uint64_t{7};
+    }
+
+    void expand(Bounds &bounds, const Eigen::Vector3d &p, double radius)
+    {
+      for (int k = 0; k < 3; k++)
+      {
+        bounds.min[k] = std::min(bounds.min[k], static_cast<float>(p[k] - radius));
+        bounds.max[k] = std::max(bounds.max[k], static_cast<float>(p[k] + radius));
+      }
+    }
+
+    Bounds empty_bounds()
+    {
+      Bounds bounds;
+      std::fill(std::begin(bounds.min), std::end(bounds.min), std::numeric_limits<float>::max());
+      std::fill(std::begin(bounds.max), std::end(bounds.max), std::numeric_limits<float>::lowest());
+      return bounds;
+    }
+
+    void add_state(Bounds &bounds, const CollisionModel &collision, const JointVector &q)
+    {
+      LinkFrames frames;
+      RobotCapsules caps;
+      link_frames(q, frames);
+      collision.capsules(frames, caps);
+      const double inflation = collision.params().safety_margin;
+      for (const Capsule &cap : caps)
+      {
+        expand(bounds, cap.a, cap.radius + inflation);
+        expand(bounds, cap.b, cap.radius + inflation);
+      }
+    }
+
+    // covers the same states CollisionModel::is_motion_valid checks
+    Bounds motion_bounds(const StateSpace &space, const CollisionModel &collision, const JointVector &a, const JointVector &b)
+    {
+      const int steps = std::max(1, static_cast<int>(std::ceil(space.max_joint_distance(a, b) / collision.params().edge_resolution)));
+      Bounds bounds = empty_bounds();
+      for (int k = 0; k <= steps; k++)
+      {
+        add_state(bounds, collision, space.interpolate(a, b, static_cast<double>(k) / steps));
+      }
+      return bounds;
+    }
+
+    template <typename T>
+    void write_section(std::ofstream &out, const std::vector<T> &values, std::uint64_t offset)
+    {
+      out.seekp(static_cast<std::streamoff>(offset));
+      out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    bool same_box(const Box &a, const Box &b)
+    {
+      return a.min == b.min && a.max == b.max;
+    }
+  } // namespace
+
+  bool Bounds::overlaps(const Box &box) const
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      if (max[k] < box.min[k] || min[k] > box.max[k])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  RoadmapData build_roadmap(const StateSpace &space, const CollisionModel &collision, const RoadmapBuildParams &params)
+  {
+    const std::size_t threads = std::max<std::size_t>(1, params.num_threads);
+    RoadmapData data;
+    data.obstacles = collision.obstacles();
+
+    // collision free samples, every worker fills its own quota
+    std::vector<std::vector<JointVector>> samples(threads);
+    parallel_for(threads, threads, [&](std::size_t begin, std::size_t end, std::size_t)
+                 {
+                   for (std::size_t t = begin; t < end; t++)
+                   {
+                     std::mt19937_64 rng(params.seed + t);
+                     const std::size_t quota = params.num_nodes / threads + (t < params.num_nodes % threads ? 1 : 0);
+                     samples[t].reserve(quota);
+                     while (samples[t].size() < quota)
+                     {
+                       const JointVector q = space.sample(rng);
+                       if (collision.is_valid(q))
+                       {
+                         samples[t].push_back(q);
+                       }
+                     }
+                   } });
+    for (auto &chunk : samples)
+    {
+      data.nodes.insert(data.nodes.end(), chunk.begin(), chunk.end());
+    }
+    const std::size_t n = data.nodes.size();
+
+    KdTree nn(space.limits().wraps);
+    nn.reserve(n);
+    for (const JointVector &q : data.nodes)
+    {
+      nn.insert(q);
+    }
+
+    // candidate edges to the k nearest neighbours, deduplicated as (low, high)
+    std::vector<std::vector<std::pair<std::uint32_t, std::uint32_t>>> worker_candidates(threads);
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t worker)
+                 {
+                   std::vector<std::pair<double, std::size_t>> neighbors;
+                   for (std::size_t i = begin; i < end; i++)
+                   {
+                     nn.nearest_k(data.nodes[i], params.k_neighbors + 1, neighbors);
+                     for (const auto &[d, j] : neighbors)
+                     {
+                       if (j != i)
+                       {
+                         worker_candidates[worker].emplace_back(static_cast<std::uint32_t>(std::min(i, j)),
+                                                                static_cast<std::uint32_t>(std::max(i, j)));
+                       }
+                     }
+                   } });
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> candidates;
+    for (auto &chunk : worker_candidates)
+    {
+      candidates.insert(candidates.end(), chunk.begin(), chunk.end());
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::vector<char> valid(candidates.size(), 0);
+    std::vector<Bounds> candidate_bounds(candidates.size());
+    parallel_for(candidates.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t)
+                 {
+                   for (std::size_t e = begin; e < end; e++)
+                   {
+                     const JointVector &a = data.nodes[candidates[e].first];
+                     const JointVector &b = data.nodes[candidates[e].second];
+                     valid[e] = collision.is_motion_valid(space, a, b);
+                     if (valid[e])
+                     {
+                       candidate_bounds[e] = motion_bounds(space, collision, a, b);
+                     }
+                   } });
+
+    data.node_bounds.resize(n);
+    parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t)
+                 {
+                   for (std::size_t i = begin; i < end; i++)
+                   {
+                     data.node_bounds[i] = empty_bounds();
+                     add_state(data.node_bounds[i], collision, data.nodes[i]);
+                   } });
+
+    // CSR adjacency
+    std::vector<std::uint64_t> degree(n, 0);
+    for (std::size_t e = 0; e < candidates.size(); e++)
+    {
+      if (valid[e])
+      {
+        degree[candidates[e].first]++;
+        degree[candidates[e].second]++;
+        data.edge_bounds.push_back(candidate_bounds[e]);
+      }
+    }
+    data.offsets.assign(n + 1, 0);
+    for (std::size_t i = 0; i < n; i++)
+    {
+      data.offsets[i + 1] = data.offsets[i] + degree[i];
+    }
+    data.targets.resize(data.offsets[n]);
+    data.weights.resize(data.offsets[n]);
+    data.edge_ids.resize(data.offsets[n]);
+
+    std::vector<std::uint64_t> cursor(data.offsets.begin(), data.offsets.end() - 1);
+    std::uint32_t edge_id = 0;
+    for (std::size_t e = 0; e < candidates.size(); e++)
+    {
+      if (!valid[e])
+      {
+        continue;
+      }
+      const auto [a, b] = candidates[e];
+      const auto weight = static_cast<float>(space.distance(data.nodes[a], data.nodes[b]));
+      for (const auto &[from, to] : {std::make_pair(a, b), std::make_pair(b, a)})
+      {
+        const std::uint64_t slot = cursor[from]++;
+        data.targets[slot] = to;
+        data.weights[slot] = weight;
+        data.edge_ids[slot] = edge_id;
+      }
+      edge_id++;
+    }
+    return data;
+  }
+
+  bool save_roadmap(const std::string &path, const RoadmapData &data, const CollisionModel::Params &collision_params,
+                    std::string &error)
+  {
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.format_version = FORMAT_VERSION;
+    header.num_joints = NUM_JOINTS;
+    const auto packed = pack_collision_params(collision_params);
+    std::copy(packed.begin(), packed.end(), header.collision_params);
+    header.num_nodes = data.nodes.size();
+    header.num_adjacency = data.targets.size();
+    header.num_edges = data.edge_bounds.size();
+    header.num_obstacles = data.obstacles.size();
+
+    std::vector<double> nodes;
+    nodes.reserve(data.nodes.size() * NUM_JOINTS);
+    for (const JointVector &q : data.nodes)
+    {
+      nodes.insert(nodes.end(), q.data(), q.data() + NUM_JOINTS);
+    }
+    std::vector<double> obstacles;
+    for (const Box &box : data.obstacles)
+    {
+      obstacles.insert(obstacles.end(), box.min.data(), box.min.data() + 3);
+      obstacles.insert(obstacles.end(), box.max.data(), box.max.data() + 3);
+    }
+
+    std::uint64_t offset = align8(sizeof(FileHeader));
+    const auto place = [&offset](std::uint64_t &field, std::uint64_t bytes)
+    {
+      field = offset;
+      offset = align8(offset + bytes);
+    };
+    place(header.nodes_offset, nodes.size() * sizeof(double));
+    place(header.node_bounds_offset, data.node_bounds.size() * sizeof(Bounds));
+    place(header.offsets_offset, data.offsets.size() * sizeof(std::uint64_t));
+    place(header.targets_offset, data.targets.size() * sizeof(std::uint32_t));
+    place(header.weights_offset, data.weights.size() * sizeof(float));
+    place(header.edge_ids_offset, data.edge_ids.size() * sizeof(std::uint32_t));
+    place(header.edge_bounds_offset, data.edge_bounds.size() * sizeof(Bounds));
+    place(header.obstacles_offset, obstacles.size() * sizeof(double));
+    header.file_size = offset;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+      error = "Cannot open " + path + " for writing.";
+      return false;
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    write_section(out, nodes, header.nodes_offset);
+    write_section(out, data.node_bounds, header.node_bounds_offset);
+    write_section(out, data.offsets, header.offsets_offset);
+    write_section(out, data.targets, header.targets_offset);
+    write_section(out, data.weights, header.weights_offset);
+    write_section(out, data.edge_ids, header.edge_ids_offset);
+    write_section(out, data.edge_bounds, header.edge_bounds_offset);
+    write_section(out, obstacles, header.obstacles_offset);
+    // pad to the full size so every section is backed by the file
+    out.seekp(static_cast<std::streamoff>(header.file_size - 1));
+    out.put('\0');
+
+    if (!out)
+    {
+      error = "Failed writing " + path + ".";
+      return false;
+    }
+    return true;
+  }
+
+  std::unique_ptr<Roadmap> Roadmap::open(const std::string &path, const StateSpace &space,
+                                         const CollisionModel::Params &collision_params, std::string &error)
+  {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      error = "Cannot open " + path + ": " + std::strerror(errno);
+      return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(FileHeader))
+    {
+      ::close(fd);
+      error = path + " is not a roadmap file.";
+      return nullptr;
+    }
+    void *mapping = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+      error = "Cannot map " + path + ": " + std::strerror(errno);
+      return nullptr;
+    }
+
+    std::unique_ptr<Roadmap> roadmap(new Roadmap(space));
+    roadmap->mapping_ = mapping;
+    roadmap->mapping_size_ = static_cast<std::size_t>(st.st_size);
+
+    const auto *base = static_cast<const char *>(mapping);
+    const auto &header = *reinterpret_cast<const FileHeader *>(base);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.format_version != FORMAT_VERSION ||
+        header.num_joints != NUM_JOINTS || header.file_size != roadmap->mapping_size_)
+    {
+      error = path + " is not a compatible roadmap file.";
+      return nullptr;
+    }
+    const auto packed = pack_collision_params(collision_params);
+    if (!std::equal(packed.begin(), packed.end(), header.collision_params))
+    {
+      error = path + " was built with different collision parameters, rebuild it.";
+      return nullptr;
+    }
+
+    roadmap->num_nodes_ = header.num_nodes;
+    roadmap->num_edges_ = header.num_edges;
+    roadmap->nodes_ = reinterpret_cast<const double *>(base + header.nodes_offset);
+    roadmap->node_bounds_ = reinterpret_cast<const Bounds *>(base + header.node_bounds_offset);
+    roadmap->offsets_ = reinterpret_cast<const std::uint64_t *>(base + header.offsets_offset);
+    roadmap->targets_ = reinterpret_cast<const std::uint32_t *>(base + header.targets_offset);
+    roadmap->weights_ = reinterpret_cast<const float *>(base + header.weights_offset);
+    roadmap->edge_ids_ = reinterpret_cast<const std::uint32_t *>(base + header.edge_ids_offset);
+    roadmap->edge_bounds_ = reinterpret_cast<const Bounds *>(base + header.edge_bounds_offset);
+
+    const auto *obstacles = reinterpret_cast<const double *>(base + header.obstacles_offset);
+    for (std::size_t i = 0; i < header.num_obstacles; i++)
+    {
+      const double *v = obstacles + 6 * i;
+      roadmap->obstacles_.push_back({Eigen::Vector3d(v[0], v[1], v[2]), Eigen::Vector3d(v[3], v[4], v[5])});
+    }
+
+    const std::size_t n = roadmap->num_nodes_;
+    roadmap->node_state_.assign(n, VALID);
+    roadmap->edge_state_.assign(roadmap->num_edges_, VALID);
+    roadmap->nn_.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+      roadmap->nn_.insert(roadmap->node(i));
+    }
+    roadmap->goal_cost_.assign(n, std::numeric_limits<double>::infinity());
+    roadmap->cost_.assign(n, 0.0);
+    roadmap->heuristic_.assign(n, 0.0);
+    roadmap->parent_.assign(n, -1);
+    roadmap->parent_edge_.assign(n, 0);
+    roadmap->visited_.assign(n, 0);
+    roadmap->closed_.assign(n, 0);
+    roadmap->open_.reserve(roadmap->offsets_[n] + 1);
+    return roadmap;
+  }
+
+  Roadmap::~Roadmap()
+  {
+    if (mapping_ != nullptr)
+    {
+      munmap(mapping_, mapping_size_);
+    }
+  }
+
+  JointVector Roadmap::node(std::size_t index) const
+  {
+    return Eigen::Map<const JointVector>(nodes_ + index * NUM_JOINTS);
+  }
+
+  std::size_t Roadmap::update_obstacles(const std::vector<Box> &obstacles)
+  {
+    std::vector<Box> changed;
+    for (const Box &box : obstacles)
+    {
+      if (std::none_of(obstacles_.begin(), obstacles_.end(), [&box](const Box &other)
+                       { return same_box(box, other); }))
+      {
+        changed.push_back(box);
+      }
+    }
+    for (const Box &box : obstacles_)
+    {
+      if (std::none_of(obstacles.begin(), obstacles.end(), [&box](const Box &other)
+                       { return same_box(box, other); }))
+      {
+        changed.push_back(box);
+      }
+    }
+    obstacles_ = obstacles;
+
+    const auto touches = [&changed](const Bounds &bounds)
+    {
+      return std::any_of(changed.begin(), changed.end(), [&bounds](const Box &box)
+                         { return bounds.overlaps(box); });
+    };
+
+    std::size_t affected = 0;
+    for (std::size_t i = 0; i < num_nodes_ && !changed.empty(); i++)
+    {
+      if (touches(node_bounds_[i]))
+      {
+        node_state_[i] = UNKNOWN;
+      }
+    }
+    for (std::size_t e = 0; e < num_edges_ && !changed.empty(); e++)
+    {
+      if (touches(edge_bounds_[e]))
+      {
+        edge_state_[e] = UNKNOWN;
+        affected++;
+      }
+    }
+    return affected;
+  }
+
+  bool Roadmap::node_valid(const CollisionModel &collision, std::size_t index)
+  {
+    if (node_state_[index] == UNKNOWN)
+    {
+      node_state_[index] = collision.is_valid(node(index)) ? VALID : INVALID;
+    }
+    return node_state_[index] == VALID;
+  }
+
+  bool Roadmap::connect(const CollisionModel &collision, const JointVector &q, std::size_t k,
+                        std::vector<std::pair<double, std::size_t>> &out)
+  {
+    // connection edges are only checked once a path actually uses them
+    nn_.nearest_k(q, k, candidates_);
+    out.clear();
+    for (const auto &[d, index] : candidates_)
+    {
+      if (node_valid(collision, index))
+      {
+        out.emplace_back(d, index);
+      }
+    }
+    return !out.empty();
+  }
+
+  void Roadmap::drop_link(std::vector<std::pair<double, std::size_t>> &links, std::size_t index)
+  {
+    links.erase(std::remove_if(links.begin(), links.end(), [index](const auto &link)
+                               { return link.second == index; }),
+                links.end());
+  }
+
+  bool Roadmap::astar(std::size_t &last_node)
+  {
+    const auto goal_marker = static_cast<std::uint32_t>(num_nodes_);
+    // computed once per node and query, on its first visit
+    const auto heuristic = [this](std::size_t index)
+    {
+      heuristic_[index] = space_.distance(Eigen::Map<const JointVector>(nodes_ + index * NUM_JOINTS), goal_);
+      return heuristic_[index];
+    };
+
+    generation_++;
+    open_.clear();
+    const auto push = [this](double f, std::uint32_t index)
+    {
+      open_.emplace_back(f, index);
+      std::push_heap(open_.begin(), open_.end(), std::greater<>());
+    };
+
+    for (const auto &[d, index] : start_links_)
+    {
+      visited_[index] = generation_;
+      cost_[index] = d;
+      parent_[index] = -1;
+      push(d + heuristic(index), static_cast<std::uint32_t>(index));
+    }
+
+    double best_goal_cost = std::numeric_limits<double>::infinity();
+    while (!open_.empty())
+    {
+      std::pop_heap(open_.begin(), open_.end(), std::greater<>());
+      const auto [f, n] = open_.back();
+      open_.pop_back();
+
+      if (n == goal_marker)
+      {
+        return true;
+      }
+      if (closed_[n] == generation_)
+      {
+        continue;
+      }
+      closed_[n] = generation_;
+
+      if (goal_cost_[n] < std::numeric_limits<double>::infinity())
+      {
+        const double total = cost_[n] + goal_cost_[n];
+        if (total < best_goal_cost)
+        {
+          best_goal_cost = total;
+          last_node = n;
+          push(total, goal_marker);
+        }
+      }
+
+      for (std::uint64_t j = offsets_[n]; j < offsets_[n + 1]; j++)
+      {
+        const std::uint32_t m = targets_[j];
+        const std::uint32_t edge = edge_ids_[j];
+        if (edge_state_[edge] == INVALID || node_state_[m] == INVALID || closed_[m] == generation_)
+        {
+          continue;
+        }
+        const double g = cost_[n] + weights_[j];
+        if (visited_[m] != generation_)
+        {
+          visited_[m] = generation_;
+          cost_[m] = g;
+          parent_[m] = n;
+          parent_edge_[m] = edge;
+          push(g + heuristic(m), m);
+        }
+        else if (g < cost_[m])
+        {
+          cost_[m] = g;
+          parent_[m] = n;
+          parent_edge_[m] = edge;
+          push(g + heuristic_[m], m);
+        }
+      }
+    }
+    return false;
+  }
+
+  PlanResult Roadmap::query(const CollisionModel &collision, const JointVector &start, const JointVector &goal,
+                            const QueryParams &params)
+  {
+    const auto t0 = Clock::now();
+    PlanResult result;
+    const auto finish = [&]()
+    {
+      for (const auto &[d, index] : goal_links_)
+      {
+        goal_cost_[index] = std::numeric_limits<double>::infinity();
+      }
+      goal_links_.clear();
+      result.planning_time = std::chrono::duration<double>(Clock::now() - t0).count();
+      return result;
+    };
+
+    if (!collision.is_valid(start) || !collision.is_valid(goal))
+    {
+      result.message = "Start or goal state is in collision.";
+      return finish();
+    }
+
+    if (!connect(collision, start, params.k_connect, start_links_))
+    {
+      result.message = "Could not connect the start state to the roadmap.";
+      return finish();
+    }
+    if (!connect(collision, goal, params.k_connect, goal_links_))
+    {
+      result.message = "Could not connect the goal state to the roadmap.";
+      return finish();
+    }
+    goal_ = goal;
+    for (const auto &[d, index] : goal_links_)
+    {
+      goal_cost_[index] = d;
+    }
+
+    std::vector<std::size_t> nodes;
+    for (; result.iterations < params.max_lazy_iterations; result.iterations++)
+    {
+      std::size_t last = 0;
+      if (!astar(last))
+      {
+        result.message = "Start and goal are not connected in the roadmap.";
+        return finish();
+      }
+
+      nodes.clear();
+      for (auto i = static_cast<std::int64_t>(last); i >= 0; i = parent_[i])
+      {
+        nodes.push_back(static_cast<std::size_t>(i));
+      }
+      std::reverse(nodes.begin(), nodes.end());
+
+      // check the connections into the roadmap, then resolve everything the
+      // obstacle update left unknown along this path
+      result.edge_checks++;
+      if (!collision.is_motion_valid(space_, start, node(nodes.front())))
+      {
+        drop_link(start_links_, nodes.front());
+        continue;
+      }
+      result.edge_checks++;
+      if (!collision.is_motion_valid(space_, node(nodes.back()), goal))
+      {
+        goal_cost_[nodes.back()] = std::numeric_limits<double>::infinity();
+        drop_link(goal_links_, nodes.back());
+        continue;
+      }
+
+      bool valid = true;
+      for (std::size_t k = 0; k < nodes.size() && valid; k++)
+      {
+        valid = node_valid(collision, nodes[k]);
+        if (valid && k > 0)
+        {
+          std::uint8_t &state = edge_state_[parent_edge_[nodes[k]]];
+          if (state == UNKNOWN)
+          {
+            result.edge_checks++;
+            state = collision.is_motion_valid(space_, node(nodes[k - 1]), node(nodes[k])) ? VALID : INVALID;
+          }
+          valid = state == VALID;
+        }
+      }
+      if (!valid)
+      {
+        continue;
+      }
+
+      result.path.reserve(nodes.size() + 2);
+      result.path.push_back(start);
+      for (std::size_t index : nodes)
+      {
+        result.path.push_back(node(index));
+      }
+      result.path.push_back(goal);
+      result.success = true;
+      return finish();
+    }
+
+    result.message = "Too many invalidated roadmap paths.";
+    return finish();
+  }
+
+} // namespace robot_planning
@@ -0,0 +1,99 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+
+#include "robot_planning/roadmap.hpp"
+#include "parameters.hpp"
+
+// Offline roadmap construction for the environment in the planning parameters:
+//   ros2 run robot_planning roadmap_builder --ros-args \
+//     --params-file robot_planning.yaml -p roadmap_file:=/path/to/cell.roadmap \
+//     -p robot_description:="$(xacro robot.urdf)"
+int main(int argc, char **argv)
+{
+  using namespace robot_planning;
+
+  rclcpp::init(argc, argv);
+  auto node = std::make_shared<rclcpp::Node>("roadmap_builder");
+
+  std::unique_ptr<StateSpace> space;
+  try
+  {
+    space = std::make_unique<StateSpace>(declare_joint_limits(*node, joint_names()));
+  }
+  catch (const std::exception &e)
+  {
+    RCLCPP_ERROR(node->get_logger(), "%s", e.what());
+    rclcpp::shutdown();
+    return 1;
+  }
+
+  CollisionModel collision(declare_collision_params(*node));
+  std::vector<Box> boxes;
+  if (!boxes_from_parameter(node->declare_parameter("obstacles", std::vector<double>{}), boxes))
+  {
+    RCLCPP_ERROR(node->get_logger(), "obstacles must hold 6 values per box.");
+    rclcpp::shutdown();
+    return 1;
+  }
+  collision.set_obstacles(boxes);
+
+  const std::string path = node->declare_parameter("roadmap_file", std::string(""));
+  RoadmapBuildParams params;
+  params.num_nodes = static_cast<std::size_t>(node->declare_parameter("roadmap_nodes", static_cast<int>(params.num_nodes)));
+  params.k_neighbors = static_cast<std::size_t>(node->declare_parameter("roadmap_k_neighbors", static_cast<int>(params.k_neighbors)));
+  params.seed = static_cast<std::uint64_t>(node->declare_parameter("roadmap_seed", 0));
+  const int num_threads = node->declare_parameter("num_threads", 0);
+  if (num_threads > 0)
+  {
+    params.num_threads = static_cast<std::size_t>(num_threads);
+  }
+
+  if (path.empty())
+  {
+    RCLCPP_ERROR(node->get_logger(), "Set roadmap_file to the output path.");
+    rclcpp::shutdown();
+    return 1;
+  }
+
+  RCLCPP_INFO(node->get_logger(), "Building roadmap with %zu nodes on %zu threads for %zu obstacles...",
+              params.num_nodes, params.num_threads, boxes.size());
+  const auto t0 = Clock::now();
+  const RoadmapData data = build_roadmap(*space, collision, params);
+
+  std::string error;
+  if (!save_roadmap(path, data, collision.params(), error))
+  {
+    RCLCPP_ERROR(node->get_logger(), "%s", error.c_str());
+    rclcpp::shutdown();
+    return 1;
+  }
+  RCLCPP_INFO(node->get_logger(), "Wrote %zu nodes and %zu edges to %s in %.1f s.",
+              data.nodes.size(), data.edge_bounds.size(), path.c_str(),
+              std::chrono::duration<double>(Clock::now() - t0).count());
+
+  rclcpp::shutdown();
+  return 0;
+}
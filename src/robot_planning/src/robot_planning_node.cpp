@@ -0,0 +1,311 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/u_int64.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+#include "robot_motion_interfaces/srv/plan_joint_path.hpp"
+
+#include "robot_planning/collision_model.hpp"
+#include "robot_planning/path_simplifier.hpp"
+#include "robot_planning/roadmap.hpp"
+#include "robot_planning/rrt_connect.hpp"
+#include "robot_planning/trajectory_optimizer.hpp"
+#include "parameters.hpp"
+
+namespace robot_planning
+{
+  using PlanJointPath = robot_motion_interfaces::srv::PlanJointPath;
+
+  class PlanningNode : public rclcpp::Node
+  {
+  public:
+    PlanningNode()
+        : Node("robot_planning_node"),
+          joint_names_(joint_names()),
+          space_(declare_joint_limits(*this, joint_names_))
+    {
+      collision_ = CollisionModel(declare_collision_params(*this));
+
+      rrt_params_.max_step = declare_parameter("max_step", rrt_params_.max_step);
+      rrt_params_.max_iterations = static_cast<std::size_t>(
+          declare_parameter("max_iterations", static_cast<int>(rrt_params_.max_iterations)));
+      default_planning_time_ = declare_parameter("default_planning_time", 0.05);
+      simplify_ = declare_parameter("simplify", true);
+      simplify_time_ = declare_parameter("simplify_time", 0.02);
+      const int num_threads = declare_parameter("num_threads", 0);
+      if (num_threads > 0)
+      {
+        simplifier_params_.num_threads = static_cast<std::size_t>(num_threads);
+      }
+
+      optimize_ = declare_parameter("optimize", true);
+      optimize_time_ = declare_parameter("optimize_time", 0.03);
+      TrajectoryOptimizer::Params optimizer_params;
+      optimizer_params.num_waypoints = static_cast<std::size_t>(
+          declare_parameter("optimizer_waypoints", static_cast<int>(optimizer_params.num_waypoints)));
+      optimizer_params.clearance = declare_parameter("optimizer_clearance", optimizer_params.clearance);
+      optimizer_params.max_velocity = declare_parameter("max_velocity", optimizer_params.max_velocity);
+      optimizer_params.max_acceleration = declare_parameter("max_acceleration", optimizer_params.max_acceleration);
+      if (num_threads > 0)
+      {
+        optimizer_params.field.num_threads = static_cast<std::size_t>(num_threads);
+      }
+      optimizer_ = std::make_unique<TrajectoryOptimizer>(space_, collision_, optimizer_params);
+
+      const std::string roadmap_file = declare_parameter("roadmap_file", std::string(""));
+      roadmap_params_.k_connect = static_cast<std::size_t>(
+          declare_parameter("roadmap_k_connect", static_cast<int>(roadmap_params_.k_connect)));
+      if (!roadmap_file.empty())
+      {
+        std::string error;
+        roadmap_ = Roadmap::open(roadmap_file, space_, collision_.params(), error);
+        if (roadmap_)
+        {
+          RCLCPP_INFO(get_logger(), "Loaded roadmap %s with %zu nodes and %zu edges.",
+                      roadmap_file.c_str(), roadmap_->num_nodes(), roadmap_->num_edges());
+        }
+        else
+        {
+          RCLCPP_WARN(get_logger(), "Roadmap not used: %s", error.c_str());
+        }
+      }
+
+      // the environment hash, latched so clients that key cached plans on it always
+      // see the current one
+      environment_pub_ = create_publisher<std_msgs::msg::UInt64>(
+          "/robot_planning/environment_version", rclcpp::QoS(1).transient_local());
+      set_obstacles(declare_parameter("obstacles", std::vector<double>{}));
+      parameter_callback_ = add_on_set_parameters_callback(
+          [this](const std::vector<rclcpp::Parameter> &parameters)
+          {
+            rcl_interfaces::msg::SetParametersResult result;
+            result.successful = true;
+            for (const auto &parameter : parameters)
+            {
+              if (parameter.get_name() == "obstacles")
+              {
+                result.successful = set_obstacles(parameter.as_double_array());
+                result.reason = result.successful ? "" : "obstacles must hold 6 values per box";
+              }
+            }
+            return result;
+          });
+
+      plan_service_ = create_service<PlanJointPath>(
+          "/robot_planning/plan_joint_path",
+          [this](const std::shared_ptr<PlanJointPath::Request> request, std::shared_ptr<PlanJointPath::Response> response)
+          { plan_callback(*request, *response); });
+
+      RCLCPP_INFO(get_logger(), "Robot planning node ready.");
+    }
+
+  private:
+    bool set_obstacles(const std::vector<double> &values)
+    {
+      std::vector<Box> boxes;
+      if (!boxes_from_parameter(values, boxes))
+      {
+        RCLCPP_WARN(get_logger(), "Ignoring obstacles, expected 6 values per box but got %zu.", values.size());
+        return false;
+      }
+      collision_.set_obstacles(boxes);
+      RCLCPP_INFO(get_logger(), "Loaded %zu obstacles (environment hash %016lx).",
+                  boxes.size(), static_cast<unsigned long>(collision_.environment_hash()));
+      if (roadmap_)
+      {
+        const std::size_t affected = roadmap_->update_obstacles(boxes);
+        RCLCPP_INFO(get_logger(), "%zu roadmap edges marked for re-validation.", affected);
+      }
+      std_msgs::msg::UInt64 version;
+      version.data = collision_.environment_hash();
+      environment_pub_->publish(version);
+      return true;
+    }
+
+    static bool to_joint_vector(const std::vector<double> &values, JointVector &q)
+    {
+      if (values.size() != NUM_JOINTS)
+      {
+        return false;
+      }
+      for (std::size_t i = 0; i < NUM_JOINTS; i++)
+      {
+        q[i] = values[i];
+      }
+      return true;
+    }
+
+    // roadmap query with RRT-Connect fallback, followed by shortcutting
+    PlanResult sample_path(const JointVector &start, const JointVector &goal, double timeout)
+    {
+      rrt_params_.seed++;
+
+      // repeated cell motions are answered from the roadmap, anything it cannot
+      // connect falls through to a fresh RRT-Connect search
+      PlanResult result;
+      if (roadmap_)
+      {
+        result = roadmap_->query(collision_, start, goal, roadmap_params_);
+        if (!result.success)
+        {
+          RCLCPP_DEBUG(get_logger(), "Roadmap query failed: %s", result.message.c_str());
+        }
+      }
+      if (!result.success)
+      {
+        RRTConnect planner(space_, collision_, rrt_params_);
+        const double roadmap_time = result.planning_time;
+        result = planner.plan(start, goal, std::max(0.0, timeout - roadmap_time));
+        result.planning_time += roadmap_time;
+      }
+
+      if (result.success && simplify_)
+      {
+        simplifier_params_.seed = rrt_params_.seed;
+        PathSimplifier simplifier(space_, collision_, simplifier_params_);
+        const auto t0 = Clock::now();
+        result.path = simplifier.simplify(result.path, simplify_time_);
+        result.planning_time += std::chrono::duration<double>(Clock::now() - t0).count();
+      }
+      return result;
+    }
+
+    void plan_callback(const PlanJointPath::Request &request, PlanJointPath::Response &response)
+    {
+      response.environment_version = collision_.environment_hash();
+
+      JointVector start, goal;
+      if (!to_joint_vector(request.start, start) || !to_joint_vector(request.goal, goal))
+      {
+        response.success = false;
+        response.message = "Start and goal need " + std::to_string(NUM_JOINTS) + " joint positions.";
+        return;
+      }
+
+      const double timeout = request.max_planning_time > 0.0 ? request.max_planning_time : default_planning_time_;
+
+      // the optimiser gets the first shot from the straight line or the last solution
+      // for this task, it only fails when it cannot get out of a collision
+      PlanResult result;
+      if (optimize_)
+      {
+        Path seed{start, goal};
+        optimizer_->warm_start(start, goal, seed);
+        result = optimizer_->optimize(seed, optimize_time_);
+        if (!result.success)
+        {
+          RCLCPP_DEBUG(get_logger(), "Optimisation from %zu waypoint seed failed: %s", seed.size(), result.message.c_str());
+        }
+      }
+      if (!result.success)
+      {
+        const double optimize_time = result.planning_time;
+        result = sample_path(start, goal, std::max(0.0, timeout - optimize_time));
+        result.planning_time += optimize_time;
+        if (result.success && optimize_)
+        {
+          // refine the sampled path, keep it as is if the optimum is not valid
+          PlanResult optimized = optimizer_->optimize(result.path, optimize_time_);
+          optimized.planning_time += result.planning_time;
+          optimized.iterations += result.iterations;
+          optimized.edge_checks += result.edge_checks;
+          if (optimized.success)
+          {
+            result = std::move(optimized);
+          }
+          else
+          {
+            result.planning_time = optimized.planning_time;
+          }
+        }
+      }
+
+      response.success = result.success;
+      response.message = result.message;
+      response.planning_time = result.planning_time;
+      response.path.header.stamp = now();
+      response.path.joint_names = joint_names_;
+      for (std::size_t i = 0; i < result.path.size(); i++)
+      {
+        trajectory_msgs::msg::JointTrajectoryPoint point;
+        point.positions.assign(result.path[i].data(), result.path[i].data() + NUM_JOINTS);
+        if (i < result.time_from_start.size())
+        {
+          point.time_from_start = rclcpp::Duration::from_seconds(result.time_from_start[i]);
+        }
+        response.path.points.push_back(std::move(point));
+      }
+
+      if (result.success)
+      {
+        RCLCPP_INFO(get_logger(), "Planned path with %zu waypoints in %.2f ms (%zu iterations, %zu edge checks).",
+                    result.path.size(), result.planning_time * 1e3, result.iterations, result.edge_checks);
+      }
+      else
+      {
+        RCLCPP_WARN(get_logger(), "Planning failed: %s", result.message.c_str());
+      }
+    }
+
+    std::vector<std::string> joint_names_;
+    StateSpace space_;
+    CollisionModel collision_;
+    RRTConnect::Params rrt_params_;
+    std::unique_ptr<Roadmap> roadmap_;
+    Roadmap::QueryParams roadmap_params_;
+    PathSimplifier::Params simplifier_params_;
+    std::unique_ptr<TrajectoryOptimizer> optimizer_;
+    double default_planning_time_;
+    bool simplify_;
+    double simplify_time_;
+    bool optimize_;
+    double optimize_time_;
+
+    rclcpp::Service<PlanJointPath>::SharedPtr plan_service_;
+    rclcpp::Publisher<std_msgs::msg::UInt64>::SharedPtr environment_pub_;
+    rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr parameter_callback_;
+  };
+
+} // namespace robot_planning
+
+int main(int argc, char **argv)
+{
+  rclcpp::init(argc, argv);
+  std::shared_ptr<robot_planning::PlanningNode> node;
+  try
+  {
+    node = std::make_shared<robot_planning::PlanningNode>();
+  }
+  catch (const std::exception &e)
+  {
+    RCLCPP_FATAL(rclcpp::get_logger("robot_planning_node"), "%s", e.what());
+    rclcpp::shutdown();
+    return 1;
+  }
+  rclcpp::spin(node);
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,202 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_planning/rrt_connect.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace robot_planning
+{
+  void RRTConnect::Tree::reset(const JointVector &root)
+  {
+    vertices.clear();
+    nn.clear();
+    add(root, -1);
+    vertices.front().edge_checked = true;
+  }
+
+  std::size_t RRTConnect::Tree::add(const JointVector &q, std::int32_t parent)
+  {
+    vertices.push_back({q, parent, false, true});
+    return nn.insert(q);
+  }
+
+  RRTConnect::RRTConnect(const StateSpace &space, const CollisionModel &collision, const Params &params)
+      : space_(space),
+        collision_(collision),
+        params_(params),
+        rng_(params.seed),
+        start_tree_(space.limits().wraps),
+        goal_tree_(space.limits().wraps)
+  {
+  }
+
+  PlanResult RRTConnect::plan(const JointVector &start, const JointVector &goal, double timeout)
+  {
+    const auto t0 = Clock::now();
+    const auto elapsed = [&t0]()
+    { return std::chrono::duration<double>(Clock::now() - t0).count(); };
+
+    PlanResult result;
+    if (!space_.satisfies_bounds(start) || !collision_.is_valid(start))
+    {
+      result.message = "Start state is in collision or out of bounds.";
+      return result;
+    }
+    if (!space_.satisfies_bounds(goal) || !collision_.is_valid(goal))
+    {
+      result.message = "Goal state is in collision or out of bounds.";
+      return result;
+    }
+
+    // most cell motions are free, try the straight line before growing trees
+    result.edge_checks++;
+    if (collision_.is_motion_valid(space_, start, goal))
+    {
+      result.success = true;
+      result.path = {start, goal};
+      result.planning_time = elapsed();
+      return result;
+    }
+
+    start_tree_.reset(start);
+    goal_tree_.reset(goal);
+    Tree *a = &start_tree_;
+    Tree *b = &goal_tree_;
+
+    for (; result.iterations < params_.max_iterations; result.iterations++)
+    {
+      if (elapsed() > timeout)
+      {
+        result.message = "Planning timed out.";
+        break;
+      }
+
+      const JointVector q_rand = space_.sample(rng_);
+      std::size_t a_new = 0;
+      if (extend(*a, q_rand, a_new) != Status::TRAPPED)
+      {
+        std::size_t b_new = 0;
+        if (connect(*b, a->vertices[a_new].q, b_new) == Status::REACHED &&
+            validate_branch(*a, a_new, result.edge_checks) &&
+            validate_branch(*b, b_new, result.edge_checks))
+        {
+          const bool a_is_start = a == &start_tree_;
+          Path head, tail;
+          trace(start_tree_, a_is_start ? a_new : b_new, head);
+          trace(goal_tree_, a_is_start ? b_new : a_new, tail);
+          std::reverse(head.begin(), head.end());
+          head.insert(head.end(), tail.begin() + 1, tail.end());
+
+          result.success = true;
+          result.message.clear();
+          result.path = std::move(head);
+          break;
+        }
+      }
+      std::swap(a, b);
+    }
+
+    if (!result.success && result.message.empty())
+    {
+      result.message = "Iteration limit reached.";
+    }
+    result.planning_time = elapsed();
+    return result;
+  }
+
+  RRTConnect::Status RRTConnect::extend(Tree &tree, const JointVector &target, std::size_t &new_index)
+  {
+    const std::int64_t nearest = tree.nn.nearest(target);
+    if (nearest < 0)
+    {
+      return Status::TRAPPED;
+    }
+
+    const JointVector &q_near = tree.vertices[nearest].q;
+    const double d = space_.distance(q_near, target);
+    const bool reached = d <= params_.max_step;
+    const JointVector q_new = reached ? target : space_.interpolate(q_near, target, params_.max_step / d);
+
+    if (!collision_.is_valid(q_new))
+    {
+      return Status::TRAPPED;
+    }
+    new_index = tree.add(q_new, static_cast<std::int32_t>(nearest));
+    return reached ? Status::REACHED : Status::ADVANCED;
+  }
+
+  RRTConnect::Status RRTConnect::connect(Tree &tree, const JointVector &target, std::size_t &new_index)
+  {
+    Status status;
+    do
+    {
+      status = extend(tree, target, new_index);
+    } while (status == Status::ADVANCED);
+    return status;
+  }
+
+  bool RRTConnect::validate_branch(Tree &tree, std::size_t index, std::size_t &edge_checks)
+  {
+    for (auto i = static_cast<std::int32_t>(index); tree.vertices[i].parent >= 0; i = tree.vertices[i].parent)
+    {
+      Vertex &vertex = tree.vertices[i];
+      if (vertex.edge_checked)
+      {
+        continue;
+      }
+      edge_checks++;
+      if (!collision_.is_motion_valid(space_, tree.vertices[vertex.parent].q, vertex.q))
+      {
+        invalidate_subtree(tree, static_cast<std::size_t>(i));
+        return false;
+      }
+      vertex.edge_checked = true;
+    }
+    return true;
+  }
+
+  void RRTConnect::invalidate_subtree(Tree &tree, std::size_t index)
+  {
+    // children are always appended after their parent
+    tree.vertices[index].valid = false;
+    tree.nn.deactivate(index);
+    for (std::size_t j = index + 1; j < tree.vertices.size(); j++)
+    {
+      Vertex &vertex = tree.vertices[j];
+      if (vertex.valid && !tree.vertices[vertex.parent].valid)
+      {
+        vertex.valid = false;
+        tree.nn.deactivate(j);
+      }
+    }
+  }
+
+  void RRTConnect::trace(const Tree &tree, std::size_t index, Path &out)
+  {
+    out.clear();
+    for (auto i = static_cast<std::int32_t>(index); i >= 0; i = tree.vertices[i].parent)
+    {
+      out.push_back(tree.vertices[i].q);
+    }
+  }
+
+} // namespace robot_planning
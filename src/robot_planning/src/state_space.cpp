@@ -0,0 +1,85 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_planning/state_space.hpp"
+
+#include <cmath>
+
+namespace robot_planning
+{
+  StateSpace::StateSpace(const JointLimits &limits)
+      : limits_(limits)
+  {
+  }
+
+  JointVector StateSpace::difference(const JointVector &a, const JointVector &b) const
+  {
+    JointVector d = b - a;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      if (limits_.wraps[i])
+      {
+        d[i] = normalize_angle(d[i]);
+      }
+    }
+    return d;
+  }
+
+  double StateSpace::distance(const JointVector &a, const JointVector &b) const
+  {
+    return difference(a, b).norm();
+  }
+
+  double StateSpace::max_joint_distance(const JointVector &a, const JointVector &b) const
+  {
+    return difference(a, b).cwiseAbs().maxCoeff();
+  }
+
+  JointVector StateSpace::interpolate(const JointVector &a, const JointVector &b, double t) const
+  {
+    JointVector q = a + t * difference(a, b);
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      if (limits_.wraps[i])
+      {
+        q[i] = normalize_angle(q[i]);
+      }
+    }
+    return q;
+  }
+
+  JointVector StateSpace::sample(std::mt19937_64 &rng) const
+  {
+    JointVector q;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      if (limits_.wraps[i])
+      {
+        q[i] = std::uniform_real_distribution<double>(-M_PI, M_PI)(rng);
+      }
+      else
+      {
+        q[i] = std::uniform_real_distribution<double>(limits_.lower[i], limits_.upper[i])(rng);
+      }
+    }
+    return q;
+  }
+
+} // namespace robot_planning
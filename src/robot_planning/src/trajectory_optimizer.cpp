@@ -0,0 +1,376 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "robot_planning/trajectory_optimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace robot_planning
+{
+  namespace
+  {
+    // capsules that move with the arm and the link they are rigidly attached to,
+    // the base column only spins in place and is left out
+    constexpr std::pair<std::size_t, std::size_t> BODY_CAPSULES[] = {{1, 2}, {2, 4}, {3, 6}, {4, 6}};
+
+    // number of padding copies of start and goal, pins velocity to zero at both ends
+    constexpr std::size_t PADDING = 2;
+
+    // CHOMP obstacle potential over the signed clearance d with a band of width eps
+    double hinge_cost(double d, double eps, double &slope)
+    {
+      if (d < 0.0)
+      {
+        slope = -1.0;
+        return -d + 0.5 * eps;
+      }
+      if (d < eps)
+      {
+        slope = (d - eps) / eps;
+        return 0.5 * (d - eps) * (d - eps) / eps;
+      }
+      slope = 0.0;
+      return 0.0;
+    }
+
+    // finite difference operator over all M waypoints, rows hold the stencil at each interior index
+    Eigen::SparseMatrix<double> difference_operator(std::size_t points, bool second_order)
+    {
+      std::vector<Eigen::Triplet<double>> triplets;
+      const std::size_t rows = second_order ? points - 2 : points - 1;
+      for (std::size_t r = 0; r < rows; r++)
+      {
+        if (second_order)
+        {
+          triplets.emplace_back(r, r, 1.0);
+          triplets.emplace_back(r, r + 1, -2.0);
+          triplets.emplace_back(r, r + 2, 1.0);
+        }
+        else
+        {
+          triplets.emplace_back(r, r, -1.0);
+          triplets.emplace_back(r, r + 1, 1.0);
+        }
+      }
+      Eigen::SparseMatrix<double> K(rows, points);
+      K.setFromTriplets(triplets.begin(), triplets.end());
+      return K;
+    }
+  } // namespace
+
+  TrajectoryOptimizer::TrajectoryOptimizer(const StateSpace &space, const CollisionModel &collision, const Params &params)
+      : space_(space),
+        collision_(collision),
+        params_(params),
+        field_(params.field)
+  {
+    const std::size_t n = params_.num_waypoints;
+    const std::size_t points = n + 2 * PADDING;
+    Ka_ = difference_operator(points, true);
+    Kv_ = difference_operator(points, false);
+
+    const Eigen::SparseMatrix<double> Ka_free = Ka_.middleCols(PADDING, n);
+    const Eigen::SparseMatrix<double> Kv_free = Kv_.middleCols(PADDING, n);
+    A_ = params_.acceleration_weight * Eigen::SparseMatrix<double>(Ka_free.transpose() * Ka_free) +
+         params_.velocity_weight * Eigen::SparseMatrix<double>(Kv_free.transpose() * Kv_free);
+    solver_.compute(A_);
+
+    // dense inverse for the joint limit projection, which needs single columns of it
+    A_inv_ = solver_.solve(Eigen::MatrixXd::Identity(n, n));
+  }
+
+  TrajectoryOptimizer::Key TrajectoryOptimizer::make_key(const JointVector &start, const JointVector &goal) const
+  {
+    Key key;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      key[i] = std::llround(start[i] / params_.warm_start_resolution);
+      key[NUM_JOINTS + i] = std::llround(goal[i] / params_.warm_start_resolution);
+    }
+    return key;
+  }
+
+  bool TrajectoryOptimizer::warm_start(const JointVector &start, const JointVector &goal, Path &seed)
+  {
+    const auto it = warm_starts_.find(make_key(start, goal));
+    if (it == warm_starts_.end())
+    {
+      return false;
+    }
+    it->second.stamp = ++stamp_;
+    seed = it->second.path;
+    seed.front() = start;
+    seed.back() = goal;
+    return true;
+  }
+
+  void TrajectoryOptimizer::update_field()
+  {
+    if (has_field_ && field_hash_ == collision_.environment_hash())
+    {
+      return;
+    }
+    const CollisionModel::Params &params = collision_.params();
+    field_.build(collision_.obstacles(), params.check_ground, params.ground_height);
+    field_hash_ = collision_.environment_hash();
+    has_field_ = true;
+  }
+
+  double TrajectoryOptimizer::obstacle_cost(const JointVector &q, JointVector &gradient) const
+  {
+    LinkFrames frames;
+    RobotCapsules caps;
+    link_frames(q, frames);
+    collision_.capsules(frames, caps);
+
+    const double margin = collision_.params().safety_margin;
+    double cost = 0.0;
+    gradient.setZero();
+    for (const auto &[c, link] : BODY_CAPSULES)
+    {
+      const Capsule &cap = caps[c];
+      const int samples = std::max(1, static_cast<int>(std::ceil((cap.b - cap.a).norm() / cap.radius)));
+      for (int s = 0; s <= samples; s++)
+      {
+        const Eigen::Vector3d x = cap.a + (cap.b - cap.a) * (static_cast<double>(s) / samples);
+        Eigen::Vector3d normal;
+        const double d = field_.distance(x, normal) - cap.radius - margin;
+        double slope;
+        cost += hinge_cost(d, params_.clearance, slope);
+        if (slope != 0.0)
+        {
+          gradient += slope * point_jacobian(frames, link, x).transpose() * normal;
+        }
+      }
+    }
+    return cost;
+  }
+
+  void TrajectoryOptimizer::project_limits(Waypoints &xi) const
+  {
+    const JointLimits &limits = space_.limits();
+    for (std::size_t j = 0; j < NUM_JOINTS; j++)
+    {
+      if (limits.wraps[j])
+      {
+        continue;
+      }
+      // remove the worst violation through the smoothness metric so the correction
+      // is spread over the neighbouring waypoints instead of leaving a kink
+      for (std::size_t pass = 0; pass < 10; pass++)
+      {
+        Eigen::Index worst = 0;
+        double violation = 0.0;
+        for (Eigen::Index k = 0; k < xi.rows(); k++)
+        {
+          const double v = xi(k, j) > limits.upper[j] ? xi(k, j) - limits.upper[j]
+                                                       : std::min(0.0, xi(k, j) - limits.lower[j]);
+          if (std::abs(v) > std::abs(violation))
+          {
+            violation = v;
+            worst = k;
+          }
+        }
+        if (violation == 0.0)
+        {
+          break;
+        }
+        xi.col(j) -= A_inv_.col(worst) * (1.01 * violation / A_inv_(worst, worst));
+      }
+      xi.col(j) = xi.col(j).cwiseMax(limits.lower[j]).cwiseMin(limits.upper[j]);
+    }
+  }
+
+  PlanResult TrajectoryOptimizer::optimize(const Path &seed, double timeout)
+  {
+    const auto t0 = Clock::now();
+    const auto elapsed = [&t0]()
+    { return std::chrono::duration<double>(Clock::now() - t0).count(); };
+
+    PlanResult result;
+    if (seed.size() < 2)
+    {
+      result.message = "Seed path needs a start and a goal.";
+      return result;
+    }
+    update_field();
+
+    // unwrap the seed so wrapping joints do not jump by 2 pi between waypoints
+    Path unwrapped(seed.size());
+    std::vector<double> arc(seed.size(), 0.0);
+    unwrapped[0] = seed[0];
+    for (std::size_t i = 1; i < seed.size(); i++)
+    {
+      const JointVector step = space_.difference(seed[i - 1], seed[i]);
+      unwrapped[i] = unwrapped[i - 1] + step;
+      arc[i] = arc[i - 1] + step.norm();
+    }
+
+    // resample by arc length onto the padded waypoint matrix
+    const std::size_t n = params_.num_waypoints;
+    const std::size_t points = n + 2 * PADDING;
+    Waypoints Q(points, NUM_JOINTS);
+    for (std::size_t p = 0; p < PADDING; p++)
+    {
+      Q.row(p) = unwrapped.front().transpose();
+      Q.row(points - 1 - p) = unwrapped.back().transpose();
+    }
+    if (seed.size() == n + 2)
+    {
+      // warm starts already have the right layout, keep their timing
+      for (std::size_t k = 0; k < n; k++)
+      {
+        Q.row(PADDING + k) = unwrapped[k + 1].transpose();
+      }
+    }
+    else
+    {
+      std::size_t segment = 1;
+      for (std::size_t k = 0; k < n; k++)
+      {
+        const double s = arc.back() * static_cast<double>(k + 1) / static_cast<double>(n + 1);
+        while (segment < seed.size() - 1 && arc[segment] < s)
+        {
+          segment++;
+        }
+        const double length = arc[segment] - arc[segment - 1];
+        const double t = length > 1e-12 ? (s - arc[segment - 1]) / length : 0.0;
+        Q.row(PADDING + k) = (unwrapped[segment - 1] + t * (unwrapped[segment] - unwrapped[segment - 1])).transpose();
+      }
+    }
+
+    Waypoints xi = Q.middleRows(PADDING, n);
+    project_limits(xi);
+    Waypoints obstacle_gradient(n, NUM_JOINTS);
+    // the obstacle term chatters at the edge of the clearance band, so keep the best
+    // iterate and stop once it has not improved for a while
+    Waypoints best = xi;
+    double best_cost = std::numeric_limits<double>::infinity();
+    std::size_t stalled = 0;
+    result.message = "Iteration limit reached.";
+    for (; result.iterations < params_.max_iterations; result.iterations++)
+    {
+      if (elapsed() > timeout)
+      {
+        result.message = "Optimisation timed out.";
+        break;
+      }
+
+      Q.middleRows(PADDING, n) = xi;
+      double obstacle = 0.0;
+      for (std::size_t k = 0; k < n; k++)
+      {
+        JointVector gradient;
+        obstacle += obstacle_cost(xi.row(k).transpose(), gradient);
+        obstacle_gradient.row(k) = gradient.transpose();
+      }
+
+      const Eigen::MatrixXd Ra = Ka_ * Q;
+      const Eigen::MatrixXd Rv = Kv_ * Q;
+      const double cost = 0.5 * params_.acceleration_weight * Ra.squaredNorm() +
+                          0.5 * params_.velocity_weight * Rv.squaredNorm() +
+                          params_.obstacle_weight * obstacle;
+      if (cost < best_cost * (1.0 - params_.tolerance))
+      {
+        stalled = 0;
+      }
+      else if (++stalled >= params_.patience)
+      {
+        result.message.clear();
+        break;
+      }
+      if (cost < best_cost)
+      {
+        best_cost = cost;
+        best = xi;
+      }
+
+      const Eigen::MatrixXd smoothness_gradient =
+          (params_.acceleration_weight * (Ka_.transpose() * Ra) + params_.velocity_weight * (Kv_.transpose() * Rv))
+              .middleRows(PADDING, n);
+      Eigen::MatrixXd update = params_.step_size * solver_.solve(
+                                                      smoothness_gradient + params_.obstacle_weight * obstacle_gradient);
+      const double largest = update.cwiseAbs().maxCoeff();
+      if (largest > params_.max_update)
+      {
+        update *= params_.max_update / largest;
+      }
+      xi -= update;
+      project_limits(xi);
+    }
+    Q.middleRows(PADDING, n) = best;
+
+    // uniform time step that keeps central difference velocity and acceleration in limits
+    double velocity = 0.0, acceleration = 0.0;
+    for (std::size_t i = 1; i + 1 < points; i++)
+    {
+      velocity = std::max(velocity, 0.5 * (Q.row(i + 1) - Q.row(i - 1)).cwiseAbs().maxCoeff());
+      acceleration = std::max(acceleration, (Q.row(i + 1) - 2.0 * Q.row(i) + Q.row(i - 1)).cwiseAbs().maxCoeff());
+    }
+    const double dt = std::max({velocity / params_.max_velocity, std::sqrt(acceleration / params_.max_acceleration), 1e-3});
+
+    const JointLimits &limits = space_.limits();
+    result.path.clear();
+    for (std::size_t i = PADDING - 1; i <= points - PADDING; i++)
+    {
+      JointVector q = Q.row(i).transpose();
+      for (std::size_t j = 0; j < NUM_JOINTS; j++)
+      {
+        if (limits.wraps[j])
+        {
+          q[j] = normalize_angle(q[j]);
+        }
+      }
+      result.time_from_start.push_back(dt * static_cast<double>(result.path.size()));
+      result.path.push_back(q);
+    }
+    result.path.front() = seed.front();
+    result.path.back() = seed.back();
+
+    result.success = true;
+    for (std::size_t i = 1; i < result.path.size() && result.success; i++)
+    {
+      result.edge_checks++;
+      result.success = collision_.is_motion_valid(space_, result.path[i - 1], result.path[i]);
+    }
+    if (result.success)
+    {
+      result.message.clear();
+      warm_starts_[make_key(seed.front(), seed.back())] = {result.path, ++stamp_};
+      if (warm_starts_.size() > params_.warm_start_capacity)
+      {
+        warm_starts_.erase(std::min_element(warm_starts_.begin(), warm_starts_.end(),
+                                            [](const auto &a, const auto &b)
+                                            { return a.second.stamp < b.second.stamp; }));
+      }
+    }
+    else
+    {
+      result.message = "Optimised path is in collision.";
+    }
+    result.planning_time = elapsed();
+    return result;
+  }
+
+} // namespace robot_planning
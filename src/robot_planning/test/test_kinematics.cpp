@@ -0,0 +1,146 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "robot_planning/kinematics.hpp"
+
+namespace
+{
+  using robot_planning::IKSolutions;
+  using robot_planning::JointLimits;
+  using robot_planning::JointVector;
+  using robot_planning::NUM_JOINTS;
+
+  // FK of an IK solution lands within 1e-9 mm of the pose away from the wrist
+  // singularity; within IK_EPSILON of it q5 is taken as 0 and the error grows to a
+  // few nm (2.9e-6 mm over 100k samples). mm and rad
+  constexpr double POSITION_TOLERANCE = 1e-5;
+  constexpr double ROTATION_TOLERANCE = 1e-6;
+
+  // the ranges of robot_description/urdf/robot.urdf
+  JointLimits urdf_limits()
+  {
+    JointLimits limits;
+    limits.lower.setConstant(-M_PI);
+    limits.upper.setConstant(M_PI);
+    limits.lower[4] = -M_PI / 2;
+    limits.upper[4] = M_PI / 2;
+    return limits;
+  }
+
+  JointVector random_position(const JointLimits &limits, std::mt19937 &rng)
+  {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    JointVector q;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      q[i] = limits.lower[i] + unit(rng) * (limits.upper[i] - limits.lower[i]);
+    }
+    return q;
+  }
+
+  double joint_distance(const JointVector &a, const JointVector &b)
+  {
+    double distance = 0.0;
+    for (std::size_t i = 0; i < NUM_JOINTS; i++)
+    {
+      distance = std::max(distance, std::abs(robot_planning::normalize_angle(a[i] - b[i])));
+    }
+    return distance;
+  }
+
+  void expect_same_pose(const Eigen::Isometry3d &actual, const Eigen::Isometry3d &expected)
+  {
+    EXPECT_LT((actual.translation() - expected.translation()).norm(), POSITION_TOLERANCE);
+    EXPECT_LT((actual.linear() - expected.linear()).norm(), ROTATION_TOLERANCE);
+  }
+} // namespace
+
+TEST(Kinematics, InverseKinematicsRoundTrips)
+{
+  const JointLimits limits = urdf_limits();
+  std::mt19937 rng(7);
+  for (int n = 0; n < 10000; n++)
+  {
+    const JointVector q = random_position(limits, rng);
+    const Eigen::Isometry3d pose = robot_planning::forward_kinematics(q);
+    IKSolutions solutions;
+    const std::size_t count = robot_planning::inverse_kinematics(pose, limits, solutions);
+    ASSERT_GT(count, 0u);
+    bool found = false;
+    for (std::size_t k = 0; k < count; k++)
+    {
+      expect_same_pose(robot_planning::forward_kinematics(solutions[k].q), pose);
+      EXPECT_TRUE(limits.contains(solutions[k].q));
+      found = found || joint_distance(solutions[k].q, q) < 1e-6;
+    }
+    // at the wrist singularity only q4 + q6 is defined, elsewhere q is one of the branches
+    if (std::abs(std::sin(q[4])) > 1e-3)
+    {
+      EXPECT_TRUE(found) << "sample " << n;
+    }
+  }
+}
+
+TEST(Kinematics, WristSingularityKeepsThePose)
+{
+  JointVector q;
+  q << 0.4, 0.35, 0.3, -2.2, 0.0, -1.5;
+  const Eigen::Isometry3d pose = robot_planning::forward_kinematics(q);
+  IKSolutions solutions;
+  const std::size_t count = robot_planning::inverse_kinematics(pose, urdf_limits(), solutions);
+  ASSERT_GT(count, 0u);
+  for (std::size_t k = 0; k < count; k++)
+  {
+    expect_same_pose(robot_planning::forward_kinematics(solutions[k].q), pose);
+  }
+}
+
+TEST(Kinematics, UnreachablePoseHasNoSolution)
+{
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.translation() = Eigen::Vector3d(1000.0, 0.0, 200.0);
+  IKSolutions solutions;
+  EXPECT_EQ(robot_planning::inverse_kinematics(pose, urdf_limits(), solutions), 0u);
+}
+
+TEST(Kinematics, SolutionsOutsideTheLimitsAreDropped)
+{
+  JointVector q;
+  q << 0.3, -0.4, 0.9, 0.5, 0.7, -0.2;
+  const Eigen::Isometry3d pose = robot_planning::forward_kinematics(q);
+  IKSolutions all;
+  const std::size_t unrestricted = robot_planning::inverse_kinematics(pose, urdf_limits(), all);
+
+  JointLimits limits = urdf_limits();
+  limits.lower[4] = 0.0;
+  IKSolutions positive_wrist;
+  const std::size_t restricted = robot_planning::inverse_kinematics(pose, limits, positive_wrist);
+  EXPECT_LT(restricted, unrestricted);
+  ASSERT_GT(restricted, 0u);
+  for (std::size_t k = 0; k < restricted; k++)
+  {
+    EXPECT_GE(positive_wrist[k].q[4], 0.0);
+  }
+}
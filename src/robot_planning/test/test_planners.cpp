@@ -0,0 +1,199 @@
+// Copyright 2026 Andrin Winzap
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "robot_planning/path_simplifier.hpp"
+#include "robot_planning/roadmap.hpp"
+#include "robot_planning/rrt_connect.hpp"
+#include "robot_planning/trajectory_optimizer.hpp"
+
+namespace
+{
+  using robot_planning::Box;
+  using robot_planning::CollisionModel;
+  using robot_planning::JointLimits;
+  using robot_planning::JointVector;
+  using robot_planning::Path;
+  using robot_planning::StateSpace;
+
+  JointLimits urdf_limits()
+  {
+    JointLimits limits;
+    limits.lower.setConstant(-M_PI);
+    limits.upper.setConstant(M_PI);
+    limits.lower[4] = -M_PI / 2;
+    limits.upper[4] = M_PI / 2;
+    return limits;
+  }
+
+  // the wall of the example config in robot_planning.yaml, with the arm reaching
+  // out on either side of it so the straight joint space motion runs through it
+  class PlannerTest : public ::testing::Test
+  {
+  protected:
+    PlannerTest()
+        : space(urdf_limits())
+    {
+      collision.set_obstacles({Box{Eigen::Vector3d(150.0, -40.0, 0.0), Eigen::Vector3d(500.0, 40.0, 700.0)}});
+      start << -0.8, 0.6, 0.6, 0.0, 0.6, 0.0;
+      goal << 0.8, 0.6, 0.6, 0.0, 0.6, 0.0;
+    }
+
+    void expect_valid_path(const Path &path) const
+    {
+      ASSERT_GE(path.size(), 2u);
+      EXPECT_LT(space.max_joint_distance(path.front(), start), 1e-12);
+      EXPECT_LT(space.max_joint_distance(path.back(), goal), 1e-12);
+      for (std::size_t i = 1; i < path.size(); i++)
+      {
+        EXPECT_TRUE(collision.is_motion_valid(space, path[i - 1], path[i])) << "segment " << i;
+      }
+    }
+
+    StateSpace space;
+    CollisionModel collision;
+    JointVector start;
+    JointVector goal;
+  };
+} // namespace
+
+TEST_F(PlannerTest, SceneNeedsADetour)
+{
+  EXPECT_TRUE(collision.is_valid(start));
+  EXPECT_TRUE(collision.is_valid(goal));
+  EXPECT_FALSE(collision.is_motion_valid(space, start, goal));
+}
+
+// lazily checked edges still come out collision free, for any seed
+TEST_F(PlannerTest, RRTConnectFindsCollisionFreePath)
+{
+  for (std::uint64_t seed = 0; seed < 5; seed++)
+  {
+    robot_planning::RRTConnect::Params params;
+    params.seed = seed;
+    robot_planning::RRTConnect planner(space, collision, params);
+    const robot_planning::PlanResult result = planner.plan(start, goal, 1.0);
+    ASSERT_TRUE(result.success) << "seed " << seed << ": " << result.message;
+    expect_valid_path(result.path);
+    EXPECT_GT(result.edge_checks, 0u);
+  }
+}
+
+TEST_F(PlannerTest, RRTConnectRejectsInvalidEnds)
+{
+  robot_planning::RRTConnect planner(space, collision, robot_planning::RRTConnect::Params());
+  JointVector inside_wall = goal;
+  inside_wall[0] = 0.0;
+  ASSERT_FALSE(collision.is_valid(inside_wall));
+  const robot_planning::PlanResult result = planner.plan(start, inside_wall, 1.0);
+  EXPECT_FALSE(result.success);
+  EXPECT_EQ(result.message, "Goal state is in collision or out of bounds.");
+}
+
+TEST_F(PlannerTest, SimplifierShortensAndKeepsPathValid)
+{
+  robot_planning::RRTConnect planner(space, collision, robot_planning::RRTConnect::Params());
+  const robot_planning::PlanResult result = planner.plan(start, goal, 1.0);
+  ASSERT_TRUE(result.success) << result.message;
+
+  robot_planning::PathSimplifier::Params params;
+  params.num_threads = 2;
+  robot_planning::PathSimplifier simplifier(space, collision, params);
+  const Path simplified = simplifier.simplify(result.path, 0.5);
+  expect_valid_path(simplified);
+  EXPECT_LT(robot_planning::path_length(space, simplified), robot_planning::path_length(space, result.path));
+}
+
+// built for the free workspace, the wall is added afterwards and only invalidates
+// the part of the roadmap it touches
+TEST_F(PlannerTest, RoadmapAnswersAfterObstaclesChange)
+{
+  const std::vector<Box> wall = collision.obstacles();
+  CollisionModel free_space(collision.params());
+  robot_planning::RoadmapBuildParams params;
+  params.num_nodes = 200;
+  params.k_neighbors = 5;
+  params.num_threads = 2;
+  const robot_planning::RoadmapData data = robot_planning::build_roadmap(space, free_space, params);
+  ASSERT_EQ(data.nodes.size(), params.num_nodes);
+
+  const std::string file = ::testing::TempDir() + "test_planners_roadmap.bin";
+  std::string error;
+  ASSERT_TRUE(robot_planning::save_roadmap(file, data, free_space.params(), error)) << error;
+  std::unique_ptr<robot_planning::Roadmap> roadmap =
+      robot_planning::Roadmap::open(file, space, free_space.params(), error);
+  ASSERT_TRUE(roadmap) << error;
+  EXPECT_EQ(roadmap->num_nodes(), params.num_nodes);
+
+  const std::size_t affected = roadmap->update_obstacles(wall);
+  EXPECT_GT(affected, 0u);
+  EXPECT_LT(affected, roadmap->num_edges());
+  const robot_planning::PlanResult result = roadmap->query(collision, start, goal, {});
+  ASSERT_TRUE(result.success) << result.message;
+  expect_valid_path(result.path);
+
+  // a roadmap is only valid for the robot it was checked with
+  CollisionModel::Params thicker = collision.params();
+  thicker.safety_margin += 5.0;
+  EXPECT_FALSE(robot_planning::Roadmap::open(file, space, thicker, error));
+  roadmap.reset();
+  std::remove(file.c_str());
+}
+
+// the straight line runs through the wall; the optimiser bends it out and times
+// the result within the joint speed limit
+TEST_F(PlannerTest, OptimizerPullsStraightLineOutOfCollision)
+{
+  robot_planning::TrajectoryOptimizer optimizer(space, collision, robot_planning::TrajectoryOptimizer::Params());
+  const std::size_t waypoints = optimizer.params().num_waypoints;
+  Path seed;
+  for (std::size_t k = 0; k <= waypoints + 1; k++)
+  {
+    seed.push_back(space.interpolate(start, goal, static_cast<double>(k) / (waypoints + 1)));
+  }
+  Path warm;
+  EXPECT_FALSE(optimizer.warm_start(start, goal, warm));
+
+  const robot_planning::PlanResult result = optimizer.optimize(seed, 5.0);
+  ASSERT_TRUE(result.success) << result.message;
+  expect_valid_path(result.path);
+  ASSERT_EQ(result.time_from_start.size(), result.path.size());
+  EXPECT_DOUBLE_EQ(result.time_from_start.front(), 0.0);
+  for (std::size_t i = 1; i < result.path.size(); i++)
+  {
+    const double dt = result.time_from_start[i] - result.time_from_start[i - 1];
+    ASSERT_GT(dt, 0.0);
+    EXPECT_LE(space.max_joint_distance(result.path[i - 1], result.path[i]) / dt,
+              optimizer.params().max_velocity + 1e-9)
+        << "segment " << i;
+  }
+
+  // the solution seeds the next plan of the same task
+  ASSERT_TRUE(optimizer.warm_start(start, goal, warm));
+  ASSERT_EQ(warm.size(), result.path.size());
+  EXPECT_EQ(warm.front(), start);
+  EXPECT_EQ(warm.back(), goal);
+}
@@ -1 +1 @@
-from .robot import Robot
+from .robot import Robot, MotionError, MotionHandle, Program
@@ -1,65 +1,382 @@
 # robot_sdk/robot_sdk/robot.py
 
+import asyncio
+import threading
+import time
+from concurrent.futures import Future
+
 import numpy as np
 import rclpy
 from scipy.spatial.transform import Rotation as R
+from rclpy.action import ActionClient
+from rclpy.executors import SingleThreadedExecutor
 from rclpy.node import Node
 from geometry_msgs.msg import PoseStamped
-from sensor_msgs.msg import JointState
+from std_srvs.srv import Trigger
 from robot_motion_interfaces.srv import GetCartesianSpacePose, GetJointSpacePose
+from robot_motion_interfaces.msg import ProgramStep
+from robot_motion_interfaces.action import GuardedMove, MoveJoint, MoveCartesian, ExecuteProgram
+
+try:
+    from robot_motion.state_shm import StateReader
+except ImportError:
+    StateReader = None  # robot_motion not installed on this host, services only
+
+# Queries return concurrent.futures.Future objects and moves a MotionHandle, both
+# completed from the background executor thread. Block with future.result() or
+# handle.wait(), or await them in an asyncio program (asyncio.wrap_future(future)).
+
+class MotionError(Exception):
+    pass
+
+
+def chain(future, fn):
+    # Future resolving to fn(future.result()), exceptions are passed on
+    result = Future()
+
+    def done(f):
+        try:
+            result.set_result(fn(f.result()))
+        except Exception as e:
+            result.set_exception(e)
+
+    future.add_done_callback(done)
+    return result
+
+
+def from_rclpy(rclpy_future):
+    future = Future()
+
+    def done(f):
+        try:
+            future.set_result(f.result())
+        except Exception as e:
+            future.set_exception(e)
+
+    rclpy_future.add_done_callback(done)
+    return future
+
+
+class MotionQueue:
+    # Moves are sent one after the other, each once the previous one finished, so a
+    # script can queue many moves without waiting. If a move fails the moves queued
+    # behind it are skipped.
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.tail = None  # future of the last queued move
+
+    def submit(self, send):
+        future = Future()
+        with self.lock:
+            previous, self.tail = self.tail, future
+
+        def start(previous=None):
+            if not future.set_running_or_notify_cancel():
+                return  # canceled while queued
+            if previous is not None and (previous.cancelled() or previous.exception() is not None):
+                reason = "canceled" if previous.cancelled() else previous.exception()
+                future.set_exception(MotionError(f"Skipped, previous motion failed: {reason}"))
+                return
+            send().add_done_callback(lambda f: copy_result(f, future))
+
+        if previous is None:
+            start()
+        elif previous.done():
+            start(previous)  # still skipped if it failed or was canceled
+        else:
+            previous.add_done_callback(start)
+        return future
+
+
+class MotionHandle:
+    # Returned by move(). The motion node reports completion once the robot settled
+    # within tolerance at the target, wait() blocks on that event instead of polling.
+    # Also awaitable from asyncio.
 
-class Robot:
     def __init__(self):
+        self.future = None
+        self.goal_handle = None  # set once the goal was accepted
+
+    def accepted(self, goal_handle):
+        self.goal_handle = goal_handle
+
+    def wait(self, timeout=None):
+        # Action result of the motion, raises MotionError if it failed and
+        # concurrent.futures.TimeoutError after `timeout` seconds.
+        return self.future.result(timeout=timeout)
+
+    def done(self):
+        return self.future.done()
+
+    def succeeded(self):
+        return self.future.done() and not self.future.cancelled() and self.future.exception() is None
+
+    def cancel(self):
+        # Drops a queued move, or stops the robot if the move is running.
+        if not self.future.cancel() and self.goal_handle is not None:
+            self.goal_handle.cancel_goal_async()
+
+    def add_done_callback(self, fn):
+        self.future.add_done_callback(lambda f: fn(self))
+
+    def __await__(self):
+        return asyncio.wrap_future(self.future).__await__()
+
+
+def copy_result(source, target):
+    if source.exception() is not None:
+        target.set_exception(source.exception())
+    else:
+        target.set_result(source.result())
+
+
+def contact_history(event):
+    # Pre-trigger history of a ContactEvent (GuardedMove result.contact_event) as
+    # numpy arrays, oldest sample first, the last one is the contact.
+    n = len(event.history_time)
+    return {
+        "time": np.array(event.history_time),
+        "joint_positions": np.array(event.history_joint_positions).reshape(n, -1),
+        "wrench": np.array(event.history_wrench).reshape(n, 6),
+        "tracking_error": np.array(event.history_tracking_error),
+    }
+
+
+class Program:
+    # Motion program uploaded in one goal and executed by the motion node as a
+    # single trajectory. Built with chained calls:
+    #   robot.program().move_joint(q1, blend=True).move_cartesian(p2).set_output("gripper", True).wait(0.5).run()
+
+    def __init__(self, robot):
+        self.robot = robot
+        self.steps = []
+
+    def move_joint(self, joint_positions, blend=False):
+        step = ProgramStep(type=ProgramStep.MOVE_JOINT, blend=blend)
+        step.joint_positions = [float(q) for q in joint_positions]
+        self.steps.append(step)
+        return self
+
+    def move_cartesian(self, position, orientation=None, blend=False):
+        step = ProgramStep(type=ProgramStep.MOVE_CARTESIAN, blend=blend)
+        step.pose = self.robot.cartesian_space.goal_pose(position, orientation)
+        self.steps.append(step)
+        return self
+
+    def wait(self, duration):
+        self.steps.append(ProgramStep(type=ProgramStep.WAIT, duration=float(duration)))
+        return self
+
+    def set_output(self, name, value):
+        self.steps.append(ProgramStep(type=ProgramStep.SET_OUTPUT, output=name, value=bool(value)))
+        return self
+
+    def run(self, feedback_callback=None):
+        # Queued like a move, returns a MotionHandle whose wait() gives the ExecuteProgram result.
+        goal = ExecuteProgram.Goal()
+        goal.steps = list(self.steps)
+        self.robot.node.get_logger().info(f"Queued program with {len(goal.steps)} steps")
+        return self.robot.move(self.robot.program_client, goal, feedback_callback)
+
+
+class Robot:
+    def __init__(self, state_shm_name="robot_motion_state", max_state_age=0.5):
         rclpy.init()
         self.node = Node("robot_sdk_client")
         self.tcp_orientation = [np.pi, 0.0, 0.0]
 
+        # Pose queries read the motion node's shared memory state when it runs on this
+        # host and fall back to the services otherwise.
+        self.state_shm_name = state_shm_name if StateReader is not None else ""
+        self.max_state_age = max_state_age
+        self.state_reader = None
+        self.state_reader_lock = threading.Lock()
+        self.state_reader_retry = 0.0
+
+        # ROS callbacks run on a background thread, so requests can be issued from
+        # any thread and many of them can be in flight at once.
+        self.executor = SingleThreadedExecutor()
+        self.executor.add_node(self.node)
+        self.spin_thread = threading.Thread(target=self.executor.spin, daemon=True)
+        self.spin_thread.start()
+
+        self.motion_queue = MotionQueue()
         self.cartesian_space = self.CartesianSpace(self)
         self.joint_space = self.JointSpace(self)
-        
+
+        self.program_client = ActionClient(self.node, ExecuteProgram, '/robot_motion/program/execute')
+        if not self.program_client.wait_for_server(timeout_sec=5.0):
+            self.node.get_logger().error("Action '/robot_motion/program/execute' not available.")
+
+        self.guarded_move_client = ActionClient(self.node, GuardedMove, '/robot_motion/guarded_move')
+        if not self.guarded_move_client.wait_for_server(timeout_sec=5.0):
+            self.node.get_logger().error("Action '/robot_motion/guarded_move' not available.")
+        self.reset_collision_client = self.node.create_client(Trigger, '/robot_motion/reset_collision')
+
     def shutdown(self):
+        if self.state_reader is not None:
+            self.state_reader.close()
+        self.executor.shutdown()
+        self.spin_thread.join()
         self.node.destroy_node()
         rclpy.shutdown()
 
+    def program(self):
+        return Program(self)
+
+    def guarded_move(self, goal, force=0.0, torque=0.0, tracking_error=0.0, feedback_callback=None):
+        # Thresholds on the tared FTS force (N), torque (Nm) and the joint tracking
+        # error (rad), 0 disables one. wait() gives the GuardedMove result once the
+        # robot stopped at the contact (result.contact_event) and raises MotionError
+        # if it reached the target without one.
+        goal.force_threshold = float(force)
+        goal.torque_threshold = float(torque)
+        goal.tracking_error_threshold = float(tracking_error)
+        return self.move(self.guarded_move_client, goal, feedback_callback)
+
+    def reset_collision(self, timeout=5.0):
+        # After a collision moves fail with MotionError until this is called. True once
+        # the motion node accepted the reset, moves resume after its stop_time.
+        try:
+            response = from_rclpy(self.reset_collision_client.call_async(Trigger.Request())).result(timeout=timeout)
+        except Exception as e:
+            self.node.get_logger().error(f"Failed to call service reset_collision: {e}")
+            return False
+        if not response.success:
+            self.node.get_logger().error(f"Collision reset failed: {response.message}")
+        return response.success
+
+    def read_state(self):
+        # Latest state from shared memory, None if it is not available or stale
+        with self.state_reader_lock:
+            if self.state_reader is None:
+                now = time.monotonic()
+                if not self.state_shm_name or now < self.state_reader_retry:
+                    return None
+                self.state_reader_retry = now + 1.0
+                try:
+                    self.state_reader = StateReader(self.state_shm_name)
+                except (FileNotFoundError, ValueError):
+                    return None
+
+            state = self.state_reader.read()
+            if state is None or time.time() - state.write_time > self.max_state_age:
+                # motion node stopped or restarted with a new segment, reattach later
+                self.state_reader.close()
+                self.state_reader = None
+                return None
+            return state
+
+    def move(self, client, goal, feedback_callback=None):
+        handle = MotionHandle()
+        handle.future = self.motion_queue.submit(
+            lambda: self.send_goal(client, goal, feedback_callback, handle.accepted))
+        return handle
+
+    def send_goal(self, client, goal, feedback_callback=None, accepted_callback=None):
+        # Future resolving to the action result once the motion finished, or to a
+        # MotionError if the goal was rejected, aborted or canceled.
+        future = Future()
+
+        def result_response(f):
+            try:
+                result = f.result().result
+            except Exception as e:
+                future.set_exception(e)
+                return
+            if result.success:
+                future.set_result(result)
+            else:
+                future.set_exception(MotionError(result.message))
+
+        def goal_response(f):
+            try:
+                goal_handle = f.result()
+            except Exception as e:
+                future.set_exception(e)
+                return
+            if goal_handle is None or not goal_handle.accepted:
+                future.set_exception(MotionError("Goal rejected."))
+                return
+            if accepted_callback is not None:
+                accepted_callback(goal_handle)
+            goal_handle.get_result_async().add_done_callback(result_response)
+
+        client.send_goal_async(goal, feedback_callback=feedback_callback).add_done_callback(goal_response)
+        return future
+
     class JointSpace:
         def __init__(self, robot_instance):
             self.robot = robot_instance
 
-            self.pose_setter_publisher = self.robot.node.create_publisher(JointState, '/robot_motion/joint_space/set_goal_pose', 10)
+            self.move_client = ActionClient(self.robot.node, MoveJoint, '/robot_motion/joint_space/move')
             self.pose_getter_client = self.robot.node.create_client(GetJointSpacePose, '/robot_motion/joint_space/get_pose')
+            if not self.move_client.wait_for_server(timeout_sec=5.0):
+                self.robot.node.get_logger().error("Action '/robot_motion/joint_space/move' not available.")
             if not self.pose_getter_client.wait_for_service(timeout_sec=5.0):
                 self.robot.node.get_logger().error("Service '/robot_motion/joint_space/get_pose' not available.")
-                
-        def move(self, joint_positions):
-            msg = JointState()
-            msg.header.stamp = self.robot.node.get_clock().now().to_msg()
-            msg.name = [f"joint_{i+1}" for i in range(len(joint_positions))]
-            msg.position = joint_positions
-            self.pose_setter_publisher.publish(msg)
-            self.robot.node.get_logger().info(f"Published joint_goal with positions: {joint_positions}")
-
-        def get_pose(self):
-            request = GetJointSpacePose.Request()
-            future = self.pose_getter_client.call_async(request)
-            rclpy.spin_until_future_complete(self.robot.node, future)
-            response = future.result()
-            if response is not None:
-                return dict(zip(response.joint_names, response.joint_positions))
-            else:
-                self.robot.node.get_logger().error("Failed to call service get_joint_configuration")
+
+        def move(self, joint_positions, feedback_callback=None):
+            # Queued behind earlier moves, returns a MotionHandle whose wait() gives the MoveJoint result.
+            goal = MoveJoint.Goal()
+            goal.joint_names = [f"joint_{i+1}" for i in range(len(joint_positions))]
+            goal.joint_positions = [float(q) for q in joint_positions]
+            self.robot.node.get_logger().info(f"Queued joint goal with positions: {joint_positions}")
+            return self.robot.move(self.move_client, goal, feedback_callback)
+
+        def guarded_move(self, joint_positions, force=0.0, torque=0.0, tracking_error=0.0, feedback_callback=None):
+            # Moves towards joint_positions until contact, see Robot.guarded_move.
+            goal = GuardedMove.Goal()
+            goal.joint_positions = [float(q) for q in joint_positions]
+            self.robot.node.get_logger().info(f"Queued guarded joint goal with positions: {joint_positions}")
+            return self.robot.guarded_move(goal, force, torque, tracking_error, feedback_callback)
+
+        def get_pose_async(self):
+            state = self.robot.read_state()
+            if state is not None:
+                future = Future()
+                future.set_result({f"joint_{i+1}": q for i, q in enumerate(state.joint_positions)})
+                return future
+
+            future = from_rclpy(self.pose_getter_client.call_async(GetJointSpacePose.Request()))
+            return chain(future, lambda response: dict(zip(response.joint_names, response.joint_positions)))
+
+        def get_pose(self, timeout=5.0):
+            try:
+                return self.get_pose_async().result(timeout=timeout)
+            except Exception as e:
+                self.robot.node.get_logger().error(f"Failed to call service get_joint_configuration: {e}")
                 return {}
-            
+
     class CartesianSpace:
 
         def __init__(self, robot_instance):
             self.robot = robot_instance
 
-            self.pose_setter_publisher = self.robot.node.create_publisher(PoseStamped, "/robot_motion/cartesian_space/set_goal_pose", 10)
+            self.move_client = ActionClient(self.robot.node, MoveCartesian, '/robot_motion/cartesian_space/move')
             self.pose_getter_client = self.robot.node.create_client(GetCartesianSpacePose, '/robot_motion/cartesian_space/get_pose')
+            if not self.move_client.wait_for_server(timeout_sec=5.0):
+                self.robot.node.get_logger().error("Action '/robot_motion/cartesian_space/move' not available.")
             if not self.pose_getter_client.wait_for_service(timeout_sec=5.0):
                 self.robot.node.get_logger().error("Service '/robot_motion/cartesian_space/get_pose' not available.")
 
-        def move(self, position, orientation=None):
+        def move(self, position, orientation=None, feedback_callback=None):
+            # Queued behind earlier moves, returns a MotionHandle whose wait() gives the MoveCartesian result.
+            goal = MoveCartesian.Goal()
+            goal.pose = self.goal_pose(position, orientation)
+            self.robot.node.get_logger().info("Queued desired pose")
+            return self.robot.move(self.move_client, goal, feedback_callback)
+
+        def guarded_move(self, position, orientation=None, force=0.0, torque=0.0, tracking_error=0.0,
+                         feedback_callback=None):
+            # Moves towards the pose until contact, see Robot.guarded_move.
+            goal = GuardedMove.Goal()
+            goal.pose = self.goal_pose(position, orientation)
+            self.robot.node.get_logger().info("Queued guarded desired pose")
+            return self.robot.guarded_move(goal, force, torque, tracking_error, feedback_callback)
+
+        def goal_pose(self, position, orientation=None):
             tcp_rot = R.from_euler('xyz', self.robot.tcp_orientation)
 
             if orientation is None:
@@ -73,42 +390,48 @@ class Robot:
             pose_msg = PoseStamped()
             pose_msg.header.stamp = self.robot.node.get_clock().now().to_msg()
             pose_msg.header.frame_id = "base_link"
-            pose_msg.pose.position.x = position[0]
-            pose_msg.pose.position.y = position[1]
-            pose_msg.pose.position.z = position[2]
+            pose_msg.pose.position.x = float(position[0])
+            pose_msg.pose.position.y = float(position[1])
+            pose_msg.pose.position.z = float(position[2])
             pose_msg.pose.orientation.x = quat[0]
             pose_msg.pose.orientation.y = quat[1]
             pose_msg.pose.orientation.z = quat[2]
             pose_msg.pose.orientation.w = quat[3]
+            return pose_msg
 
-            self.pose_setter_publisher.publish(pose_msg)
-            self.robot.node.get_logger().info("Sent desired pose")
-
-        def get_pose(self):
-            request = GetCartesianSpacePose.Request()
-            future = self.pose_getter_client.call_async(request)
-
-            rclpy.spin_until_future_complete(self.robot.node, future)
-            response = future.result()
-            if response is not None:
-                # response should have a 'pose' attribute of type PoseStamped
-                pos = response.pose.pose.position
-                position = [pos.x, pos.y, pos.z]
-
-                quat = [
-                    response.pose.pose.orientation.x,
-                    response.pose.pose.orientation.y,
-                    response.pose.pose.orientation.z,
-                    response.pose.pose.orientation.w,
-                ]
-
-                rot = R.from_quat(quat)
-                tcp_rot = R.from_euler('xyz', self.robot.tcp_orientation)
-                tcp_rot_inv = tcp_rot.inv()
-                adjusted_rot = rot * tcp_rot_inv
-                euler_angles = adjusted_rot.as_euler('xyz')
-
-                return position, euler_angles
-            else:
-                self.robot.node.get_logger().error("Failed to call service get_current_pose")
+        def pose_from_msg(self, pose: PoseStamped):
+            pos = pose.pose.position
+            quat = [
+                pose.pose.orientation.x,
+                pose.pose.orientation.y,
+                pose.pose.orientation.z,
+                pose.pose.orientation.w,
+            ]
+            return self.tcp_pose(pos.x, pos.y, pos.z, quat)
+
+        def tcp_pose(self, x, y, z, quat):
+            position = [x, y, z]
+            rot = R.from_quat(quat)
+            tcp_rot = R.from_euler('xyz', self.robot.tcp_orientation)
+            tcp_rot_inv = tcp_rot.inv()
+            adjusted_rot = rot * tcp_rot_inv
+            euler_angles = adjusted_rot.as_euler('xyz')
+
+            return position, euler_angles
+
+        def get_pose_async(self):
+            state = self.robot.read_state()
+            if state is not None:
+                future = Future()
+                future.set_result(self.tcp_pose(*state.tcp_position, state.tcp_quaternion))
+                return future
+
+            future = from_rclpy(self.pose_getter_client.call_async(GetCartesianSpacePose.Request()))
+            return chain(future, lambda response: self.pose_from_msg(response.pose))
+
+        def get_pose(self, timeout=5.0):
+            try:
+                return self.get_pose_async().result(timeout=timeout)
+            except Exception as e:
+                self.robot.node.get_logger().error(f"Failed to call service get_current_pose: {e}")
                 return None, None